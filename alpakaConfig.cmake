@@ -95,6 +95,16 @@ OPTION(ALPAKA_ACC_GPU_CUDA_ENABLE "Enable the CUDA GPU accelerator" ON)
 SET(ALPAKA_DEBUG "0" CACHE STRING "Debug level")
 SET_PROPERTY(CACHE ALPAKA_DEBUG PROPERTY STRINGS "0;1;2")
 
+# Non-temporal stores for CPU memory copies and sets: AUTO uses them above the last level cache size.
+SET(ALPAKA_MEM_CPU_STREAMING_STORES "AUTO" CACHE STRING "Non-temporal stores for CPU memory copies and sets")
+SET_PROPERTY(CACHE ALPAKA_MEM_CPU_STREAMING_STORES PROPERTY STRINGS "AUTO;ON;OFF")
+
+# Records kernel launches, memory copies and sets of CPU streams for export as Chrome trace.
+OPTION(ALPAKA_PROFILING_ENABLE "Enable the kernel and memory task profiler of the CPU backends" OFF)
+
+# Collects queue depth and wait time statistics of the asynchronous CPU streams.
+OPTION(ALPAKA_STREAM_STATS_ENABLE "Enable the statistics of the asynchronous CPU streams" OFF)
+
 #-------------------------------------------------------------------------------
 # Find Boost.
 #-------------------------------------------------------------------------------
@@ -349,6 +359,20 @@ ENDIF()
 
 LIST(APPEND _ALPAKA_COMPILE_DEFINITIONS_PUBLIC "ALPAKA_DEBUG=${ALPAKA_DEBUG}")
 
+IF(ALPAKA_MEM_CPU_STREAMING_STORES STREQUAL "ON")
+    LIST(APPEND _ALPAKA_COMPILE_DEFINITIONS_PUBLIC "ALPAKA_MEM_CPU_STREAMING_STORES_FORCE_ON")
+ELSEIF(ALPAKA_MEM_CPU_STREAMING_STORES STREQUAL "OFF")
+    LIST(APPEND _ALPAKA_COMPILE_DEFINITIONS_PUBLIC "ALPAKA_MEM_CPU_STREAMING_STORES_FORCE_OFF")
+ENDIF()
+
+IF(ALPAKA_PROFILING_ENABLE)
+    LIST(APPEND _ALPAKA_COMPILE_DEFINITIONS_PUBLIC "ALPAKA_PROFILING_ENABLED")
+ENDIF()
+
+IF(ALPAKA_STREAM_STATS_ENABLE)
+    LIST(APPEND _ALPAKA_COMPILE_DEFINITIONS_PUBLIC "ALPAKA_STREAM_STATS_ENABLED")
+ENDIF()
+
 IF(ALPAKA_INTEGRATION_TEST)
     LIST(APPEND _ALPAKA_COMPILE_DEFINITIONS_PUBLIC "ALPAKA_INTEGRATION_TEST")
 ENDIF()
@@ -0,0 +1,152 @@
+/**
+ * \file
+ * Copyright 2014-2015 Benjamin Worpitz
+ *
+ * This file is part of alpaka.
+ *
+ * alpaka is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * alpaka is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with alpaka.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <alpaka/alpaka.hpp>                        // alpaka::mem::view::copy
+
+#include <algorithm>                                // std::max
+#include <chrono>                                   // std::chrono::high_resolution_clock
+#include <iostream>                                 // std::cout
+#include <iomanip>                                  // std::setw
+#include <cstdint>                                  // std::uint8_t
+
+//-----------------------------------------------------------------------------
+//! \return The bandwidth in GB/s of the given memory operation, counting the bytes read and written.
+//-----------------------------------------------------------------------------
+template<
+    typename TStream,
+    typename TFnObj>
+auto measureBandwidthGBs(
+    TStream & stream,
+    std::size_t const & bytesTransferred,
+    std::size_t const & repetitions,
+    TFnObj const & fnObj)
+-> double
+{
+    // Warm up (page faults, caches).
+    fnObj();
+    alpaka::wait::wait(stream);
+
+    auto const tpStart(std::chrono::high_resolution_clock::now());
+    for(std::size_t i(0u); i < repetitions; ++i)
+    {
+        fnObj();
+    }
+    alpaka::wait::wait(stream);
+    auto const tpEnd(std::chrono::high_resolution_clock::now());
+
+    auto const durElapsedS(std::chrono::duration<double>(tpEnd - tpStart).count());
+    return static_cast<double>(bytesTransferred * repetitions) / durElapsedS / 1e9;
+}
+
+//-----------------------------------------------------------------------------
+//! Program entry point.
+//-----------------------------------------------------------------------------
+auto main()
+-> int
+{
+    try
+    {
+        std::cout << std::endl;
+        std::cout << "################################################################################" << std::endl;
+        std::cout << "                         alpaka CPU memory bandwidth test                       " << std::endl;
+        std::cout << "################################################################################" << std::endl;
+        std::cout << std::endl;
+
+        using Size = std::size_t;
+        using Dim = alpaka::dim::DimInt<1u>;
+
+        auto devHost(alpaka::dev::cpu::getDev());
+        alpaka::stream::StreamCpuSync stream(devHost);
+
+        std::cout
+            << "Last level cache threshold: "
+            << alpaka::mem::view::cpu::getStreamingStoresThresholdBytes()
+            << " B" << std::endl << std::endl;
+
+        std::cout
+            << std::setw(12) << "size [B]"
+            << std::setw(16) << "copy [GB/s]"
+            << std::setw(16) << "copy nt [GB/s]"
+            << std::setw(16) << "set [GB/s]"
+            << std::setw(16) << "set nt [GB/s]"
+            << std::endl;
+
+#if ALPAKA_INTEGRATION_TEST
+        Size const sizeBytesMax(1u<<22u);
+#else
+        Size const sizeBytesMax(1u<<28u);
+#endif
+        for(Size sizeBytes(1u<<16u); sizeBytes <= sizeBytesMax; sizeBytes *= 4u)
+        {
+            alpaka::Vec<Dim, Size> const extent(sizeBytes);
+
+            auto memBufSrc(alpaka::mem::buf::alloc<std::uint8_t, Size>(devHost, extent));
+            auto memBufDst(alpaka::mem::buf::alloc<std::uint8_t, Size>(devHost, extent));
+            alpaka::mem::view::set(stream, memBufSrc, 1u, extent);
+
+            // Transfer about 4 GB per measurement but at least once.
+            Size const repetitions(std::max(static_cast<Size>(1u), (static_cast<Size>(1u)<<32u) / sizeBytes));
+
+            double bandwidthsGBs[4];
+            for(std::size_t streaming(0u); streaming < 2u; ++streaming)
+            {
+                alpaka::mem::view::cpu::setStreamingStores(
+                    streaming
+                    ? alpaka::mem::view::cpu::StreamingStores::Enabled
+                    : alpaka::mem::view::cpu::StreamingStores::Disabled);
+
+                // A copy reads and writes each byte.
+                bandwidthsGBs[streaming] = measureBandwidthGBs(
+                    stream,
+                    2u * sizeBytes,
+                    repetitions,
+                    [&](){alpaka::mem::view::copy(stream, memBufDst, memBufSrc, extent);});
+                bandwidthsGBs[2u + streaming] = measureBandwidthGBs(
+                    stream,
+                    sizeBytes,
+                    repetitions,
+                    [&](){alpaka::mem::view::set(stream, memBufDst, 0u, extent);});
+            }
+
+            std::cout
+                << std::setw(12) << sizeBytes
+                << std::setw(16) << bandwidthsGBs[0]
+                << std::setw(16) << bandwidthsGBs[1]
+                << std::setw(16) << bandwidthsGBs[2]
+                << std::setw(16) << bandwidthsGBs[3]
+                << std::endl;
+        }
+
+        alpaka::mem::view::cpu::setStreamingStores(alpaka::mem::view::cpu::StreamingStores::Auto);
+
+        return EXIT_SUCCESS;
+    }
+    catch(std::exception const & e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch(...)
+    {
+        std::cerr << "Unknown Exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,282 @@
+/**
+ * \file
+ * Copyright 2014-2015 Benjamin Worpitz
+ *
+ * This file is part of alpaka.
+ *
+ * alpaka is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * alpaka is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with alpaka.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <alpaka/alpaka.hpp>                        // alpaka::exec::create
+
+#include <algorithm>                                // std::max, std::min
+#include <chrono>                                   // std::chrono::high_resolution_clock
+#include <cstdint>                                  // std::uint64_t
+#include <functional>                               // std::hash
+#include <iostream>                                 // std::cout
+#include <iomanip>                                  // std::setw
+#include <limits>                                   // std::numeric_limits
+#include <map>                                      // std::map
+#include <thread>                                   // std::this_thread
+#include <typeinfo>                                 // typeid
+
+//#############################################################################
+//! A kernel computing the Mandelbrot iteration counts of one image row per thread.
+//!
+//! The rows crossing the set need up to maxIterations iterations per pixel, the rows far from it only a few.
+//! Besides the work done for each row it records the thread that computed it.
+//! This only works on the CPU accelerators executing blocks in parallel.
+//#############################################################################
+class MandelbrotRowKernel
+{
+public:
+    //-----------------------------------------------------------------------------
+    //! The kernel entry point.
+    //!
+    //! \param acc The accelerator to be executed on.
+    //! \param pRowIterations The sum of the iterations of all pixels in each row.
+    //! \param pRowThreads The hash of the id of the thread that computed each row.
+    //! \param numRows The number of rows in the image.
+    //! \param numCols The number of columns in the image.
+    //! \param maxIterations The maximum number of iterations.
+    //-----------------------------------------------------------------------------
+    template<
+        typename TAcc,
+        typename TSize>
+    ALPAKA_FN_ACC_NO_CUDA auto operator()(
+        TAcc const & acc,
+        std::uint64_t * const pRowIterations,
+        std::size_t * const pRowThreads,
+        TSize const & numRows,
+        TSize const & numCols,
+        std::uint32_t const & maxIterations) const
+    -> void
+    {
+        static_assert(
+            alpaka::dim::Dim<TAcc>::value == 1,
+            "The MandelbrotRowKernel expects 1-dimensional indices!");
+
+        auto const row(alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>(acc)[0u]);
+        if(row < numRows)
+        {
+            float const ci(-1.2f + static_cast<float>(row) / static_cast<float>(numRows - 1u) * 2.4f);
+            std::uint64_t rowIterations(0u);
+            for(TSize col(0u); col < numCols; ++col)
+            {
+                float const cr(-2.0f + static_cast<float>(col) / static_cast<float>(numCols - 1u) * 3.0f);
+                float zr(0.0f);
+                float zi(0.0f);
+                std::uint32_t iterations(0u);
+                while((iterations < maxIterations) && (zr * zr + zi * zi <= 4.0f))
+                {
+                    float const zrNew(zr * zr - zi * zi + cr);
+                    zi = 2.0f * zr * zi + ci;
+                    zr = zrNew;
+                    ++iterations;
+                }
+                rowIterations += iterations;
+            }
+            pRowIterations[row] = rowIterations;
+            pRowThreads[row] = std::hash<std::thread::id>()(std::this_thread::get_id());
+        }
+    }
+};
+
+//#############################################################################
+//! Profiles the Mandelbrot row kernel with the static and the guided block schedule.
+//#############################################################################
+struct MandelbrotRowKernelTester
+{
+    template<
+        typename TAcc,
+        typename TSize>
+    auto operator()(
+        TSize const & numRows,
+        TSize const & numCols,
+        std::uint32_t const & maxIterations,
+        std::size_t const & workerCount,
+        std::size_t const & repetitions)
+    -> void
+    {
+        std::cout << std::endl;
+        std::cout << "################################################################################" << std::endl;
+
+        using Dim = alpaka::dim::DimInt<1u>;
+
+        // Create the kernel function object.
+        MandelbrotRowKernel kernel;
+
+        // Select a device to execute on.
+        alpaka::dev::Dev<TAcc> devAcc(
+            alpaka::dev::DevMan<TAcc>::getDevByIdx(0));
+
+        // Get a stream on this device.
+        alpaka::stream::StreamCpuSync stream(devAcc);
+
+        // Each block consists of a single thread computing one row.
+        // This makes the blocks as irregular as the rows.
+        alpaka::workdiv::WorkDivMembers<Dim, TSize> const workDiv(
+            numRows,
+            static_cast<TSize>(1u),
+            static_cast<TSize>(1u));
+
+        std::cout
+            << "MandelbrotRowKernelTester("
+            << " numRows:" << numRows
+            << ", numCols:" << numCols
+            << ", maxIterations:" << maxIterations
+            << ", workers:" << workerCount
+            << ", accelerator: " << alpaka::acc::getAccName<TAcc>()
+            << ", kernel: " << typeid(kernel).name()
+            << ", workDiv: " << workDiv
+            << ")" << std::endl;
+
+        // The buffers are only accessed by the CPU accelerators, so they are read directly.
+        auto bufRowIterations(
+            alpaka::mem::buf::alloc<std::uint64_t, TSize>(devAcc, numRows));
+        auto bufRowThreads(
+            alpaka::mem::buf::alloc<std::size_t, TSize>(devAcc, numRows));
+        std::uint64_t const * const pRowIterations(alpaka::mem::view::getPtrNative(bufRowIterations));
+        std::size_t const * const pRowThreads(alpaka::mem::view::getPtrNative(bufRowThreads));
+
+        auto const exec(alpaka::exec::create<TAcc>(
+            workDiv,
+            kernel,
+            alpaka::mem::view::getPtrNative(bufRowIterations),
+            alpaka::mem::view::getPtrNative(bufRowThreads),
+            numRows,
+            numCols,
+            maxIterations));
+
+        auto const blockSchedulePrev(alpaka::exec::getBlockSchedule());
+
+        std::cout
+            << std::setw(16) << "schedule"
+            << std::setw(16) << "time [ms]"
+            << std::setw(16) << "busy workers"
+            << std::setw(16) << "imbalance"
+            << std::endl;
+
+        for(auto const & schedule : {"static", "guided", "guided:4"})
+        {
+            auto blockSchedule(alpaka::exec::parseBlockSchedule(schedule));
+            blockSchedule.m_workerCount = workerCount;
+            alpaka::exec::setBlockSchedule(blockSchedule);
+
+            // The first execution is a warm up.
+            double durationMinMs(std::numeric_limits<double>::max());
+            for(std::size_t repetition(0u); repetition <= repetitions; ++repetition)
+            {
+                auto const tpStart(std::chrono::high_resolution_clock::now());
+                alpaka::stream::enqueue(stream, exec);
+                alpaka::wait::wait(stream);
+                auto const tpEnd(std::chrono::high_resolution_clock::now());
+                if(repetition > 0u)
+                {
+                    durationMinMs = std::min(durationMinMs, std::chrono::duration<double, std::milli>(tpEnd - tpStart).count());
+                }
+            }
+
+            // The load imbalance is the work of the busiest worker relative to the mean work of all workers.
+            // It does not depend on the number of CPUs the workers actually ran on.
+            std::map<std::size_t, std::uint64_t> workerIterations;
+            std::uint64_t totalIterations(0u);
+            for(TSize row(0u); row < numRows; ++row)
+            {
+                workerIterations[pRowThreads[row]] += pRowIterations[row];
+                totalIterations += pRowIterations[row];
+            }
+            std::uint64_t maxWorkerIterations(0u);
+            for(auto const & worker : workerIterations)
+            {
+                maxWorkerIterations = std::max(maxWorkerIterations, worker.second);
+            }
+            double const meanWorkerIterations(static_cast<double>(totalIterations) / static_cast<double>(workerCount));
+
+            std::cout
+                << std::setw(16) << schedule
+                << std::setw(16) << durationMinMs
+                << std::setw(16) << workerIterations.size()
+                << std::setw(16) << static_cast<double>(maxWorkerIterations) / meanWorkerIterations
+                << std::endl;
+        }
+
+        alpaka::exec::setBlockSchedule(blockSchedulePrev);
+
+        std::cout << "################################################################################" << std::endl;
+    }
+};
+
+//-----------------------------------------------------------------------------
+//! Program entry point.
+//-----------------------------------------------------------------------------
+auto main()
+-> int
+{
+    try
+    {
+        std::cout << std::endl;
+        std::cout << "################################################################################" << std::endl;
+        std::cout << "                     alpaka block scheduling mandelbrot test                    " << std::endl;
+        std::cout << "################################################################################" << std::endl;
+        std::cout << std::endl;
+
+        using Size = std::size_t;
+
+#if ALPAKA_INTEGRATION_TEST
+        Size const imageSize(1u<<7u);
+        std::size_t const repetitions(1u);
+#else
+        Size const imageSize(1u<<11u);
+        std::size_t const repetitions(5u);
+#endif
+        // At least four workers are used to show the imbalance even on machines with less CPUs.
+        std::size_t const workerCount(std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), static_cast<std::size_t>(4u)));
+
+        MandelbrotRowKernelTester mandelbrotRowTester;
+
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_THREADS_ENABLED
+        mandelbrotRowTester.template operator()<alpaka::acc::AccCpuThreads<alpaka::dim::DimInt<1u>, Size>>(
+            imageSize,
+            imageSize,
+            300u,
+            workerCount,
+            repetitions);
+#endif
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_FIBERS_ENABLED
+        mandelbrotRowTester.template operator()<alpaka::acc::AccCpuFibers<alpaka::dim::DimInt<1u>, Size>>(
+            imageSize,
+            imageSize,
+            300u,
+            workerCount,
+            repetitions);
+#endif
+#if !defined(ALPAKA_ACC_CPU_B_SEQ_T_THREADS_ENABLED) && !defined(ALPAKA_ACC_CPU_B_SEQ_T_FIBERS_ENABLED)
+        std::cout << "The block scheduling test requires the CPU threads or fibers accelerator!" << std::endl;
+#endif
+        return EXIT_SUCCESS;
+    }
+    catch(std::exception const & e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch(...)
+    {
+        std::cerr << "Unknown Exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -23,7 +23,11 @@
 
 #include <alpaka/alpaka.hpp>
 
-#include <type_traits>      // std::decay
+#include <chrono>           // std::chrono::seconds
+#include <cstdlib>          // std::getenv
+#include <cstring>          // std::strcmp
+#include <iostream>         // std::cout
+#include <string>           // std::string
 #include <utility>          // std::forward
 
 namespace alpaka
@@ -31,42 +35,57 @@ namespace alpaka
     namespace examples
     {
         //-----------------------------------------------------------------------------
-        //! \return The run time of the given kernel.
+        //! The environment variable selecting the output format of measureKernelRunTime: text (default), json or csv.
+        //-----------------------------------------------------------------------------
+        static constexpr char const * benchmarkFormatEnvVar = "ALPAKA_EXAMPLES_BENCHMARK_FORMAT";
+
+        //-----------------------------------------------------------------------------
+        //! Benchmarks the given kernel with one warm up run and up to ten measured runs within two seconds and prints the result.
+        //!
+        //! \param bytes The number of bytes read and written by the kernel. Zero if unknown.
+        //! \param flops The number of floating point operations of the kernel. Zero if unknown.
+        //! \return The run times of the given kernel and their statistics.
         //-----------------------------------------------------------------------------
         template<
             typename TStream,
             typename TExec>
-        auto measureKernelRunTimeMs(
+        auto measureKernelRunTime(
+            std::string const & name,
             TStream & stream,
-            TExec && exec)
-        -> std::chrono::milliseconds::rep
+            TExec && exec,
+            double const & bytes = 0.0,
+            double const & flops = 0.0)
+        -> alpaka::profiler::BenchmarkResult
         {
-#if ALPAKA_DEBUG >= ALPAKA_DEBUG_MINIMAL
-            std::cout
-                << "measureKernelRunTime("
-                << " exec: " << typeid(typename std::decay<TExec>::type).name()
-                << " stream: " << typeid(TStream).name()
-                << ")" << std::endl;
-#endif
-            // Wait for the stream to finish all tasks enqueued prior to the kernel.
-            alpaka::wait::wait(stream);
-
-            // Take the time prior to the execution.
-            auto const tpStart(std::chrono::high_resolution_clock::now());
-
-            // Execute the kernel functor.
-            alpaka::stream::enqueue(stream, std::forward<TExec>(exec));
-
-            // Wait for the stream to finish the kernel execution to measure its run time.
-            alpaka::wait::wait(stream);
-
-            // Take the time after the execution.
-            auto const tpEnd(std::chrono::high_resolution_clock::now());
+            auto const result(
+                alpaka::profiler::benchmark(
+                    stream,
+                    std::forward<TExec>(exec),
+                    alpaka::profiler::BenchmarkConfig(
+                        name,
+                        1u,
+                        10u,
+                        std::chrono::seconds(2),
+                        bytes,
+                        flops)));
 
-            auto const durElapsed(tpEnd - tpStart);
+            auto const * const format(std::getenv(benchmarkFormatEnvVar));
+            if(format && (std::strcmp(format, "json") == 0))
+            {
+                alpaka::profiler::writeJson(std::cout, result);
+                std::cout << std::endl;
+            }
+            else if(format && (std::strcmp(format, "csv") == 0))
+            {
+                alpaka::profiler::writeCsvHeader(std::cout);
+                alpaka::profiler::writeCsv(std::cout, result);
+            }
+            else
+            {
+                std::cout << result << std::endl;
+            }
 
-            // Return the duration.
-            return std::chrono::duration_cast<std::chrono::milliseconds>(durElapsed).count();
+            return result;
         }
     }
 }
@@ -20,7 +20,7 @@
  */
 
 #include <alpaka/alpaka.hpp>                        // alpaka::exec::create
-#include <alpaka/examples/MeasureKernelRunTime.hpp> // measureKernelRunTimeMs
+#include <alpaka/examples/MeasureKernelRunTime.hpp> // measureKernelRunTime
 #include <alpaka/examples/accs/EnabledAccs.hpp>     // EnabledAccs
 
 #include <chrono>                                   // std::chrono::high_resolution_clock
@@ -427,12 +427,12 @@ struct MandelbrotKernelTester
             maxIterations));
 
         // Profile the kernel execution.
-        std::cout << "Execution time: "
-            << alpaka::examples::measureKernelRunTimeMs(
-                stream,
-                exec)
-            << " ms"
-            << std::endl;
+        alpaka::examples::measureKernelRunTime(
+            "mandelbrot",
+            stream,
+            exec,
+            // Write one color per pixel. The number of operations depends on the iterations per pixel.
+            static_cast<double>(numRows * numCols * sizeof(Val)));
 
         // Copy back the result.
         alpaka::mem::view::copy(stream, bufColorHost, bufColorAcc, extent);
@@ -20,7 +20,7 @@
  */
 
 #include <alpaka/alpaka.hpp>                        // alpaka::exec::create
-#include <alpaka/examples/MeasureKernelRunTime.hpp> // measureKernelRunTimeMs
+#include <alpaka/examples/MeasureKernelRunTime.hpp> // measureKernelRunTime
 #include <alpaka/examples/accs/EnabledAccs.hpp>     // EnabledAccs
 
 #include <boost/core/ignore_unused.hpp>             // boost::ignore_unused
@@ -326,17 +326,19 @@ struct MatMulTester
             static_cast<TSize>(alpaka::mem::view::getPitchBytes<1u>(bufAAcc) / sizeof(Val)),
             alpaka::mem::view::getPtrNative(bufBAcc),
             static_cast<TSize>(alpaka::mem::view::getPitchBytes<1u>(bufBAcc) / sizeof(Val)),
-            static_cast<Val>(1),
+            // beta is zero so that the repeated benchmark executions do not accumulate into C.
+            static_cast<Val>(0),
             alpaka::mem::view::getPtrNative(bufCAcc),
             static_cast<TSize>(alpaka::mem::view::getPitchBytes<1u>(bufCAcc) / sizeof(Val))));
 
         // Profile the kernel execution.
-        std::cout << "Execution time: "
-            << alpaka::examples::measureKernelRunTimeMs(
-                streamAcc,
-                exec)
-            << " ms"
-            << std::endl;
+        alpaka::examples::measureKernelRunTime(
+            "matMul",
+            streamAcc,
+            exec,
+            // Read A, B and C, write C. Each cell takes k multiply-adds.
+            static_cast<double>((m * k + k * n + 2u * m * n) * sizeof(Val)),
+            2.0 * static_cast<double>(m) * static_cast<double>(n) * static_cast<double>(k));
 
         // Copy back the result.
         alpaka::mem::view::copy(streamAcc, bufCHost, bufCAcc, extentC);
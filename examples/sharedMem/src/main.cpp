@@ -20,7 +20,7 @@
 */
 
 #include <alpaka/alpaka.hpp>                        // alpaka::exec::create
-#include <alpaka/examples/MeasureKernelRunTime.hpp> // measureKernelRunTimeMs
+#include <alpaka/examples/MeasureKernelRunTime.hpp> // measureKernelRunTime
 #include <alpaka/examples/accs/EnabledAccs.hpp>     // EnabledAccs
 
 #include <chrono>                                   // std::chrono::high_resolution_clock
@@ -226,12 +226,12 @@ struct SharedMemTester
             mult2));
 
         // Profile the kernel execution.
-        std::cout << "Execution time: "
-            << alpaka::examples::measureKernelRunTimeMs(
-                stream,
-                exec)
-            << " ms"
-            << std::endl;
+        alpaka::examples::measureKernelRunTime(
+            "sharedMem",
+            stream,
+            exec,
+            // Write one value per block.
+            static_cast<double>(gridBlocksCount * sizeof(TVal)));
 
         // Copy back the result.
         alpaka::mem::view::copy(stream, blockRetVals, blockRetValsAcc, resultElemCount);
@@ -0,0 +1,314 @@
+/**
+ * \file
+ * Copyright 2014-2015 Benjamin Worpitz
+ *
+ * This file is part of alpaka.
+ *
+ * alpaka is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * alpaka is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with alpaka.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <alpaka/alpaka.hpp>                        // alpaka::exec::create
+#include <alpaka/examples/accs/EnabledAccs.hpp>     // EnabledAccs
+
+#include <algorithm>                                // std::min
+#include <chrono>                                   // std::chrono::high_resolution_clock
+#include <iostream>                                 // std::cout
+#include <iomanip>                                  // std::setw
+#include <limits>                                   // std::numeric_limits
+#include <typeinfo>                                 // typeid
+#include <utility>                                  // std::swap
+
+//#############################################################################
+//! A Jacobi iteration of the 2D Laplace equation (5 point stencil).
+//!
+//! Each thread updates a tile of elements. Updating the border of a tile reads the tiles of the neighbouring threads.
+//! The outermost rows and columns are the fixed boundary.
+//#############################################################################
+class JacobiKernel
+{
+public:
+    //-----------------------------------------------------------------------------
+    //! The kernel entrypoint.
+    //!
+    //! \param acc The accelerator to be executed on.
+    //! \param src The pointer to the values of the previous iteration.
+    //! \param dst The pointer to the values of the current iteration.
+    //! \param numRows The number of rows of the grid.
+    //! \param numCols The number of columns of the grid.
+    //! \param pitchElems The pitch of both grids in elements.
+    //-----------------------------------------------------------------------------
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TElem,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        TElem const * const src,
+        TElem * const dst,
+        TSize const & numRows,
+        TSize const & numCols,
+        TSize const & pitchElems) const
+    -> void
+    {
+        static_assert(alpaka::dim::Dim<TAcc>::value == 2u,
+            "The accelerator used for the JacobiKernel has to be 2 dimensional!");
+
+        auto const gridThreadIdx(alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>(acc));
+        auto const threadElemExtent(alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>(acc));
+
+        TSize const one(1u);
+        TSize const rowBegin(gridThreadIdx[0u] * threadElemExtent[0u]);
+        TSize const colBegin(gridThreadIdx[1u] * threadElemExtent[1u]);
+        TSize const rowEnd((rowBegin + threadElemExtent[0u] < numRows - one) ? rowBegin + threadElemExtent[0u] : numRows - one);
+        TSize const colEnd((colBegin + threadElemExtent[1u] < numCols - one) ? colBegin + threadElemExtent[1u] : numCols - one);
+
+        for(TSize row(rowBegin < one ? one : rowBegin); row < rowEnd; ++row)
+        {
+            for(TSize col(colBegin < one ? one : colBegin); col < colEnd; ++col)
+            {
+                dst[row * pitchElems + col] =
+                    static_cast<TElem>(0.25) * (
+                        src[(row - one) * pitchElems + col]
+                        + src[(row + one) * pitchElems + col]
+                        + src[row * pitchElems + col - one]
+                        + src[row * pitchElems + col + one]);
+            }
+        }
+    }
+};
+
+//#############################################################################
+//! Profiles the Jacobi kernel with all block traversal orders.
+//#############################################################################
+struct JacobiKernelTester
+{
+    template<
+        typename TAcc,
+        typename TSize>
+    auto operator()(
+        TSize const & numRows,
+        TSize const & numCols,
+        TSize const & tileSize,
+        std::size_t const & iterations)
+    -> void
+    {
+        std::cout << std::endl;
+        std::cout << "################################################################################" << std::endl;
+
+        using Val = float;
+        using Dim = alpaka::dim::DimInt<2u>;
+
+        // Create the kernel function object.
+        JacobiKernel kernel;
+
+        // Get the host device.
+        auto devHost(alpaka::dev::cpu::getDev());
+
+        // Select a device to execute on.
+        alpaka::dev::Dev<TAcc> devAcc(
+            alpaka::dev::DevMan<TAcc>::getDevByIdx(0));
+
+        // Get a stream on this device.
+        alpaka::examples::Stream<alpaka::dev::Dev<TAcc>> stream(devAcc);
+
+        alpaka::Vec<Dim, TSize> const extent(
+            numRows,
+            numCols);
+
+        // Each block consists of a single thread updating a tile of elements.
+        // This makes the order of the blocks the order in which the tiles are updated.
+        alpaka::workdiv::WorkDivMembers<Dim, TSize> const workDiv(
+            alpaka::Vec<Dim, TSize>(
+                static_cast<TSize>((numRows + tileSize - 1u) / tileSize),
+                static_cast<TSize>((numCols + tileSize - 1u) / tileSize)),
+            alpaka::Vec<Dim, TSize>::ones(),
+            alpaka::Vec<Dim, TSize>(
+                tileSize,
+                tileSize));
+
+        std::cout
+            << "JacobiKernelTester("
+            << " numRows:" << numRows
+            << ", numCols:" << numCols
+            << ", iterations:" << iterations
+            << ", accelerator: " << alpaka::acc::getAccName<TAcc>()
+            << ", kernel: " << typeid(kernel).name()
+            << ", workDiv: " << workDiv
+            << ")" << std::endl;
+
+        // Allocate the host memory and initialize it with a hot top boundary.
+        auto bufHost(
+            alpaka::mem::buf::alloc<Val, TSize>(devHost, extent));
+        Val * const pHost(alpaka::mem::view::getPtrNative(bufHost));
+        TSize const pitchElemsHost(static_cast<TSize>(alpaka::mem::view::getPitchBytes<1u>(bufHost) / sizeof(Val)));
+        for(TSize row(0u); row < numRows; ++row)
+        {
+            for(TSize col(0u); col < numCols; ++col)
+            {
+                pHost[row * pitchElemsHost + col] = (row == 0u) ? static_cast<Val>(1) : static_cast<Val>(0);
+            }
+        }
+
+        // Allocate the buffers on the accelerator.
+        auto bufAcc0(
+            alpaka::mem::buf::alloc<Val, TSize>(devAcc, extent));
+        auto bufAcc1(
+            alpaka::mem::buf::alloc<Val, TSize>(devAcc, extent));
+        TSize const pitchElemsAcc(static_cast<TSize>(alpaka::mem::view::getPitchBytes<1u>(bufAcc0) / sizeof(Val)));
+
+        auto const blockTraversalPrev(alpaka::exec::getBlockTraversal());
+
+        std::cout
+            << std::setw(16) << "traversal"
+            << std::setw(16) << "time [ms]"
+            << std::setw(16) << "MLUP/s"
+            << std::setw(16) << "checksum"
+            << std::endl;
+
+        for(auto const & traversal : {"lexicographic", "morton", "hilbert", "tiled"})
+        {
+            alpaka::exec::setBlockTraversal(alpaka::exec::parseBlockTraversal(traversal));
+
+            // Copy Host -> Acc.
+            alpaka::mem::view::copy(stream, bufAcc0, bufHost, extent);
+            alpaka::mem::view::copy(stream, bufAcc1, bufHost, extent);
+
+            Val * pSrc(alpaka::mem::view::getPtrNative(bufAcc0));
+            Val * pDst(alpaka::mem::view::getPtrNative(bufAcc1));
+
+            // The first iteration warms up the caches and the block traversal.
+            double durationMinMs(std::numeric_limits<double>::max());
+            for(std::size_t iteration(0u); iteration <= iterations; ++iteration)
+            {
+                auto const exec(alpaka::exec::create<TAcc>(
+                    workDiv,
+                    kernel,
+                    static_cast<Val const *>(pSrc),
+                    pDst,
+                    numRows,
+                    numCols,
+                    pitchElemsAcc));
+
+                alpaka::wait::wait(stream);
+                auto const tpStart(std::chrono::high_resolution_clock::now());
+                alpaka::stream::enqueue(stream, exec);
+                alpaka::wait::wait(stream);
+                auto const tpEnd(std::chrono::high_resolution_clock::now());
+                if(iteration > 0u)
+                {
+                    durationMinMs = std::min(durationMinMs, std::chrono::duration<double, std::milli>(tpEnd - tpStart).count());
+                }
+
+                std::swap(pSrc, pDst);
+            }
+
+            // Copy back the result of the last iteration. All orders have to compute the same values.
+            alpaka::mem::view::copy(
+                stream,
+                bufHost,
+                (pSrc == alpaka::mem::view::getPtrNative(bufAcc0)) ? bufAcc0 : bufAcc1,
+                extent);
+            alpaka::wait::wait(stream);
+            double checksum(0.0);
+            for(TSize row(0u); row < numRows; ++row)
+            {
+                for(TSize col(0u); col < numCols; ++col)
+                {
+                    checksum += static_cast<double>(pHost[row * pitchElemsHost + col]);
+                }
+            }
+
+            // Reset the host buffer to the initial values for the next traversal.
+            for(TSize row(1u); row < numRows; ++row)
+            {
+                for(TSize col(0u); col < numCols; ++col)
+                {
+                    pHost[row * pitchElemsHost + col] = static_cast<Val>(0);
+                }
+            }
+
+            std::cout
+                << std::setw(16) << traversal
+                << std::setw(16) << durationMinMs
+                << std::setw(16) << static_cast<double>((numRows - 2u) * (numCols - 2u)) / durationMinMs / 1e3
+                << std::setw(16) << checksum
+                << std::endl;
+        }
+
+        alpaka::exec::setBlockTraversal(blockTraversalPrev);
+
+        std::cout << "################################################################################" << std::endl;
+    }
+};
+
+//-----------------------------------------------------------------------------
+//! Program entry point.
+//-----------------------------------------------------------------------------
+auto main()
+-> int
+{
+    try
+    {
+        std::cout << std::endl;
+        std::cout << "################################################################################" << std::endl;
+        std::cout << "                         alpaka block traversal stencil test                    " << std::endl;
+        std::cout << "################################################################################" << std::endl;
+        std::cout << std::endl;
+
+        // Logs the enabled accelerators.
+        alpaka::examples::accs::writeEnabledAccs<alpaka::dim::DimInt<2u>, std::size_t>(std::cout);
+
+        std::cout << std::endl;
+
+        JacobiKernelTester jacobiTester;
+
+        // For different sizes.
+        for(std::size_t gridSize(1u<<9u);
+#if ALPAKA_INTEGRATION_TEST
+            gridSize <= 1u<<9u;
+#else
+            gridSize <= 1u<<13u;
+#endif
+            gridSize *= 4u)
+        {
+            std::cout << std::endl;
+
+            // Execute the kernel on all enabled accelerators.
+            alpaka::core::forEachType<
+                alpaka::examples::accs::EnabledAccs<alpaka::dim::DimInt<2u>, std::size_t>>(
+                    jacobiTester,
+                    gridSize,
+                    gridSize,
+                    static_cast<std::size_t>(16u),
+#if ALPAKA_INTEGRATION_TEST
+                    static_cast<std::size_t>(2u));
+#else
+                    static_cast<std::size_t>(10u));
+#endif
+        }
+        return EXIT_SUCCESS;
+    }
+    catch(std::exception const & e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch(...)
+    {
+        std::cerr << "Unknown Exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+}
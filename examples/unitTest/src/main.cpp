@@ -0,0 +1,576 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <alpaka/alpaka.hpp>                        // alpaka::core::FastDivisor, ...
+#include <alpaka/examples/accs/EnabledAccs.hpp>     // EnabledAccs
+
+#include <cmath>                                    // std::abs
+#include <cstdint>                                  // std::uint8_t, std::uint32_t, std::uint64_t, std::uintptr_t
+#include <cstdio>                                   // std::remove
+#include <cstdlib>                                  // EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream>                                 // std::cout
+#include <limits>                                   // std::numeric_limits
+#include <string>                                   // std::string
+#include <tuple>                                    // std::tuple
+#include <vector>                                   // std::vector
+
+//-----------------------------------------------------------------------------
+//! The number of failed checks.
+//-----------------------------------------------------------------------------
+auto getFailureCount()
+-> std::size_t &
+{
+    static std::size_t failureCount(0u);
+    return failureCount;
+}
+
+//-----------------------------------------------------------------------------
+//! Reports a failed check.
+//-----------------------------------------------------------------------------
+auto check(
+    bool const condition,
+    std::string const & description)
+-> void
+{
+    if(!condition)
+    {
+        std::cerr << "Check failed: " << description << std::endl;
+        ++getFailureCount();
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! Checks the fast division and modulo against the integer division for edge values of the divisor and the dividend.
+//-----------------------------------------------------------------------------
+template<
+    typename TElem>
+auto testFastDivisor()
+-> void
+{
+    auto const max(std::numeric_limits<TElem>::max());
+
+    std::vector<TElem> divisors{1, 2, 3, 5, 7, 10, 11, 100, max, static_cast<TElem>(max - 1), static_cast<TElem>(max / 2), static_cast<TElem>(max / 2 + 1)};
+    for(std::size_t k(1u); k < static_cast<std::size_t>(std::numeric_limits<TElem>::digits); ++k)
+    {
+        auto const pow2(static_cast<TElem>(static_cast<TElem>(1) << k));
+        divisors.push_back(pow2);
+        divisors.push_back(static_cast<TElem>(pow2 - 1));
+        divisors.push_back(static_cast<TElem>(pow2 + 1));
+    }
+
+    std::size_t failureCount(0u);
+    // A linear congruential generator adds pseudo random dividends to the edge values.
+    std::uint64_t random(0x2545F4914F6CDD1Dull);
+    for(auto const & divisor : divisors)
+    {
+        alpaka::core::FastDivisor<TElem> const fastDivisor(divisor);
+
+        std::vector<TElem> dividends{0, 1, static_cast<TElem>(divisor - 1), divisor, max, static_cast<TElem>(max - 1), static_cast<TElem>(max - divisor)};
+        if(divisor < max)
+        {
+            dividends.push_back(static_cast<TElem>(divisor + 1));
+        }
+        if(divisor <= max / 2)
+        {
+            dividends.push_back(static_cast<TElem>(divisor * 2 - 1));
+            dividends.push_back(static_cast<TElem>(divisor * 2));
+        }
+        for(std::size_t i(0u); i < 64u; ++i)
+        {
+            random = random * 6364136223846793005ull + 1442695040888963407ull;
+            dividends.push_back(static_cast<TElem>(random ^ (random >> 29u)));
+        }
+
+        for(auto const & dividend : dividends)
+        {
+            if((fastDivisor.divide(dividend) != dividend / divisor)
+                || (fastDivisor.modulo(dividend) != dividend % divisor))
+            {
+                ++failureCount;
+            }
+        }
+    }
+    check(failureCount == 0u, "FastDivisor<" + std::to_string(sizeof(TElem) * 8u) + " bit> matches / and %");
+}
+
+//-----------------------------------------------------------------------------
+//! Checks the fast index mapper against core::mapIdx.
+//-----------------------------------------------------------------------------
+auto testFastIdxMapper()
+-> void
+{
+    using Dim = alpaka::dim::DimInt<3u>;
+    using Size = std::size_t;
+
+    alpaka::Vec<Dim, Size> const extent(static_cast<Size>(3u), static_cast<Size>(8u), static_cast<Size>(7u));
+    alpaka::core::FastIdxMapper<Dim, Size> const mapper(extent);
+
+    bool bEqual(true);
+    for(Size i(0u); i < extent.prod(); ++i)
+    {
+        alpaka::Vec<alpaka::dim::DimInt<1u>, Size> const idx(i);
+        bEqual = bEqual && (alpaka::core::mapIdx<3u>(idx, mapper) == alpaka::core::mapIdx<3u>(idx, extent));
+    }
+    check(bEqual, "FastIdxMapper matches core::mapIdx");
+}
+
+//#############################################################################
+//! Counts how often each element is visited by the element ranges of the threads.
+//#############################################################################
+template<
+    bool TbGridStrided>
+class ElemRangeKernel
+{
+public:
+    //-----------------------------------------------------------------------------
+    //! The kernel entry point.
+    //-----------------------------------------------------------------------------
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc,
+        typename TSize>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        std::uint32_t * const visitCounts,
+        TSize const & numElements) const
+    -> void
+    {
+        if(TbGridStrided)
+        {
+            for(auto const i : alpaka::idx::elementsGridStrided(acc, numElements))
+            {
+                alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &visitCounts[i], static_cast<std::uint32_t>(1u));
+            }
+        }
+        else
+        {
+            for(auto const i : alpaka::idx::elements(acc, numElements))
+            {
+                alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(acc, &visitCounts[i], static_cast<std::uint32_t>(1u));
+            }
+        }
+    }
+};
+
+//#############################################################################
+//! Checks that the element ranges of all threads cover each element exactly once.
+//#############################################################################
+struct ElemRangeTester
+{
+    template<
+        typename TAcc,
+        typename TSize>
+    auto operator()(
+        TSize const & numElements)
+    -> void
+    {
+        using Dim = alpaka::dim::DimInt<1u>;
+
+        auto devHost(alpaka::dev::cpu::getDev());
+        alpaka::dev::Dev<TAcc> devAcc(
+            alpaka::dev::DevMan<TAcc>::getDevByIdx(0));
+        alpaka::examples::Stream<alpaka::dev::Dev<TAcc>> stream(devAcc);
+
+        alpaka::Vec<Dim, TSize> const extent(numElements);
+        auto bufHost(alpaka::mem::buf::alloc<std::uint32_t, TSize>(devHost, extent));
+        auto bufAcc(alpaka::mem::buf::alloc<std::uint32_t, TSize>(devAcc, extent));
+
+        for(std::size_t gridStrided(0u); gridStrided < 2u; ++gridStrided)
+        {
+            // The grid-strided range has to cover all elements even if the grid is much smaller than the problem.
+            alpaka::workdiv::WorkDivMembers<Dim, TSize> const workDiv(
+                alpaka::workdiv::getValidWorkDiv<TAcc>(
+                    devAcc,
+                    alpaka::Vec<Dim, TSize>(gridStrided ? static_cast<TSize>(numElements / 7u) : numElements),
+                    static_cast<TSize>(3u),
+                    false,
+                    alpaka::workdiv::GridBlockExtentSubDivRestrictions::Unrestricted));
+
+            alpaka::mem::view::set(stream, bufAcc, 0u, extent);
+            if(gridStrided)
+            {
+                alpaka::stream::enqueue(
+                    stream,
+                    alpaka::exec::create<TAcc>(workDiv, ElemRangeKernel<true>(), alpaka::mem::view::getPtrNative(bufAcc), numElements));
+            }
+            else
+            {
+                alpaka::stream::enqueue(
+                    stream,
+                    alpaka::exec::create<TAcc>(workDiv, ElemRangeKernel<false>(), alpaka::mem::view::getPtrNative(bufAcc), numElements));
+            }
+            alpaka::mem::view::copy(stream, bufHost, bufAcc, extent);
+            alpaka::wait::wait(stream);
+
+            bool bCoveredOnce(true);
+            auto const pHost(alpaka::mem::view::getPtrNative(bufHost));
+            for(TSize i(0u); i < numElements; ++i)
+            {
+                bCoveredOnce = bCoveredOnce && (pHost[i] == 1u);
+            }
+            check(
+                bCoveredOnce,
+                std::string(gridStrided ? "elementsGridStrided" : "elements") + " covers each element exactly once on " + alpaka::acc::getAccName<TAcc>());
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+//! Checks that the work division cache survives writing and reading its file, including fields that have to be quoted.
+//-----------------------------------------------------------------------------
+auto testAutoTuneCacheRoundTrip()
+-> void
+{
+    std::string const filePath("unitTest_workDivCache.csv");
+    std::remove(filePath.c_str());
+
+    std::string const key(
+        alpaka::workdiv::detail::quoteCsvField("Kernel<1, \"x\">")
+        + "," + alpaka::workdiv::detail::quoteCsvField("AccCpuSerial<2,m>")
+        + ",2,1024x768,1x1,Unrestricted");
+    alpaka::workdiv::detail::AutoTuneEntry entry;
+    entry.m_gridBlockExtent = "64x48";
+    entry.m_blockThreadExtent = "16x16";
+    entry.m_threadElemExtent = "1x1";
+    entry.m_seconds = 0.1;
+
+    {
+        alpaka::workdiv::detail::AutoTuneCache cache;
+        cache.setFilePath(filePath);
+        cache.insert(key, entry);
+    }
+
+    alpaka::workdiv::detail::AutoTuneCache cache;
+    cache.setFilePath(filePath);
+    alpaka::workdiv::detail::AutoTuneEntry loaded;
+    auto const bFound(cache.find(key, loaded));
+    check(
+        bFound
+        && (loaded.m_gridBlockExtent == entry.m_gridBlockExtent)
+        && (loaded.m_blockThreadExtent == entry.m_blockThreadExtent)
+        && (loaded.m_threadElemExtent == entry.m_threadElemExtent)
+        && (loaded.m_seconds == entry.m_seconds),
+        "the work division cache file round trip keeps the entries");
+
+    std::remove(filePath.c_str());
+}
+
+//-----------------------------------------------------------------------------
+//! \return The element of a pitched 2D host buffer.
+//-----------------------------------------------------------------------------
+template<
+    typename TBuf>
+auto getElem2d(
+    TBuf & buf,
+    std::size_t const & y,
+    std::size_t const & x)
+-> alpaka::elem::Elem<TBuf> &
+{
+    auto const pitchBytes(static_cast<std::size_t>(alpaka::mem::view::getPitchBytes<1u>(buf)));
+    return reinterpret_cast<alpaka::elem::Elem<TBuf> *>(
+        reinterpret_cast<std::uint8_t *>(alpaka::mem::view::getPtrNative(buf)) + y * pitchBytes)[x];
+}
+
+//-----------------------------------------------------------------------------
+//! Checks filling a buffer and a sub-region of it.
+//-----------------------------------------------------------------------------
+auto testFill()
+-> void
+{
+    using Dim = alpaka::dim::DimInt<2u>;
+    using Size = std::size_t;
+
+    auto devHost(alpaka::dev::cpu::getDev());
+    alpaka::stream::StreamCpuSync stream(devHost);
+
+    alpaka::Vec<Dim, Size> const extent(static_cast<Size>(5u), static_cast<Size>(7u));
+    alpaka::Vec<Dim, Size> const extentSub(static_cast<Size>(3u), static_cast<Size>(4u));
+    auto buf(alpaka::mem::buf::alloc<float, Size>(devHost, extent));
+
+    alpaka::mem::view::fill(stream, buf, 2.5f, extent);
+    alpaka::mem::view::fill(stream, buf, 7.0f, extentSub);
+
+    bool bEqual(true);
+    for(Size y(0u); y < extent[0u]; ++y)
+    {
+        for(Size x(0u); x < extent[1u]; ++x)
+        {
+            bool const bSub((y < extentSub[0u]) && (x < extentSub[1u]));
+            bEqual = bEqual && (getElem2d(buf, y, x) == (bSub ? 7.0f : 2.5f));
+        }
+    }
+    check(bEqual, "fill writes the value to the given extent only");
+}
+
+//-----------------------------------------------------------------------------
+//! Checks the converting and the dimension permuting copies.
+//-----------------------------------------------------------------------------
+auto testCopyConvertPermuted()
+-> void
+{
+    using Dim = alpaka::dim::DimInt<2u>;
+    using Size = std::size_t;
+
+    auto devHost(alpaka::dev::cpu::getDev());
+    alpaka::stream::StreamCpuSync stream(devHost);
+
+    alpaka::Vec<Dim, Size> const extent(static_cast<Size>(5u), static_cast<Size>(7u));
+    alpaka::Vec<Dim, Size> const extentTransposed(extent[1u], extent[0u]);
+    auto bufSrc(alpaka::mem::buf::alloc<std::uint8_t, Size>(devHost, extent));
+    auto bufConverted(alpaka::mem::buf::alloc<float, Size>(devHost, extent));
+    auto bufTransposed(alpaka::mem::buf::alloc<std::uint8_t, Size>(devHost, extentTransposed));
+
+    for(Size y(0u); y < extent[0u]; ++y)
+    {
+        for(Size x(0u); x < extent[1u]; ++x)
+        {
+            getElem2d(bufSrc, y, x) = static_cast<std::uint8_t>((y * extent[1u] + x) * 7u);
+        }
+    }
+
+    float const scale(1.0f / 255.0f);
+    alpaka::mem::view::copyConvert(stream, bufConverted, bufSrc, extent, scale);
+    alpaka::mem::view::copyPermuted(stream, bufTransposed, bufSrc, extent, alpaka::Vec<Dim, Size>(static_cast<Size>(1u), static_cast<Size>(0u)));
+
+    bool bConverted(true);
+    bool bTransposed(true);
+    for(Size y(0u); y < extent[0u]; ++y)
+    {
+        for(Size x(0u); x < extent[1u]; ++x)
+        {
+            auto const expected(static_cast<float>(getElem2d(bufSrc, y, x)) * scale);
+            bConverted = bConverted && (std::abs(getElem2d(bufConverted, y, x) - expected) <= 1e-6f);
+            bTransposed = bTransposed && (getElem2d(bufTransposed, x, y) == getElem2d(bufSrc, y, x));
+        }
+    }
+    check(bConverted, "copyConvert scales and converts each element");
+    check(bTransposed, "copyPermuted transposes a 2D buffer");
+}
+
+//-----------------------------------------------------------------------------
+//! Checks that packing all neighbour regions and unpacking them into a second buffer fills its ghost cells.
+//-----------------------------------------------------------------------------
+auto testHalo()
+-> void
+{
+    using Dim = alpaka::dim::DimInt<2u>;
+    using Size = std::size_t;
+
+    auto devHost(alpaka::dev::cpu::getDev());
+    alpaka::stream::StreamCpuSync stream(devHost);
+
+    alpaka::Vec<Dim, Size> const extent(static_cast<Size>(6u), static_cast<Size>(9u));
+    alpaka::Vec<Dim, Size> const haloWidth(static_cast<Size>(1u), static_cast<Size>(2u));
+    auto const directions(alpaka::mem::halo::getAllDirections<Dim>());
+
+    auto bufSrc(alpaka::mem::buf::alloc<std::uint32_t, Size>(devHost, extent));
+    auto bufDst(alpaka::mem::buf::alloc<std::uint32_t, Size>(devHost, extent));
+    for(Size y(0u); y < extent[0u]; ++y)
+    {
+        for(Size x(0u); x < extent[1u]; ++x)
+        {
+            getElem2d(bufSrc, y, x) = static_cast<std::uint32_t>(y * 100u + x + 1u);
+        }
+    }
+    alpaka::mem::view::set(stream, bufDst, 0u, extent);
+
+    alpaka::Vec<alpaka::dim::DimInt<1u>, Size> const extentStaging(
+        alpaka::mem::halo::getPackedSize(extent, haloWidth, directions));
+    auto bufStaging(alpaka::mem::buf::alloc<std::uint32_t, Size>(devHost, extentStaging));
+    alpaka::mem::halo::pack(stream, bufStaging, bufSrc, haloWidth, directions);
+    alpaka::mem::halo::unpack(stream, bufDst, bufStaging, haloWidth, directions);
+
+    // The ghost cells in each direction receive the innermost interior cells adjacent to the same direction.
+    // The interior is not touched.
+    auto const getSrcIdx(
+        [&](Size const & idx, Size const & d)
+        -> Size
+        {
+            return
+                (idx < haloWidth[d])
+                ? idx + haloWidth[d]
+                : ((idx >= extent[d] - haloWidth[d]) ? idx - haloWidth[d] : idx);
+        });
+    bool bEqual(true);
+    for(Size y(0u); y < extent[0u]; ++y)
+    {
+        for(Size x(0u); x < extent[1u]; ++x)
+        {
+            auto const srcY(getSrcIdx(y, 0u));
+            auto const srcX(getSrcIdx(x, 1u));
+            bool const bGhost((srcY != y) || (srcX != x));
+            bEqual = bEqual && (getElem2d(bufDst, y, x) == (bGhost ? getElem2d(bufSrc, srcY, srcX) : 0u));
+        }
+    }
+    check(bEqual, "halo pack and unpack fill the ghost cells of all directions");
+}
+
+//-----------------------------------------------------------------------------
+//! Checks the field layout, the accessor and the copies of structure of arrays buffers.
+//-----------------------------------------------------------------------------
+auto testSoA()
+-> void
+{
+    using Dim = alpaka::dim::DimInt<1u>;
+    using Size = std::size_t;
+    using Fields = std::tuple<double, std::uint8_t, float>;
+
+    auto devHost(alpaka::dev::cpu::getDev());
+    alpaka::stream::StreamCpuSync stream(devHost);
+
+    alpaka::Vec<Dim, Size> const extent(static_cast<Size>(101u));
+    alpaka::mem::buf::BufSoA<Fields, Dim, Size> bufSrc(devHost, extent);
+    alpaka::mem::buf::BufSoA<Fields, Dim, Size> bufDst(devHost, extent);
+
+    auto const src(alpaka::mem::buf::getAccessor(bufSrc));
+    check(
+        (reinterpret_cast<std::uintptr_t>(src.field<1u>()) % alpaka::mem::buf::soa::detail::soaAlignmentBytes == 0u)
+        && (reinterpret_cast<std::uintptr_t>(src.field<2u>()) % alpaka::mem::buf::soa::detail::soaAlignmentBytes == 0u),
+        "the structure of arrays fields are aligned");
+    for(Size i(0u); i < extent[0u]; ++i)
+    {
+        src.get<0u>(i) = static_cast<double>(i) * 0.5;
+        src.get<1u>(i) = static_cast<std::uint8_t>(i);
+        src.get<2u>(i) = static_cast<float>(i) * 2.0f;
+    }
+
+    alpaka::mem::buf::copySoA(stream, bufDst, bufSrc);
+    auto bufField(alpaka::mem::buf::alloc<float, Size>(devHost, extent));
+    auto const field(alpaka::mem::buf::getField<2u>(bufDst));
+    alpaka::mem::view::copy(stream, bufField, field, extent);
+
+    auto const dst(alpaka::mem::buf::getAccessor(bufDst));
+    bool bEqual(true);
+    for(Size i(0u); i < extent[0u]; ++i)
+    {
+        bEqual = bEqual
+            && (dst.get<0u>(i) == static_cast<double>(i) * 0.5)
+            && (dst.get<1u>(i) == static_cast<std::uint8_t>(i))
+            && (alpaka::mem::view::getPtrNative(bufField)[i] == static_cast<float>(i) * 2.0f);
+    }
+    check(bEqual, "copySoA and getField copy all fields");
+}
+
+#if BOOST_OS_UNIX
+//-----------------------------------------------------------------------------
+//! Checks writing and reading a buffer to and from a file and mapping the file as a buffer.
+//-----------------------------------------------------------------------------
+auto testFileIo()
+-> void
+{
+    using Dim = alpaka::dim::DimInt<1u>;
+    using Size = std::size_t;
+
+    std::string const filePath("unitTest_io.bin");
+
+    auto devHost(alpaka::dev::cpu::getDev());
+    alpaka::stream::StreamCpuSync stream(devHost);
+
+    alpaka::Vec<Dim, Size> const extent(static_cast<Size>(1000u));
+    auto bufSrc(alpaka::mem::buf::alloc<float, Size>(devHost, extent));
+    auto bufRead(alpaka::mem::buf::alloc<float, Size>(devHost, extent));
+    for(Size i(0u); i < extent[0u]; ++i)
+    {
+        alpaka::mem::view::getPtrNative(bufSrc)[i] = static_cast<float>(i) + 0.25f;
+    }
+
+    alpaka::mem::io::write(stream, bufSrc, filePath, 0u);
+    alpaka::mem::io::read(stream, filePath, 0u, bufRead);
+
+    bool bRead(true);
+    for(Size i(0u); i < extent[0u]; ++i)
+    {
+        bRead = bRead && (alpaka::mem::view::getPtrNative(bufRead)[i] == alpaka::mem::view::getPtrNative(bufSrc)[i]);
+    }
+    check(bRead, "mem::io reads back the written buffer");
+
+    {
+        // Map the file behind the first 100 elements.
+        Size const offset(100u);
+        alpaka::Vec<Dim, Size> const extentMapped(extent[0u] - offset);
+        alpaka::mem::buf::BufMmap<float const, Dim, Size> const bufMapped(
+            devHost,
+            filePath,
+            extentMapped,
+            offset * sizeof(float),
+            alpaka::mem::buf::MmapAdvice::Sequential);
+
+        bool bMapped(true);
+        for(Size i(0u); i < extentMapped[0u]; ++i)
+        {
+            bMapped = bMapped && (alpaka::mem::view::getPtrNative(bufMapped)[i] == alpaka::mem::view::getPtrNative(bufSrc)[offset + i]);
+        }
+        check(bMapped, "BufMmap maps the file content at the given offset");
+    }
+
+    std::remove(filePath.c_str());
+}
+#endif
+
+//-----------------------------------------------------------------------------
+//! Program entry point.
+//-----------------------------------------------------------------------------
+auto main()
+-> int
+{
+    try
+    {
+        std::cout << std::endl;
+        std::cout << "################################################################################" << std::endl;
+        std::cout << "                              alpaka unit test                                  " << std::endl;
+        std::cout << "################################################################################" << std::endl;
+        std::cout << std::endl;
+
+        testFastDivisor<std::uint8_t>();
+        testFastDivisor<std::uint16_t>();
+        testFastDivisor<std::uint32_t>();
+        testFastDivisor<std::uint64_t>();
+        testFastIdxMapper();
+
+        alpaka::core::forEachType<
+            alpaka::examples::accs::EnabledAccs<alpaka::dim::DimInt<1u>, std::size_t>>(
+                ElemRangeTester(),
+                static_cast<std::size_t>(1000u));
+
+        testAutoTuneCacheRoundTrip();
+        testFill();
+        testCopyConvertPermuted();
+        testHalo();
+        testSoA();
+#if BOOST_OS_UNIX
+        testFileIo();
+#endif
+
+        std::cout << getFailureCount() << " checks failed" << std::endl;
+
+        return (getFailureCount() == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch(std::exception const & e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch(...)
+    {
+        std::cerr << "Unknown Exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -20,7 +20,7 @@
  */
 
 #include <alpaka/alpaka.hpp>                        // alpaka::exec::create
-#include <alpaka/examples/MeasureKernelRunTime.hpp> // measureKernelRunTimeMs
+#include <alpaka/examples/MeasureKernelRunTime.hpp> // measureKernelRunTime
 #include <alpaka/examples/accs/EnabledAccs.hpp>     // EnabledAccs
 
 #include <chrono>                                   // std::chrono::high_resolution_clock
@@ -31,8 +31,10 @@
 
 //#############################################################################
 //! A vector addition kernel.
-//! \tparam TAcc The accelerator environment to be executed on.
+//! \tparam TAlignment The alignment in bytes guaranteed for the vectors.
 //#############################################################################
+template<
+    std::size_t TAlignment>
 class VectorAddKernel
 {
 public:
@@ -63,20 +65,15 @@ public:
             alpaka::dim::Dim<TAcc>::value == 1,
             "The VectorAddKernel expects 1-dimensional indices!");
 
-        auto const gridThreadIdx(alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>(acc)[0u]);
-        auto const threadElemExtent(alpaka::workdiv::getWorkDiv<alpaka::Thread, alpaka::Elems>(acc)[0u]);
-        auto const threadFirstElemIdx(gridThreadIdx * threadElemExtent);
+        // The vectors are known to share the alignment so the loop is vectorized without peeling each of them separately.
+        auto const pA(alpaka::core::align::assumeAligned<TAlignment>(A));
+        auto const pB(alpaka::core::align::assumeAligned<TAlignment>(B));
+        auto const pC(alpaka::core::align::assumeAligned<TAlignment>(C));
 
-        if(threadFirstElemIdx < numElements)
+        // Each thread adds its contiguous chunk of the vectors.
+        for(auto const i : alpaka::idx::elements(acc, numElements))
         {
-            // Calculate the number of elements to compute in this thread.
-            // The result is uniform for all but the last thread.
-            auto const elems(threadElemExtent + alpaka::math::min(acc, static_cast<unsigned long long>(0u), static_cast<unsigned long long>(numElements-(threadFirstElemIdx+threadElemExtent))));
-
-            for(TSize i(threadFirstElemIdx); i<(threadFirstElemIdx+elems); ++i)
-            {
-                C[gridThreadIdx] = A[gridThreadIdx] + B[gridThreadIdx];
-            }
+            pC[i] = pA[i] + pB[i];
         }
     }
 };
@@ -98,8 +95,10 @@ struct VectorAddKernelTester
 
         using Val = float;
 
-        // Create the kernel function object.
-        VectorAddKernel kernel;
+        // Create the kernel function object relying on the alignment guaranteed for the accelerator buffers.
+        VectorAddKernel<
+            alpaka::mem::view::Alignment<
+                alpaka::mem::buf::Buf<alpaka::dev::Dev<TAcc>, Val, alpaka::dim::DimInt<1u>, TSize>>::value> kernel;
 
         // Get the host device.
         auto devHost(alpaka::dev::cpu::getDev());
@@ -162,12 +161,13 @@ struct VectorAddKernelTester
             numElements));
 
         // Profile the kernel execution.
-        std::cout << "Execution time: "
-            << alpaka::examples::measureKernelRunTimeMs(
-                stream,
-                exec)
-            << " ms"
-            << std::endl;
+        alpaka::examples::measureKernelRunTime(
+            "vectorAdd",
+            stream,
+            exec,
+            // Read A and B, write C.
+            static_cast<double>(3u * numElements * sizeof(Val)),
+            static_cast<double>(numElements));
 
         // Copy back the result.
         alpaka::mem::view::copy(stream, memBufHostC, memBufAccC, extent);
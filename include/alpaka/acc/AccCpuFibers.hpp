@@ -25,7 +25,7 @@
 #include <alpaka/workdiv/WorkDivMembers.hpp>    // workdiv::WorkDivMembers
 #include <alpaka/idx/gb/IdxGbRef.hpp>           // IdxGbRef
 #include <alpaka/idx/bt/IdxBtRefFiberIdMap.hpp> // IdxBtRefFiberIdMap
-#include <alpaka/atomic/AtomicNoOp.hpp>         // AtomicNoOp
+#include <alpaka/atomic/AtomicStlLock.hpp>      // AtomicStlLock
 #include <alpaka/math/MathStl.hpp>              // MathStl
 #include <alpaka/block/shared/BlockSharedAllocMasterSync.hpp>   // BlockSharedAllocMasterSync
 #include <alpaka/block/sync/BlockSyncFiberIdMapBarrier.hpp>     // BlockSyncFiberIdMapBarrier
@@ -47,6 +47,7 @@
 
 #include <cassert>                              // assert
 #include <memory>                               // std::unique_ptr
+#include <mutex>                                // std::mutex
 #include <typeinfo>                             // typeid
 
 namespace alpaka
@@ -77,7 +78,7 @@ namespace alpaka
             public workdiv::WorkDivMembers<TDim, TSize>,
             public idx::gb::IdxGbRef<TDim, TSize>,
             public idx::bt::IdxBtRefFiberIdMap<TDim, TSize>,
-            public atomic::AtomicNoOp,
+            public atomic::AtomicStlLock,
             public math::MathStl,
             public block::shared::BlockSharedAllocMasterSync,
             public block::sync::BlockSyncFiberIdMapBarrier<TSize>,
@@ -99,11 +100,12 @@ namespace alpaka
             template<
                 typename TWorkDiv>
             ALPAKA_FN_ACC_NO_CUDA AccCpuFibers(
-                TWorkDiv const & workDiv) :
+                TWorkDiv const & workDiv,
+                std::mutex & mtxAtomic) :
                     workdiv::WorkDivMembers<TDim, TSize>(workDiv),
                     idx::gb::IdxGbRef<TDim, TSize>(m_gridBlockIdx),
                     idx::bt::IdxBtRefFiberIdMap<TDim, TSize>(m_fibersToIndices),
-                    atomic::AtomicNoOp(),
+                    atomic::AtomicStlLock(mtxAtomic),
                     math::MathStl(),
                     block::shared::BlockSharedAllocMasterSync(
                         [this](){block::sync::syncBlockThreads(*this);},
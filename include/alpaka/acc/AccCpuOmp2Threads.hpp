@@ -98,7 +98,7 @@ namespace alpaka
                 TWorkDiv const & workDiv) :
                     workdiv::WorkDivMembers<TDim, TSize>(workDiv),
                     idx::gb::IdxGbRef<TDim, TSize>(m_gridBlockIdx),
-                    idx::bt::IdxBtOmp<TDim, TSize>(),
+                    idx::bt::IdxBtOmp<TDim, TSize>(workdiv::getWorkDiv<Block, Threads>(workDiv)),
                     atomic::AtomicOmpCritSec(),
                     math::MathStl(),
                     block::shared::BlockSharedAllocMasterSync(
@@ -45,6 +45,7 @@
 
 #include <cassert>                                  // assert
 #include <memory>                                   // std::unique_ptr
+#include <mutex>                                    // std::mutex
 #include <thread>                                   // std::thread
 #include <typeinfo>                                 // typeid
 
@@ -92,15 +93,18 @@ namespace alpaka
         private:
             //-----------------------------------------------------------------------------
             //! Constructor.
+            //!
+            //! \param mtxAtomic The mutex protecting the atomic operations of all blocks of the grid.
             //-----------------------------------------------------------------------------
             template<
                 typename TWorkDiv>
             ALPAKA_FN_ACC_NO_CUDA AccCpuThreads(
-                TWorkDiv const & workDiv) :
+                TWorkDiv const & workDiv,
+                std::mutex & mtxAtomic) :
                     workdiv::WorkDivMembers<TDim, TSize>(workDiv),
                     idx::gb::IdxGbRef<TDim, TSize>(m_gridBlockIdx),
                     idx::bt::IdxBtRefThreadIdMap<TDim, TSize>(m_threadToIndexMap),
-                    atomic::AtomicStlLock(),
+                    atomic::AtomicStlLock(mtxAtomic),
                     math::MathStl(),
                     block::shared::BlockSharedAllocMasterSync(
                         [this](){block::sync::syncBlockThreads(*this);},
@@ -150,6 +150,8 @@
 //-----------------------------------------------------------------------------
 // exec
 //-----------------------------------------------------------------------------
+#include <alpaka/exec/BlockScheduling.hpp>
+#include <alpaka/exec/BlockTraversal.hpp>
 #include <alpaka/exec/Traits.hpp>
 
 //-----------------------------------------------------------------------------
@@ -178,6 +180,7 @@
 #endif
 #include <alpaka/idx/gb/IdxGbRef.hpp>
 #include <alpaka/idx/Traits.hpp>
+#include <alpaka/idx/ElemRange.hpp>
 
 //-----------------------------------------------------------------------------
 // kernel
@@ -195,6 +198,7 @@
 //-----------------------------------------------------------------------------
 // mem
 //-----------------------------------------------------------------------------
+#include <alpaka/mem/alloc/AlignedStdAllocator.hpp>
 #include <alpaka/mem/alloc/AllocCpuBoostAligned.hpp>
 #include <alpaka/mem/alloc/AllocCpuNew.hpp>
 #include <alpaka/mem/alloc/Traits.hpp>
@@ -203,10 +207,16 @@
     #include <alpaka/mem/buf/BufCudaRt.hpp>
 #endif
 #include <alpaka/mem/buf/BufCpu.hpp>
+#include <alpaka/mem/buf/BufMmap.hpp>
 #include <alpaka/mem/buf/BufPlainPtrWrapper.hpp>
+#include <alpaka/mem/buf/BufSoA.hpp>
 #include <alpaka/mem/buf/BufStdContainers.hpp>
 #include <alpaka/mem/buf/Traits.hpp>
 
+#include <alpaka/mem/halo/Traits.hpp>
+
+#include <alpaka/mem/io/FileCpu.hpp>
+
 #include <alpaka/mem/view/ViewBasic.hpp>
 #include <alpaka/mem/view/Traits.hpp>
 
@@ -215,6 +225,12 @@
 //-----------------------------------------------------------------------------
 #include <alpaka/offset/Traits.hpp>
 
+//-----------------------------------------------------------------------------
+// profiler
+//-----------------------------------------------------------------------------
+#include <alpaka/profiler/Profiler.hpp>
+#include <alpaka/profiler/Benchmark.hpp>
+
 //-----------------------------------------------------------------------------
 // rand
 //-----------------------------------------------------------------------------
@@ -239,6 +255,7 @@
 #include <alpaka/stream/StreamCpuAsync.hpp>
 #include <alpaka/stream/StreamCpuSync.hpp>
 #include <alpaka/stream/Traits.hpp>
+#include <alpaka/stream/cpu/Stats.hpp>
 
 //-----------------------------------------------------------------------------
 // wait
@@ -251,6 +268,8 @@
 #include <alpaka/workdiv/WorkDivMembers.hpp>
 #include <alpaka/workdiv/Traits.hpp>
 #include <alpaka/workdiv/WorkDivHelpers.hpp>
+#include <alpaka/workdiv/WorkDivCpuHelpers.hpp>
+#include <alpaka/workdiv/WorkDivAutoTuner.hpp>
 
 //-----------------------------------------------------------------------------
 // vec
@@ -263,10 +282,13 @@
 //-----------------------------------------------------------------------------
 #include <alpaka/core/Align.hpp>
 #include <alpaka/core/Common.hpp>
+#include <alpaka/core/FastDivisor.hpp>
 #include <alpaka/core/Fold.hpp>
 #include <alpaka/core/ForEachType.hpp>
+#include <alpaka/core/Histogram.hpp>
 #include <alpaka/core/MapIdx.hpp>
 #include <alpaka/core/NdLoop.hpp>
+#include <alpaka/core/ParallelFor.hpp>
 #include <alpaka/core/Positioning.hpp>
 #include <alpaka/core/Unroll.hpp>
 #include <alpaka/core/Vectorize.hpp>
@@ -45,9 +45,15 @@ namespace alpaka
             using AtomicBase = AtomicStlLock;
 
             //-----------------------------------------------------------------------------
-            //! Default constructor.
+            //! Constructor.
+            //!
+            //! \param mtxAtomic The mutex protecting the atomic operations.
+            //! The accelerators executing the blocks of one grid in parallel have to share it.
             //-----------------------------------------------------------------------------
-            ALPAKA_FN_ACC_NO_CUDA AtomicStlLock() = default;
+            ALPAKA_FN_ACC_NO_CUDA AtomicStlLock(
+                std::mutex & mtxAtomic) :
+                    m_mtxAtomic(mtxAtomic)
+            {}
             //-----------------------------------------------------------------------------
             //! Copy constructor.
             //-----------------------------------------------------------------------------
@@ -70,7 +76,7 @@ namespace alpaka
             ALPAKA_FN_ACC_NO_CUDA /*virtual*/ ~AtomicStlLock() = default;
 
         private:
-            std::mutex mutable m_mtxAtomic; //!< The mutex protecting access for a atomic operation.
+            std::mutex & m_mtxAtomic; //!< The mutex protecting access for a atomic operation. It is owned by the executor of the grid.
         };
 
         namespace traits
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <alpaka/core/Common.hpp>   // ALPAKA_FN_HOST_ACC
+
 #include <boost/predef.h>           // workarounds
 
 #include <cstddef>                  // std::size_t
@@ -106,6 +108,29 @@ namespace alpaka
                             ? 16
                             :*/ RoundUpToPowerOfTwo<TsizeBytes>::value)>
             {};
+
+            //-----------------------------------------------------------------------------
+            //! \return The given pointer annotated to be aligned to TAlignment bytes.
+            //! This lets the compiler use aligned vector loads and stores in the loops accessing it without peeling.
+            //! The pointer is required to actually be aligned.
+            //-----------------------------------------------------------------------------
+            ALPAKA_NO_HOST_ACC_WARNING
+            template<
+                std::size_t TAlignment,
+                typename T>
+            ALPAKA_FN_HOST_ACC auto assumeAligned(
+                T * const ptr)
+            -> T *
+            {
+                static_assert(
+                    (TAlignment & (TAlignment - 1u)) == 0u,
+                    "The alignment is required to be a power of two!");
+#if (BOOST_COMP_GNUC || BOOST_COMP_CLANG || BOOST_COMP_INTEL) && !defined(__CUDA_ARCH__)
+                return static_cast<T *>(__builtin_assume_aligned(ptr, TAlignment));
+#else
+                return ptr;
+#endif
+            }
         }
     }
 }
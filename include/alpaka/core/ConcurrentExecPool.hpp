@@ -45,9 +45,10 @@
 #include <stdexcept>        // std::current_exception
 #include <vector>           // std::vector
 #include <exception>        // std::runtime_error
-#include <utility>          // std::forward
+#include <utility>          // std::forward, std::declval
 #include <atomic>           // std::atomic
 #include <future>           // std::future
+#include <functional>       // std::function, std::bind
 
 namespace alpaka
 {
@@ -292,20 +293,24 @@ namespace alpaka
                 //! \param queueSize
                 //!    The maximum number of tasks that can be queued for completion.
                 //!    Currently running tasks do not belong to the queue anymore.
+                //! \param concurrentExecInitFn
+                //!    If set, each concurrent executor calls it with its index before working on tasks.
                 //-----------------------------------------------------------------------------
                 ConcurrentExecPool(
                     TSize concurrentExecutionCount,
-                    TSize queueSize = 128u) :
+                    TSize queueSize = 128u,
+                    std::function<void(TSize)> concurrentExecInitFn = nullptr) :
                     m_vConcurrentExecs(),
                     m_qTasks(queueSize),
-                    m_bShutdownFlag(false)
+                    m_bShutdownFlag(false),
+                    m_concurrentExecInitFn(std::move(concurrentExecInitFn))
                 {
                     m_vConcurrentExecs.reserve(concurrentExecutionCount);
 
                     // Create all concurrent executors.
                     for(size_t concurrentExec(0u); concurrentExec < concurrentExecutionCount; ++concurrentExec)
                     {
-                        m_vConcurrentExecs.emplace_back(std::bind(&ConcurrentExecPool::concurrentExecFn, this));
+                        m_vConcurrentExecs.emplace_back(std::bind(&ConcurrentExecPool::concurrentExecFn, this, static_cast<TSize>(concurrentExec)));
                     }
                 }
                 //-----------------------------------------------------------------------------
@@ -367,7 +372,7 @@ namespace alpaka
                 auto enqueueTask(
                     TFnObj && task,
                     TArgs && ... args)
-                -> typename std::result_of< decltype(&TPromise<typename std::result_of<TFnObj(TArgs...)>::type>::get_future)(TPromise<typename std::result_of<TFnObj(TArgs...)>::type>) >::type
+                -> decltype(std::declval<TPromise<typename std::result_of<TFnObj(TArgs...)>::type> &>().get_future())
                 {
                     auto boundTask(std::bind(std::forward<TFnObj>(task), std::forward<TArgs>(args)...));
 
@@ -412,8 +417,14 @@ namespace alpaka
                 //-----------------------------------------------------------------------------
                 //! The function the concurrent executors are executing.
                 //-----------------------------------------------------------------------------
-                void concurrentExecFn()
+                void concurrentExecFn(
+                    TSize concurrentExec)
                 {
+                    if(m_concurrentExecInitFn)
+                    {
+                        m_concurrentExecInitFn(concurrentExec);
+                    }
+
                     // Checks whether pool is being destroyed, if so, stop running.
                     while(!m_bShutdownFlag.load(std::memory_order_relaxed))
                     {
@@ -462,6 +473,7 @@ namespace alpaka
                 std::vector<TConcurrentExec> m_vConcurrentExecs;
                 ThreadSafeQueue<ITaskPkg *> m_qTasks;
                 std::atomic<bool> m_bShutdownFlag;
+                std::function<void(TSize)> m_concurrentExecInitFn;
             };
 
             //#############################################################################
@@ -501,22 +513,26 @@ namespace alpaka
                 //! \param queueSize
                 //!    The maximum number of tasks that can be queued for completion.
                 //!    Currently running tasks do not belong to the queue anymore.
+                //! \param concurrentExecInitFn
+                //!    If set, each concurrent executor calls it with its index before working on tasks.
                 //-----------------------------------------------------------------------------
                 ConcurrentExecPool(
                     TSize concurrentExecutionCount,
-                    TSize queueSize = 128u) :
+                    TSize queueSize = 128u,
+                    std::function<void(TSize)> concurrentExecInitFn = nullptr) :
                     m_vConcurrentExecs(),
                     m_qTasks(queueSize),
                     m_mtxWakeup(),
                     m_bShutdownFlag(false),
-                    m_cvWakeup()
+                    m_cvWakeup(),
+                    m_concurrentExecInitFn(std::move(concurrentExecInitFn))
                 {
                     m_vConcurrentExecs.reserve(concurrentExecutionCount);
 
                     // Create all concurrent executors.
                     for(TSize concurrentExec(0u); concurrentExec < concurrentExecutionCount; ++concurrentExec)
                     {
-                        m_vConcurrentExecs.emplace_back(std::bind(&ConcurrentExecPool::concurrentExecFn, this));
+                        m_vConcurrentExecs.emplace_back(std::bind(&ConcurrentExecPool::concurrentExecFn, this, static_cast<TSize>(concurrentExec)));
                     }
                 }
                 //-----------------------------------------------------------------------------
@@ -584,7 +600,7 @@ namespace alpaka
                 auto enqueueTask(
                     TFnObj && task,
                     TArgs && ... args)
-                -> typename std::result_of< decltype(&TPromise<typename std::result_of<TFnObj(TArgs...)>::type>::get_future)(TPromise<typename std::result_of<TFnObj(TArgs...)>::type>) >::type
+                -> decltype(std::declval<TPromise<typename std::result_of<TFnObj(TArgs...)>::type> &>().get_future())
                 {
                     auto boundTask(std::bind(std::forward<TFnObj>(task), std::forward<TArgs>(args)...));
 
@@ -631,8 +647,14 @@ namespace alpaka
                 //-----------------------------------------------------------------------------
                 //! The function the concurrent executors are executing.
                 //-----------------------------------------------------------------------------
-                void concurrentExecFn()
+                void concurrentExecFn(
+                    TSize concurrentExec)
                 {
+                    if(m_concurrentExecInitFn)
+                    {
+                        m_concurrentExecInitFn(concurrentExec);
+                    }
+
                     // Checks whether pool is being destroyed, if so, stop running (lazy check without mutex).
                     while(!m_bShutdownFlag)
                     {
@@ -692,6 +714,7 @@ namespace alpaka
                 TMutex m_mtxWakeup;
                 std::atomic<bool> m_bShutdownFlag;
                 TCondVar m_cvWakeup;
+                std::function<void(TSize)> m_concurrentExecInitFn;
             };
         }
     }
@@ -0,0 +1,370 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <alpaka/vec/Vec.hpp>               // Vec
+#include <alpaka/core/Common.hpp>           // ALPAKA_FN_HOST_ACC
+#include <alpaka/core/IntegerSequence.hpp>  // core::detail::make_index_sequence
+
+#include <boost/predef.h>                   // BOOST_COMP_GNUC, BOOST_COMP_CLANG
+
+#include <cassert>                          // assert
+#include <cstddef>                          // std::size_t
+#include <cstdint>                          // std::uint32_t, std::uint64_t
+#include <type_traits>                      // std::conditional
+
+#if (BOOST_COMP_GNUC || BOOST_COMP_CLANG) && defined(__SIZEOF_INT128__) && !defined(__CUDA_ARCH__)
+    #define ALPAKA_FAST_DIVISOR_INT128
+#endif
+
+namespace alpaka
+{
+    namespace core
+    {
+        namespace detail
+        {
+            //#############################################################################
+            //! The unsigned integer type the fast division of TElem is computed in.
+            //#############################################################################
+            template<
+                typename TElem>
+            using FastDivisorUInt =
+                typename std::conditional<
+                    (sizeof(TElem) <= sizeof(std::uint32_t)),
+                    std::uint32_t,
+                    std::uint64_t>::type;
+
+#if defined(ALPAKA_FAST_DIVISOR_INT128)
+            //#############################################################################
+            //! The 128 bit unsigned integer type. The extension keeps pedantic builds quiet.
+            //#############################################################################
+            __extension__ typedef unsigned __int128 UInt128;
+#endif
+
+            //-----------------------------------------------------------------------------
+            //! \return The upper half of the full product of a and b.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto mulHi(
+                std::uint32_t const & a,
+                std::uint32_t const & b)
+            -> std::uint32_t
+            {
+#if defined(__CUDA_ARCH__)
+                return __umulhi(a, b);
+#else
+                return static_cast<std::uint32_t>((static_cast<std::uint64_t>(a) * static_cast<std::uint64_t>(b)) >> 32u);
+#endif
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The upper half of the full product of a and b.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto mulHi(
+                std::uint64_t const & a,
+                std::uint64_t const & b)
+            -> std::uint64_t
+            {
+#if defined(__CUDA_ARCH__)
+                return __umul64hi(a, b);
+#elif defined(ALPAKA_FAST_DIVISOR_INT128)
+                return static_cast<std::uint64_t>((static_cast<UInt128>(a) * static_cast<UInt128>(b)) >> 64u);
+#else
+                // Schoolbook multiplication of the 32 bit halves.
+                std::uint64_t const aLo(a & 0xFFFFFFFFu);
+                std::uint64_t const aHi(a >> 32u);
+                std::uint64_t const bLo(b & 0xFFFFFFFFu);
+                std::uint64_t const bHi(b >> 32u);
+                std::uint64_t const loLo(aLo * bLo);
+                std::uint64_t const hiLo(aHi * bLo);
+                std::uint64_t const loHi(aLo * bHi);
+                std::uint64_t const cross((loLo >> 32u) + (hiLo & 0xFFFFFFFFu) + loHi);
+                return aHi * bHi + (hiLo >> 32u) + (cross >> 32u);
+#endif
+            }
+            //-----------------------------------------------------------------------------
+            //! \return floor(2^N * numeratorHigh / divisor) for an N bit type where numeratorHigh < divisor.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto divideShifted(
+                std::uint32_t const & numeratorHigh,
+                std::uint32_t const & divisor)
+            -> std::uint32_t
+            {
+                return static_cast<std::uint32_t>((static_cast<std::uint64_t>(numeratorHigh) << 32u) / divisor);
+            }
+            //-----------------------------------------------------------------------------
+            //! \return floor(2^N * numeratorHigh / divisor) for an N bit type where numeratorHigh < divisor.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto divideShifted(
+                std::uint64_t const & numeratorHigh,
+                std::uint64_t const & divisor)
+            -> std::uint64_t
+            {
+#if defined(ALPAKA_FAST_DIVISOR_INT128)
+                return static_cast<std::uint64_t>((static_cast<UInt128>(numeratorHigh) << 64u) / divisor);
+#else
+                // Long division one bit at a time. The remainder stays below the divisor.
+                std::uint64_t quotient(0u);
+                std::uint64_t remainder(numeratorHigh);
+                for(std::size_t bit(0u); bit < 64u; ++bit)
+                {
+                    bool const carry((remainder >> 63u) != 0u);
+                    remainder <<= 1u;
+                    quotient <<= 1u;
+                    if(carry || (remainder >= divisor))
+                    {
+                        remainder -= divisor;
+                        quotient |= 1u;
+                    }
+                }
+                return quotient;
+#endif
+            }
+        }
+
+        //#############################################################################
+        //! A divisor prepared for division by multiplication.
+        //!
+        //! The magic number and the shifts are computed once on the host.
+        //! Each division is then a multiplication returning the upper half of the product, an addition and two shifts
+        //! instead of an integer division taking tens of cycles.
+        //! This is the branch free variant of the method by Granlund and Montgomery,
+        //! "Division by invariant integers using multiplication", PLDI 1994, and is exact for all dividends.
+        //! Powers of two result in a magic number of one whose product vanishes, leaving a shift.
+        //!
+        //! The values are treated as unsigned. Negative dividends or divisors are not supported.
+        //!
+        //! \tparam TElem The integral type of the values.
+        //#############################################################################
+        template<
+            typename TElem>
+        class FastDivisor
+        {
+            using UInt = detail::FastDivisorUInt<TElem>;
+            static constexpr std::size_t bitCount = sizeof(UInt) * 8u;
+
+        public:
+            //-----------------------------------------------------------------------------
+            //! Constructor.
+            //!
+            //! \param divisor The divisor. It has to be larger than zero.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST FastDivisor(
+                TElem const & divisor) :
+                    m_divisor(divisor),
+                    m_magic(1u),
+                    m_shift1(0u),
+                    m_shift2(0u)
+            {
+                assert(divisor > 0);
+
+                auto const d(static_cast<UInt>(divisor));
+
+                // l = ceil(log2(d))
+                std::uint32_t l(0u);
+                while((l < bitCount) && ((static_cast<UInt>(1u) << l) < d))
+                {
+                    ++l;
+                }
+
+                // m = floor(2^N * (2^l - d) / d) + 1
+                // For l == N, 2^l - d is computed modulo 2^N which is exact because the result is smaller than d.
+                UInt const twoPowL((l < bitCount) ? (static_cast<UInt>(1u) << l) : static_cast<UInt>(0u));
+                m_magic = static_cast<UInt>(detail::divideShifted(static_cast<UInt>(twoPowL - d), d) + 1u);
+                m_shift1 = (l < 1u) ? l : 1u;
+                m_shift2 = (l > 0u) ? (l - 1u) : 0u;
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The divisor.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto getDivisor() const
+            -> TElem
+            {
+                return m_divisor;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return dividend / divisor.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto divide(
+                TElem const & dividend) const
+            -> TElem
+            {
+                auto const n(static_cast<UInt>(dividend));
+                auto const t(detail::mulHi(m_magic, n));
+                return static_cast<TElem>((t + ((n - t) >> m_shift1)) >> m_shift2);
+            }
+            //-----------------------------------------------------------------------------
+            //! \return dividend % divisor.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto modulo(
+                TElem const & dividend) const
+            -> TElem
+            {
+                return static_cast<TElem>(dividend - divide(dividend) * m_divisor);
+            }
+
+        private:
+            TElem m_divisor;
+            UInt m_magic;
+            std::uint32_t m_shift1;
+            std::uint32_t m_shift2;
+        };
+
+        namespace detail
+        {
+            //#############################################################################
+            //! Computes the index of dimension Tidx and the higher ones from the remaining linear index.
+            //! The recursion unrolls the loop over the dimensions.
+            //#############################################################################
+            template<
+                std::size_t Tidx>
+            struct FastIdxMapperMapIdx
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    typename TDim,
+                    typename TElem>
+                ALPAKA_FN_HOST_ACC static auto mapIdx(
+                    Vec<TDim, TElem> & idxNd,
+                    TElem const & rest,
+                    FastDivisor<TElem> const (& divisors)[TDim::value])
+                -> void
+                {
+                    auto const quotient(divisors[Tidx].divide(rest));
+                    idxNd[Tidx] = static_cast<TElem>(rest - quotient * divisors[Tidx].getDivisor());
+                    FastIdxMapperMapIdx<Tidx - 1u>::mapIdx(
+                        idxNd,
+                        quotient,
+                        divisors);
+                }
+            };
+            //#############################################################################
+            //! The outermost dimension takes the remaining linear index.
+            //#############################################################################
+            template<>
+            struct FastIdxMapperMapIdx<
+                0u>
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    typename TDim,
+                    typename TElem>
+                ALPAKA_FN_HOST_ACC static auto mapIdx(
+                    Vec<TDim, TElem> & idxNd,
+                    TElem const & rest,
+                    FastDivisor<TElem> const (&)[TDim::value])
+                -> void
+                {
+                    idxNd[0u] = rest;
+                }
+            };
+        }
+
+        //#############################################################################
+        //! Maps linear indices to N dimensional indices of a fixed extent without integer divisions.
+        //!
+        //! It is built once on the host, for example per kernel launch, and can be passed to kernels by value.
+        //!
+        //! \tparam TDim The dimensionality of the extent.
+        //! \tparam TElem The type of the index values.
+        //#############################################################################
+        template<
+            typename TDim,
+            typename TElem>
+        class FastIdxMapper
+        {
+        public:
+            //-----------------------------------------------------------------------------
+            //! Constructor.
+            //!
+            //! \param extent The extent to map the indices to. All values have to be larger than zero.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST FastIdxMapper(
+                Vec<TDim, TElem> const & extent) :
+                    FastIdxMapper(
+                        extent,
+                        core::detail::make_index_sequence<TDim::value>())
+            {}
+
+            //-----------------------------------------------------------------------------
+            //! \return The extent.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto getExtent() const
+            -> Vec<TDim, TElem> const &
+            {
+                return m_extent;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The N dimensional index of the given linear index. The last dimension is the fastest.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto mapIdx(
+                Vec<dim::DimInt<1u>, TElem> const & idx) const
+            -> Vec<TDim, TElem>
+            {
+                auto idxNd(Vec<TDim, TElem>::zeros());
+                detail::FastIdxMapperMapIdx<TDim::value - 1u>::mapIdx(
+                    idxNd,
+                    idx[0u],
+                    m_divisors);
+                return idxNd;
+            }
+
+        private:
+            //-----------------------------------------------------------------------------
+            //! Constructor preparing the divisors of all dimensions.
+            //-----------------------------------------------------------------------------
+            template<
+                std::size_t... TIndices>
+            ALPAKA_FN_HOST FastIdxMapper(
+                Vec<TDim, TElem> const & extent,
+                core::detail::index_sequence<TIndices...> const &) :
+                    m_extent(extent),
+                    m_divisors{FastDivisor<TElem>(extent[TIndices])...}
+            {}
+
+            Vec<TDim, TElem> m_extent;
+            FastDivisor<TElem> m_divisors[TDim::value];
+        };
+
+        //-----------------------------------------------------------------------------
+        //! Maps a linear index to the N dimensional index of the extent of the mapper.
+        //! This is equivalent to core::mapIdx<TDim::value>(idx, mapper.getExtent()) without integer divisions.
+        //-----------------------------------------------------------------------------
+        ALPAKA_NO_HOST_ACC_WARNING
+        template<
+            std::size_t TidxDimOut,
+            typename TElem>
+        ALPAKA_FN_HOST_ACC auto mapIdx(
+            Vec<dim::DimInt<1u>, TElem> const & idx,
+            FastIdxMapper<dim::DimInt<TidxDimOut>, TElem> const & mapper)
+        -> Vec<dim::DimInt<TidxDimOut>, TElem>
+        {
+            return mapper.mapIdx(idx);
+        }
+    }
+}
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <boost/version.hpp>            // BOOST_VERSION
+
 #if BOOST_COMP_MSVC
     #pragma warning(push)
     #pragma warning(disable: 4267)  // boost/asio/detail/impl/socket_ops.ipp(1968): warning C4267: 'argument': conversion from 'size_t' to 'int', possible loss of data
@@ -38,7 +40,11 @@
 // https://github.com/olk/boost-fiber
 #include <boost/fiber/fiber.hpp>        // boost::fibers::fiber
 #include <boost/fiber/operations.hpp>   // boost::this_fiber
-#include <boost/fiber/condition.hpp>    // boost::fibers::condition_variable
+#if BOOST_VERSION >= 106200
+    #include <boost/fiber/condition_variable.hpp>  // boost::fibers::condition_variable
+#else
+    #include <boost/fiber/condition.hpp>            // boost::fibers::condition_variable
+#endif
 #include <boost/fiber/mutex.hpp>        // boost::fibers::mutex
 #include <boost/fiber/future.hpp>       // boost::fibers::future
 //#include <boost/fiber/barrier.hpp>    // boost::fibers::barrier
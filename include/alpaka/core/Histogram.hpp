@@ -0,0 +1,187 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/core/Common.hpp>       // ALPAKA_FN_HOST
+
+#include <algorithm>                    // std::min
+#include <array>                        // std::array
+#include <atomic>                       // std::atomic
+#include <cstddef>                      // std::size_t
+#include <cstdint>                      // std::uint64_t
+
+namespace alpaka
+{
+    namespace core
+    {
+        //#############################################################################
+        //! A histogram of non-negative integer samples with power of two bucket bounds.
+        //!
+        //! Bucket 0 counts the samples 0 and 1, bucket i > 0 counts the samples within [2^i, 2^(i+1)).
+        //#############################################################################
+        struct Histogram
+        {
+            static constexpr std::size_t bucketCount = 64u;
+
+            //-----------------------------------------------------------------------------
+            //! Constructor.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST Histogram() :
+                m_bucketCounts(),
+                m_count(0u),
+                m_sum(0u),
+                m_max(0u)
+            {}
+
+            //-----------------------------------------------------------------------------
+            //! \return The index of the bucket counting the given sample.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST static auto getBucketIdx(
+                std::uint64_t value)
+            -> std::size_t
+            {
+                std::size_t bucketIdx(0u);
+                while(value > 1u)
+                {
+                    value >>= 1u;
+                    ++bucketIdx;
+                }
+                return bucketIdx;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The largest sample counted by the given bucket.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST static auto getBucketUpperBound(
+                std::size_t const & bucketIdx)
+            -> std::uint64_t
+            {
+                return (bucketIdx + 1u < bucketCount)
+                    ? ((static_cast<std::uint64_t>(1u) << (bucketIdx + 1u)) - 1u)
+                    : static_cast<std::uint64_t>(-1);
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The mean of all samples.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getMean() const
+            -> double
+            {
+                return (m_count > 0u) ? static_cast<double>(m_sum) / static_cast<double>(m_count) : 0.0;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return An upper bound of the given quantile (0.5 is the median). It is at most twice the exact value.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getQuantile(
+                double const & quantile) const
+            -> std::uint64_t
+            {
+                if(m_count == 0u)
+                {
+                    return 0u;
+                }
+                auto const rank(static_cast<std::uint64_t>(quantile * static_cast<double>(m_count - 1u)));
+                std::uint64_t count(0u);
+                for(std::size_t bucketIdx(0u); bucketIdx < bucketCount; ++bucketIdx)
+                {
+                    count += m_bucketCounts[bucketIdx];
+                    if(count > rank)
+                    {
+                        return std::min(getBucketUpperBound(bucketIdx), m_max);
+                    }
+                }
+                return m_max;
+            }
+
+            std::array<std::uint64_t, bucketCount> m_bucketCounts;  //!< The number of samples per bucket.
+            std::uint64_t m_count;                                  //!< The number of samples.
+            std::uint64_t m_sum;                                    //!< The sum of all samples.
+            std::uint64_t m_max;                                    //!< The largest sample.
+        };
+
+        //#############################################################################
+        //! A histogram that can be added to concurrently without locking.
+        //#############################################################################
+        class AtomicHistogram final
+        {
+        public:
+            //-----------------------------------------------------------------------------
+            //! Constructor.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST AtomicHistogram()
+            {
+                reset();
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Adds a sample.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto add(
+                std::uint64_t const & value)
+            -> void
+            {
+                m_bucketCounts[Histogram::getBucketIdx(value)].fetch_add(1u, std::memory_order_relaxed);
+                m_count.fetch_add(1u, std::memory_order_relaxed);
+                m_sum.fetch_add(value, std::memory_order_relaxed);
+                auto max(m_max.load(std::memory_order_relaxed));
+                while((value > max) && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+                {
+                }
+            }
+            //-----------------------------------------------------------------------------
+            //! \return A copy of the current state.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto get() const
+            -> Histogram
+            {
+                Histogram histogram;
+                for(std::size_t bucketIdx(0u); bucketIdx < Histogram::bucketCount; ++bucketIdx)
+                {
+                    histogram.m_bucketCounts[bucketIdx] = m_bucketCounts[bucketIdx].load(std::memory_order_relaxed);
+                }
+                histogram.m_count = m_count.load(std::memory_order_relaxed);
+                histogram.m_sum = m_sum.load(std::memory_order_relaxed);
+                histogram.m_max = m_max.load(std::memory_order_relaxed);
+                return histogram;
+            }
+            //-----------------------------------------------------------------------------
+            //! Removes all samples.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto reset()
+            -> void
+            {
+                for(auto & bucketCount : m_bucketCounts)
+                {
+                    bucketCount.store(0u, std::memory_order_relaxed);
+                }
+                m_count.store(0u, std::memory_order_relaxed);
+                m_sum.store(0u, std::memory_order_relaxed);
+                m_max.store(0u, std::memory_order_relaxed);
+            }
+
+        private:
+            std::array<std::atomic<std::uint64_t>, Histogram::bucketCount> m_bucketCounts;
+            std::atomic<std::uint64_t> m_count;
+            std::atomic<std::uint64_t> m_sum;
+            std::atomic<std::uint64_t> m_max;
+        };
+    }
+}
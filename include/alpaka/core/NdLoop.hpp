@@ -28,6 +28,8 @@
 
 #include <alpaka/core/IntegerSequence.hpp>  // core::detail::index_sequence
 
+#include <cassert>                          // assert
+
 namespace alpaka
 {
     namespace core
@@ -208,5 +210,407 @@ namespace alpaka
                 extent,
                 f);
         }
+
+        namespace detail
+        {
+            //#############################################################################
+            //! Increments the index in the dimensions [0, TDimCount-1] in lexicographic order.
+            //! The innermost of these dimensions changes fastest and carries over into the next outer one.
+            //#############################################################################
+            template<
+                std::size_t TDimCount>
+            struct NdLoopIncIdxCarry
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    typename TIndex,
+                    typename TExtentVec>
+                ALPAKA_FN_HOST_ACC static auto incIdx(
+                    TIndex & idx,
+                    TExtentVec const & extent)
+                -> void
+                {
+                    if(++idx[TDimCount - 1u] == extent[TDimCount - 1u])
+                    {
+                        idx[TDimCount - 1u] = 0u;
+                        NdLoopIncIdxCarry<
+                            TDimCount - 1u>
+                        ::template incIdx(
+                            idx,
+                            extent);
+                    }
+                }
+            };
+            //#############################################################################
+            //! Increments the index in the dimensions [0, TDimCount-1] in lexicographic order.
+            //#############################################################################
+            template<>
+            struct NdLoopIncIdxCarry<
+                0u>
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    typename TIndex,
+                    typename TExtentVec>
+                ALPAKA_FN_HOST_ACC static auto incIdx(
+                    TIndex &,
+                    TExtentVec const &)
+                -> void
+                {
+                }
+            };
+            //-----------------------------------------------------------------------------
+            //! \return The product of the extents in the dimensions [0, TDimCount-1].
+            //-----------------------------------------------------------------------------
+            ALPAKA_NO_HOST_ACC_WARNING
+            template<
+                std::size_t TDimCount,
+                typename TExtentVec>
+            ALPAKA_FN_HOST_ACC auto ndLoopOuterCount(
+                TExtentVec const & extent)
+            -> size::Size<TExtentVec>
+            {
+                size::Size<TExtentVec> count(1u);
+                for(std::size_t dimIdx(0u); dimIdx < TDimCount; ++dimIdx)
+                {
+                    count *= extent[dimIdx];
+                }
+                return count;
+            }
+
+            //#############################################################################
+            //! Unrolled iteration of the dimensions [TDimIdx, dim-1] with the compile-time extents TExtents.
+            //#############################################################################
+            template<
+                std::size_t TDimIdx,
+                std::size_t... TExtents>
+            struct NdLoopUnrolledDims;
+            //#############################################################################
+            //! Unrolled iteration of the values [TIter, TExtent-1] of the dimension TDimIdx.
+            //#############################################################################
+            template<
+                std::size_t TDimIdx,
+                std::size_t TIter,
+                std::size_t TExtent,
+                std::size_t... TInnerExtents>
+            struct NdLoopUnrolledIter
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    typename TIndex,
+                    typename TFnObj>
+                ALPAKA_FN_HOST_ACC static auto ndLoop(
+                    TIndex & idx,
+                    TFnObj const & f)
+                -> void
+                {
+                    idx[TDimIdx] = static_cast<size::Size<TIndex>>(TIter);
+                    NdLoopUnrolledDims<
+                        TDimIdx + 1u,
+                        TInnerExtents...>
+                    ::template ndLoop(
+                        idx,
+                        f);
+                    NdLoopUnrolledIter<
+                        TDimIdx,
+                        TIter + 1u,
+                        TExtent,
+                        TInnerExtents...>
+                    ::template ndLoop(
+                        idx,
+                        f);
+                }
+            };
+            //#############################################################################
+            //! Unrolled iteration of the values [TIter, TExtent-1] of the dimension TDimIdx.
+            //#############################################################################
+            template<
+                std::size_t TDimIdx,
+                std::size_t TExtent,
+                std::size_t... TInnerExtents>
+            struct NdLoopUnrolledIter<
+                TDimIdx,
+                TExtent,
+                TExtent,
+                TInnerExtents...>
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    typename TIndex,
+                    typename TFnObj>
+                ALPAKA_FN_HOST_ACC static auto ndLoop(
+                    TIndex &,
+                    TFnObj const &)
+                -> void
+                {
+                }
+            };
+            //#############################################################################
+            //! Unrolled iteration of the dimensions [TDimIdx, dim-1] with the compile-time extents TExtents.
+            //#############################################################################
+            template<
+                std::size_t TDimIdx>
+            struct NdLoopUnrolledDims<
+                TDimIdx>
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    typename TIndex,
+                    typename TFnObj>
+                ALPAKA_FN_HOST_ACC static auto ndLoop(
+                    TIndex & idx,
+                    TFnObj const & f)
+                -> void
+                {
+                    f(idx);
+                }
+            };
+            //#############################################################################
+            //! Unrolled iteration of the dimensions [TDimIdx, dim-1] with the compile-time extents TExtents.
+            //#############################################################################
+            template<
+                std::size_t TDimIdx,
+                std::size_t TExtent,
+                std::size_t... TInnerExtents>
+            struct NdLoopUnrolledDims<
+                TDimIdx,
+                TExtent,
+                TInnerExtents...>
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    typename TIndex,
+                    typename TFnObj>
+                ALPAKA_FN_HOST_ACC static auto ndLoop(
+                    TIndex & idx,
+                    TFnObj const & f)
+                -> void
+                {
+                    NdLoopUnrolledIter<
+                        TDimIdx,
+                        0u,
+                        TExtent,
+                        TInnerExtents...>
+                    ::template ndLoop(
+                        idx,
+                        f);
+                }
+            };
+            //#############################################################################
+            //! Runtime iteration of the outer dimensions [TDimIdx, TOuterDimCount-1] followed by the unrolled inner dimensions.
+            //#############################################################################
+            template<
+                std::size_t TDimIdx,
+                std::size_t TOuterDimCount,
+                std::size_t... TInnerExtents>
+            struct NdLoopUnrolledOuter
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    typename TIndex,
+                    typename TExtentVec,
+                    typename TFnObj>
+                ALPAKA_FN_HOST_ACC static auto ndLoop(
+                    TIndex & idx,
+                    TExtentVec const & extent,
+                    TFnObj const & f)
+                -> void
+                {
+                    for(idx[TDimIdx] = 0u; idx[TDimIdx] < extent[TDimIdx]; ++idx[TDimIdx])
+                    {
+                        NdLoopUnrolledOuter<
+                            TDimIdx + 1u,
+                            TOuterDimCount,
+                            TInnerExtents...>
+                        ::template ndLoop(
+                            idx,
+                            extent,
+                            f);
+                    }
+                }
+            };
+            //#############################################################################
+            //! Runtime iteration of the outer dimensions [TDimIdx, TOuterDimCount-1] followed by the unrolled inner dimensions.
+            //#############################################################################
+            template<
+                std::size_t TOuterDimCount,
+                std::size_t... TInnerExtents>
+            struct NdLoopUnrolledOuter<
+                TOuterDimCount,
+                TOuterDimCount,
+                TInnerExtents...>
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    typename TIndex,
+                    typename TExtentVec,
+                    typename TFnObj>
+                ALPAKA_FN_HOST_ACC static auto ndLoop(
+                    TIndex & idx,
+                    TExtentVec const &,
+                    TFnObj const & f)
+                -> void
+                {
+                    NdLoopUnrolledDims<
+                        TOuterDimCount,
+                        TInnerExtents...>
+                    ::template ndLoop(
+                        idx,
+                        f);
+                }
+            };
+        }
+        //-----------------------------------------------------------------------------
+        //! Loops over an n-dimensional iteration index variable calling f(idx) for each iteration.
+        //! The loops are nested from index zero outmost to index (dim-1) innermost like in ndLoopIncIdx.
+        //! All dimensions are iterated by a single flat loop updating the index incrementally.
+        //! This avoids the nested loop overhead for small innermost extents.
+        //!
+        //! \param extent N-dimensional loop extent.
+        //! \param f The function called at each iteration.
+        //-----------------------------------------------------------------------------
+        ALPAKA_NO_HOST_ACC_WARNING
+        template<
+            typename TExtentVec,
+            typename TFnObj>
+        ALPAKA_FN_HOST_ACC auto ndLoopCollapsed(
+            TExtentVec const & extent,
+            TFnObj const & f)
+        -> void
+        {
+            static_assert(
+                dim::Dim<TExtentVec>::value > 0u,
+                "The dimension of the extent given to ndLoopCollapsed has to be larger than zero!");
+
+            auto idx(
+                Vec<dim::Dim<TExtentVec>, size::Size<TExtentVec>>::zeros());
+
+            auto const count(
+                detail::ndLoopOuterCount<dim::Dim<TExtentVec>::value>(extent));
+            for(size::Size<TExtentVec> i(0u); i < count; ++i)
+            {
+                f(idx);
+                detail::NdLoopIncIdxCarry<
+                    dim::Dim<TExtentVec>::value>
+                ::template incIdx(
+                    idx,
+                    extent);
+            }
+        }
+        //-----------------------------------------------------------------------------
+        //! Loops over the outer dimensions of an n-dimensional iteration index variable calling f(idx, innerExtent) for each iteration.
+        //! The component (dim-1) of idx is always zero.
+        //! The function has to iterate the contiguous innermost range [0, innerExtent) itself.
+        //! This lets the compiler vectorise the innermost loop.
+        //!
+        //! \param extent N-dimensional loop extent.
+        //! \param f The function called for each innermost range.
+        //-----------------------------------------------------------------------------
+        ALPAKA_NO_HOST_ACC_WARNING
+        template<
+            typename TExtentVec,
+            typename TFnObj>
+        ALPAKA_FN_HOST_ACC auto ndLoopContiguous(
+            TExtentVec const & extent,
+            TFnObj const & f)
+        -> void
+        {
+            static_assert(
+                dim::Dim<TExtentVec>::value > 0u,
+                "The dimension of the extent given to ndLoopContiguous has to be larger than zero!");
+
+            auto idx(
+                Vec<dim::Dim<TExtentVec>, size::Size<TExtentVec>>::zeros());
+
+            auto const innerExtent(extent[dim::Dim<TExtentVec>::value - 1u]);
+            if(innerExtent == 0u)
+            {
+                return;
+            }
+            auto const count(
+                detail::ndLoopOuterCount<dim::Dim<TExtentVec>::value - 1u>(extent));
+            for(size::Size<TExtentVec> i(0u); i < count; ++i)
+            {
+                f(idx, innerExtent);
+                detail::NdLoopIncIdxCarry<
+                    dim::Dim<TExtentVec>::value - 1u>
+                ::template incIdx(
+                    idx,
+                    extent);
+            }
+        }
+        //-----------------------------------------------------------------------------
+        //! Loops over an n-dimensional iteration index variable calling f(idx) for each iteration.
+        //! The loops are nested from index zero outmost to index (dim-1) innermost like in ndLoopIncIdx.
+        //! The innermost sizeof...(TInnerExtents) dimensions have the given compile-time extents and are fully unrolled.
+        //! The outer dimensions are iterated at runtime.
+        //!
+        //! \tparam TInnerExtents The extents of the innermost dimensions. They have to match the corresponding components of extent.
+        //! \param extent N-dimensional loop extent.
+        //! \param f The function called at each iteration.
+        //-----------------------------------------------------------------------------
+        ALPAKA_NO_HOST_ACC_WARNING
+        template<
+            std::size_t... TInnerExtents,
+            typename TExtentVec,
+            typename TFnObj>
+        ALPAKA_FN_HOST_ACC auto ndLoopUnrolled(
+            TExtentVec const & extent,
+            TFnObj const & f)
+        -> void
+        {
+            static_assert(
+                dim::Dim<TExtentVec>::value > 0u,
+                "The dimension of the extent given to ndLoopUnrolled has to be larger than zero!");
+            static_assert(
+                sizeof...(TInnerExtents) <= dim::Dim<TExtentVec>::value,
+                "ndLoopUnrolled can not be given more compile-time extents than the extent has dimensions!");
+
+            constexpr std::size_t outerDimCount(dim::Dim<TExtentVec>::value - sizeof...(TInnerExtents));
+
+#ifndef NDEBUG
+            std::size_t const innerExtents[] = {TInnerExtents..., 0u};
+            for(std::size_t dimIdx(outerDimCount); dimIdx < dim::Dim<TExtentVec>::value; ++dimIdx)
+            {
+                assert(static_cast<std::size_t>(extent[dimIdx]) == innerExtents[dimIdx - outerDimCount]);
+            }
+#endif
+
+            auto idx(
+                Vec<dim::Dim<TExtentVec>, size::Size<TExtentVec>>::zeros());
+
+            detail::NdLoopUnrolledOuter<
+                0u,
+                outerDimCount,
+                TInnerExtents...>
+            ::template ndLoop(
+                idx,
+                extent,
+                f);
+        }
     }
 }
@@ -0,0 +1,103 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <alpaka/core/Common.hpp>   // ALPAKA_FN_HOST
+
+#include <cstddef>                  // std::size_t
+#include <exception>                // std::exception_ptr
+#include <thread>                   // std::thread
+#include <vector>                   // std::vector
+
+namespace alpaka
+{
+    namespace core
+    {
+        //-----------------------------------------------------------------------------
+        //! Calls f(workerIdx) for each worker in [0, workerCount) in parallel and waits for all of them.
+        //!
+        //! The worker zero runs on the calling thread, the other ones on threads started for this call.
+        //! Workers whose thread can not be started run on the calling thread after the worker zero, so the workers must not wait for each other.
+        //! The started threads are always joined. The first exception thrown by a worker is rethrown after all workers finished.
+        //-----------------------------------------------------------------------------
+        template<
+            typename TFnObj>
+        ALPAKA_FN_HOST auto parallelFor(
+            std::size_t const & workerCount,
+            TFnObj const & f)
+        -> void
+        {
+            if(workerCount == 0u)
+            {
+                return;
+            }
+
+            std::vector<std::exception_ptr> exceptions(workerCount);
+            auto const execWorker(
+                [&f, &exceptions](std::size_t const workerIdx)
+                {
+                    try
+                    {
+                        f(workerIdx);
+                    }
+                    catch(...)
+                    {
+                        exceptions[workerIdx] = std::current_exception();
+                    }
+                });
+
+            std::vector<std::thread> threads;
+            std::size_t startedWorkerCount(1u);
+            try
+            {
+                threads.reserve(workerCount - 1u);
+                for(; startedWorkerCount < workerCount; ++startedWorkerCount)
+                {
+                    threads.emplace_back(execWorker, startedWorkerCount);
+                }
+            }
+            catch(...)
+            {
+                // The remaining workers are executed by the calling thread below.
+            }
+
+            execWorker(0u);
+            for(auto workerIdx(startedWorkerCount); workerIdx < workerCount; ++workerIdx)
+            {
+                execWorker(workerIdx);
+            }
+
+            for(auto & thread : threads)
+            {
+                thread.join();
+            }
+            for(auto const & exception : exceptions)
+            {
+                if(exception)
+                {
+                    std::rethrow_exception(exception);
+                }
+            }
+        }
+    }
+}
@@ -29,6 +29,9 @@
 
 #include <alpaka/stream/Traits.hpp>     // stream::enqueue
 #include <alpaka/dev/cpu/SysInfo.hpp>   // getCpuName, getTotalGlobalMemSizeBytes, getFreeGlobalMemSizeBytes
+#include <alpaka/dev/MemStats.hpp>      // dev::detail::MemStatsCounters
+#include <alpaka/dev/cpu/Affinity.hpp>  // ThreadAffinity
+#include <alpaka/dev/cpu/Partition.hpp> // DevPartition, getDevPartitions
 
 #include <boost/core/ignore_unused.hpp> // boost::ignore_unused
 
@@ -38,6 +41,7 @@
 #include <thread>                       // std::thread
 #include <mutex>                        // std::mutex
 #include <memory>                       // std::shared_ptr
+#include <vector>                       // std::vector
 
 namespace alpaka
 {
@@ -73,23 +77,28 @@ namespace alpaka
                     //-----------------------------------------------------------------------------
                     //! Constructor.
                     //-----------------------------------------------------------------------------
-                    ALPAKA_FN_HOST DevCpuImpl() = default;
+                    ALPAKA_FN_HOST DevCpuImpl(
+                        DevPartition const & partition) :
+                            m_partition(partition),
+                            m_threadAffinity(restrictThreadAffinity(getDefaultThreadAffinity(), partition)),
+                            m_streamCount(0u)
+                    {}
                     //-----------------------------------------------------------------------------
                     //! Copy constructor.
                     //-----------------------------------------------------------------------------
-                    ALPAKA_FN_HOST DevCpuImpl(DevCpuImpl const &) = default;
+                    ALPAKA_FN_HOST DevCpuImpl(DevCpuImpl const &) = delete;
                     //-----------------------------------------------------------------------------
                     //! Move constructor.
                     //-----------------------------------------------------------------------------
-                    ALPAKA_FN_HOST DevCpuImpl(DevCpuImpl &&) = default;
+                    ALPAKA_FN_HOST DevCpuImpl(DevCpuImpl &&) = delete;
                     //-----------------------------------------------------------------------------
                     //! Copy assignment operator.
                     //-----------------------------------------------------------------------------
-                    ALPAKA_FN_HOST auto operator=(DevCpuImpl const &) -> DevCpuImpl & = default;
+                    ALPAKA_FN_HOST auto operator=(DevCpuImpl const &) -> DevCpuImpl & = delete;
                     //-----------------------------------------------------------------------------
                     //! Move assignment operator.
                     //-----------------------------------------------------------------------------
-                    ALPAKA_FN_HOST auto operator=(DevCpuImpl &&) -> DevCpuImpl & = default;
+                    ALPAKA_FN_HOST auto operator=(DevCpuImpl &&) -> DevCpuImpl & = delete;
                     //-----------------------------------------------------------------------------
                     //! Destructor.
                     //-----------------------------------------------------------------------------
@@ -120,6 +129,55 @@ namespace alpaka
                         return vspStreams;
                     }
 
+                    //-----------------------------------------------------------------------------
+                    //! \return The thread affinity of the streams created on this device from now on.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto getThreadAffinity() const
+                    -> ThreadAffinity
+                    {
+                        std::lock_guard<std::mutex> lk(m_Mutex);
+                        return m_threadAffinity;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Sets the thread affinity of the streams created on this device from now on.
+                    //! It is restricted to the logical CPUs of the device.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto setThreadAffinity(
+                        ThreadAffinity const & threadAffinity)
+                    -> void
+                    {
+                        auto restrictedThreadAffinity(restrictThreadAffinity(threadAffinity, m_partition));
+
+                        std::lock_guard<std::mutex> lk(m_Mutex);
+                        m_threadAffinity = std::move(restrictedThreadAffinity);
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The logical CPUs and the memory node of this device.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto getPartition() const
+                    -> DevPartition const &
+                    {
+                        return m_partition;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The statistics counters of the buffers allocated on this device.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto getMemStatsCounters()
+                    -> dev::detail::MemStatsCounters &
+                    {
+                        return m_memStatsCounters;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The index of the next stream created on this device.
+                    //! It selects the logical CPU of the stream worker thread so that the workers of different streams are spread.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto getNextStreamIdx()
+                    -> std::size_t
+                    {
+                        std::lock_guard<std::mutex> lk(m_Mutex);
+                        return m_streamCount++;
+                    }
+
                 private:
                     //-----------------------------------------------------------------------------
                     //! Registers the given stream on this device.
@@ -164,7 +222,35 @@ namespace alpaka
                 private:
                     std::mutex mutable m_Mutex;
                     std::map<stream::cpu::detail::StreamCpuAsyncImpl *, std::weak_ptr<stream::cpu::detail::StreamCpuAsyncImpl>> m_mapStreams;
+                    DevPartition const m_partition;
+                    ThreadAffinity m_threadAffinity;
+                    std::size_t m_streamCount;
+                    dev::detail::MemStatsCounters m_memStatsCounters;
                 };
+
+                //#############################################################################
+                //! The implementations of the CPU devices of the current partitioning.
+                //!
+                //! All handles of a device share its implementation so that its settings and statistics are not lost.
+                //#############################################################################
+                struct DevCpuImplCache
+                {
+                    std::mutex m_mutex;
+                    std::size_t m_partitioningGeneration;
+                    std::vector<std::shared_ptr<DevCpuImpl>> m_spDevCpuImpls;
+                };
+                //-----------------------------------------------------------------------------
+                //! \return The implementations of the CPU devices.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getDevCpuImplCache()
+                -> DevCpuImplCache &
+                {
+                    static DevCpuImplCache cache{
+                        {},
+                        0u,
+                        {}};
+                    return cache;
+                }
             }
         }
 
@@ -178,8 +264,11 @@ namespace alpaka
             //-----------------------------------------------------------------------------
             //! Constructor.
             //-----------------------------------------------------------------------------
-            ALPAKA_FN_HOST DevCpu() :
-                m_spDevCpuImpl(std::make_shared<cpu::detail::DevCpuImpl>())
+            ALPAKA_FN_HOST DevCpu(
+                std::size_t const & devIdx,
+                std::shared_ptr<cpu::detail::DevCpuImpl> const & spDevCpuImpl) :
+                    m_spDevCpuImpl(spDevCpuImpl),
+                    m_devIdx(devIdx)
             {}
         public:
             //-----------------------------------------------------------------------------
@@ -204,11 +293,13 @@ namespace alpaka
             ALPAKA_FN_HOST ~DevCpu() = default;
             //-----------------------------------------------------------------------------
             //! Equality comparison operator.
+            //!
+            //! Devices of different partitionings are different even if they have the same index.
             //-----------------------------------------------------------------------------
-            ALPAKA_FN_HOST auto operator==(DevCpu const &) const
+            ALPAKA_FN_HOST auto operator==(DevCpu const & rhs) const
             -> bool
             {
-                return true;
+                return m_spDevCpuImpl == rhs.m_spDevCpuImpl;
             }
             //-----------------------------------------------------------------------------
             //! Inequality comparison operator.
@@ -221,6 +312,7 @@ namespace alpaka
 
         public:
             std::shared_ptr<cpu::detail::DevCpuImpl> m_spDevCpuImpl;
+            std::size_t m_devIdx;
         };
 
         //#############################################################################
@@ -242,7 +334,7 @@ namespace alpaka
             {
                 ALPAKA_DEBUG_FULL_LOG_SCOPE;
 
-                return 1;
+                return cpu::getDevPartitions().size();
             }
             //-----------------------------------------------------------------------------
             //! \return The number of devices available.
@@ -253,7 +345,10 @@ namespace alpaka
             {
                 ALPAKA_DEBUG_FULL_LOG_SCOPE;
 
-                std::size_t const devCount(getDevCount());
+                std::vector<cpu::DevPartition> partitions;
+                std::size_t partitioningGeneration(0u);
+                cpu::detail::getDevPartitionsAndGeneration(partitions, partitioningGeneration);
+                std::size_t const devCount(partitions.size());
                 if(devIdx >= devCount)
                 {
                     std::stringstream ssErr;
@@ -261,7 +356,22 @@ namespace alpaka
                     throw std::runtime_error(ssErr.str());
                 }
 
-                return {};
+                // The devices are created on first use and replaced when the partitioning changes.
+                auto & cache(cpu::detail::getDevCpuImplCache());
+                std::lock_guard<std::mutex> lk(cache.m_mutex);
+                if((cache.m_partitioningGeneration != partitioningGeneration) || (cache.m_spDevCpuImpls.size() != devCount))
+                {
+                    cache.m_spDevCpuImpls.clear();
+                    cache.m_spDevCpuImpls.resize(devCount);
+                    cache.m_partitioningGeneration = partitioningGeneration;
+                }
+                auto & spDevCpuImpl(cache.m_spDevCpuImpls[devIdx]);
+                if(!spDevCpuImpl)
+                {
+                    spDevCpuImpl = std::make_shared<cpu::detail::DevCpuImpl>(partitions[devIdx]);
+                }
+
+                return DevCpu(devIdx, spDevCpuImpl);
             }
         };
 
@@ -277,6 +387,35 @@ namespace alpaka
 
                 return DevManCpu::getDevByIdx(0);
             }
+            //-----------------------------------------------------------------------------
+            //! \return The logical CPUs and the memory node of the device.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getDevPartition(
+                DevCpu const & dev)
+            -> DevPartition
+            {
+                return dev.m_spDevCpuImpl->getPartition();
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The thread affinity of the streams created on the device.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getThreadAffinity(
+                DevCpu const & dev)
+            -> ThreadAffinity
+            {
+                return dev.m_spDevCpuImpl->getThreadAffinity();
+            }
+            //-----------------------------------------------------------------------------
+            //! Sets the thread affinity of the streams created on the device from now on.
+            //! The initial value is given by the ALPAKA_CPU_AFFINITY environment variable.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto setThreadAffinity(
+                DevCpu & dev,
+                ThreadAffinity const & threadAffinity)
+            -> void
+            {
+                dev.m_spDevCpuImpl->setThreadAffinity(threadAffinity);
+            }
         }
     }
 
@@ -359,7 +498,16 @@ namespace alpaka
                     dev::DevCpu const & dev)
                 -> std::size_t
                 {
-                    boost::ignore_unused(dev);
+                    // A device partitioned to a NUMA node owns the memory of this node.
+                    auto const & partition(dev.m_spDevCpuImpl->getPartition());
+                    if(!partition.m_cpus.empty() && (partition.m_numaNodeOsId != std::numeric_limits<std::size_t>::max()))
+                    {
+                        auto const nodeMemBytes(dev::cpu::detail::getNumaNodeMemInfoBytes(partition.m_numaNodeOsId, "MemTotal:"));
+                        if(nodeMemBytes != 0u)
+                        {
+                            return nodeMemBytes;
+                        }
+                    }
 
                     return dev::cpu::detail::getTotalGlobalMemSizeBytes();
                 }
@@ -379,12 +527,56 @@ namespace alpaka
                     dev::DevCpu const & dev)
                 -> std::size_t
                 {
-                    boost::ignore_unused(dev);
+                    auto const & partition(dev.m_spDevCpuImpl->getPartition());
+                    if(!partition.m_cpus.empty() && (partition.m_numaNodeOsId != std::numeric_limits<std::size_t>::max()))
+                    {
+                        auto const nodeFreeMemBytes(dev::cpu::detail::getNumaNodeMemInfoBytes(partition.m_numaNodeOsId, "MemFree:"));
+                        if(nodeFreeMemBytes != 0u)
+                        {
+                            return nodeFreeMemBytes;
+                        }
+                    }
 
                     return dev::cpu::detail::getFreeGlobalMemSizeBytes();
                 }
             };
 
+            //#############################################################################
+            //! The CPU device buffer memory statistics get trait specialization.
+            //#############################################################################
+            template<>
+            struct GetMemStats<
+                dev::DevCpu>
+            {
+                //-----------------------------------------------------------------------------
+                //
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto getMemStats(
+                    dev::DevCpu const & dev)
+                -> dev::MemStats
+                {
+                    return dev.m_spDevCpuImpl->getMemStatsCounters().get();
+                }
+            };
+
+            //#############################################################################
+            //! The CPU device buffer memory statistics reset trait specialization.
+            //#############################################################################
+            template<>
+            struct ResetMemStats<
+                dev::DevCpu>
+            {
+                //-----------------------------------------------------------------------------
+                //
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto resetMemStats(
+                    dev::DevCpu const & dev)
+                -> void
+                {
+                    dev.m_spDevCpuImpl->getMemStatsCounters().reset();
+                }
+            };
+
             //#############################################################################
             //! The CPU device reset trait specialization.
             //#############################################################################
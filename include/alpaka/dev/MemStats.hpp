@@ -0,0 +1,141 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/core/Common.hpp>       // ALPAKA_FN_HOST
+#include <alpaka/core/Histogram.hpp>    // core::Histogram, core::AtomicHistogram
+
+#include <atomic>                       // std::atomic
+#include <cstddef>                      // std::size_t
+
+namespace alpaka
+{
+    namespace dev
+    {
+        //#############################################################################
+        //! The memory statistics of the buffers allocated on a device.
+        //#############################################################################
+        struct MemStats
+        {
+            std::size_t m_liveBytes;                //!< The number of bytes held by the live buffers.
+            std::size_t m_liveBufCount;             //!< The number of live buffers.
+            std::size_t m_peakBytes;                //!< The maximum of the live bytes since the last reset.
+            std::size_t m_allocCount;               //!< The number of allocations since the last reset.
+            std::size_t m_freeCount;                //!< The number of frees since the last reset.
+            core::Histogram m_allocSizeHistogram;   //!< The allocation sizes in bytes since the last reset.
+        };
+
+        namespace detail
+        {
+            //#############################################################################
+            //! The thread safe memory statistics counters of a device.
+            //#############################################################################
+            class MemStatsCounters
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST MemStatsCounters() :
+                    m_liveBytes(0u),
+                    m_liveBufCount(0u),
+                    m_peakBytes(0u),
+                    m_allocCount(0u),
+                    m_freeCount(0u)
+                {}
+                //-----------------------------------------------------------------------------
+                //! Copy constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST MemStatsCounters(MemStatsCounters const &) = delete;
+                //-----------------------------------------------------------------------------
+                //! Copy assignment operator.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto operator=(MemStatsCounters const &) -> MemStatsCounters & = delete;
+
+                //-----------------------------------------------------------------------------
+                //! Records an allocation.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto onAlloc(
+                    std::size_t const & bytes)
+                -> void
+                {
+                    auto const liveBytes(m_liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+                    m_liveBufCount.fetch_add(1u, std::memory_order_relaxed);
+                    m_allocCount.fetch_add(1u, std::memory_order_relaxed);
+                    m_allocSizeHistogram.add(bytes);
+
+                    auto peakBytes(m_peakBytes.load(std::memory_order_relaxed));
+                    while((peakBytes < liveBytes)
+                        && !m_peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+                    {}
+                }
+                //-----------------------------------------------------------------------------
+                //! Records a free.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto onFree(
+                    std::size_t const & bytes)
+                -> void
+                {
+                    m_liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+                    m_liveBufCount.fetch_sub(1u, std::memory_order_relaxed);
+                    m_freeCount.fetch_add(1u, std::memory_order_relaxed);
+                }
+                //-----------------------------------------------------------------------------
+                //! \return A snapshot of the statistics.
+                //! The values are read one after the other so they are only consistent if no buffers are allocated or freed concurrently.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto get() const
+                -> MemStats
+                {
+                    MemStats stats;
+                    stats.m_liveBytes = m_liveBytes.load(std::memory_order_relaxed);
+                    stats.m_liveBufCount = m_liveBufCount.load(std::memory_order_relaxed);
+                    stats.m_peakBytes = m_peakBytes.load(std::memory_order_relaxed);
+                    stats.m_allocCount = m_allocCount.load(std::memory_order_relaxed);
+                    stats.m_freeCount = m_freeCount.load(std::memory_order_relaxed);
+                    stats.m_allocSizeHistogram = m_allocSizeHistogram.get();
+                    return stats;
+                }
+                //-----------------------------------------------------------------------------
+                //! Resets the peak to the current live bytes and clears the counts and the histogram.
+                //! The live bytes and buffers are not changed because they describe the buffers that still exist.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto reset()
+                -> void
+                {
+                    m_peakBytes.store(m_liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    m_allocCount.store(0u, std::memory_order_relaxed);
+                    m_freeCount.store(0u, std::memory_order_relaxed);
+                    m_allocSizeHistogram.reset();
+                }
+
+            private:
+                std::atomic<std::size_t> m_liveBytes;
+                std::atomic<std::size_t> m_liveBufCount;
+                std::atomic<std::size_t> m_peakBytes;
+                std::atomic<std::size_t> m_allocCount;
+                std::atomic<std::size_t> m_freeCount;
+                core::AtomicHistogram m_allocSizeHistogram;
+            };
+        }
+    }
+}
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <alpaka/dev/MemStats.hpp>      // dev::MemStats
+
 #include <alpaka/core/Common.hpp>       // ALPAKA_FN_HOST
 
 namespace alpaka
@@ -83,6 +85,22 @@ namespace alpaka
                 typename TSfinae = void>
             struct GetFreeMemBytes;
 
+            //#############################################################################
+            //! The device buffer memory statistics get trait.
+            //#############################################################################
+            template<
+                typename T,
+                typename TSfinae = void>
+            struct GetMemStats;
+
+            //#############################################################################
+            //! The device buffer memory statistics reset trait.
+            //#############################################################################
+            template<
+                typename T,
+                typename TSfinae = void>
+            struct ResetMemStats;
+
             //#############################################################################
             //! The device reset trait.
             //#############################################################################
@@ -189,6 +207,39 @@ namespace alpaka
                     dev);
         }
 
+        //-----------------------------------------------------------------------------
+        //! \return The statistics of the memory held by the buffers allocated on the device.
+        //! Other than getFreeMemBytes this only covers the memory allocated through alpaka buffers.
+        //-----------------------------------------------------------------------------
+        template<
+            typename TDev>
+        ALPAKA_FN_HOST auto getMemStats(
+            TDev const & dev)
+        -> MemStats
+        {
+            return
+                traits::GetMemStats<
+                    TDev>
+                ::getMemStats(
+                    dev);
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Resets the buffer memory statistics of the device.
+        //! The peak is reset to the currently held memory, the counts and the histogram are cleared.
+        //-----------------------------------------------------------------------------
+        template<
+            typename TDev>
+        ALPAKA_FN_HOST auto resetMemStats(
+            TDev const & dev)
+        -> void
+        {
+            traits::ResetMemStats<
+                TDev>
+            ::resetMemStats(
+                dev);
+        }
+
         //-----------------------------------------------------------------------------
         //! Resets the device.
         //! What this method does is dependent of the accelerator.
@@ -0,0 +1,492 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/dev/cpu/SysInfo.hpp>   // getCpuTopology, parseCpuList
+
+#include <alpaka/core/Common.hpp>       // ALPAKA_FN_HOST
+
+#include <boost/predef.h>               // BOOST_OS_LINUX, BOOST_OS_WINDOWS
+
+#if BOOST_OS_LINUX
+    #include <sched.h>                  // sched_setaffinity, sched_getaffinity, CPU_SET
+#endif
+
+#include <algorithm>                    // std::sort
+#include <cstdlib>                      // std::getenv
+#include <limits>                       // std::numeric_limits
+#include <stdexcept>                    // std::invalid_argument
+#include <string>                       // std::string
+#include <tuple>                        // std::make_tuple
+#include <vector>                       // std::vector
+
+namespace alpaka
+{
+    namespace dev
+    {
+        namespace cpu
+        {
+            //#############################################################################
+            //! The policies for pinning worker threads to logical CPUs.
+            //#############################################################################
+            enum class AffinityPolicy
+            {
+                None,           //!< Threads are not pinned.
+                Compact,        //!< Consecutive workers use neighbouring logical CPUs, filling SMT siblings, cores and sockets in this order.
+                Scatter,        //!< Consecutive workers are spread over sockets first, then over cores and SMT siblings last.
+                PhysicalCores,  //!< One worker per physical core in compact order. SMT siblings are not used.
+                List,           //!< Workers use the given logical CPUs in the given order.
+            };
+
+            //#############################################################################
+            //! A thread affinity.
+            //!
+            //! Maps the index of a worker thread (a pool thread or an OpenMP thread number) to a logical CPU.
+            //! Worker indices larger than the number of CPUs wrap around.
+            //#############################################################################
+            class ThreadAffinity
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //!
+                //! \param policy The policy.
+                //! \param cpus The ids of the logical CPUs for AffinityPolicy::List. Ignored by the other policies.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST ThreadAffinity(
+                    AffinityPolicy policy = AffinityPolicy::None,
+                    std::vector<std::size_t> const & cpus = std::vector<std::size_t>()) :
+                        m_policy(policy),
+                        m_cpus(policy == AffinityPolicy::List ? cpus : getCpuOrder(policy))
+                {}
+
+                //-----------------------------------------------------------------------------
+                //! \return The policy.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getPolicy() const
+                -> AffinityPolicy
+                {
+                    return m_policy;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The logical CPUs in the order they are assigned to workers.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getCpus() const
+                -> std::vector<std::size_t> const &
+                {
+                    return m_cpus;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return If threads are pinned.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto isEnabled() const
+                -> bool
+                {
+                    return !m_cpus.empty();
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The logical CPU of the given worker. Only valid if isEnabled().
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getCpu(
+                    std::size_t const workerIdx) const
+                -> std::size_t
+                {
+                    return m_cpus[workerIdx % m_cpus.size()];
+                }
+
+            private:
+                //-----------------------------------------------------------------------------
+                //! \return The logical CPUs ordered for the given policy.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto getCpuOrder(
+                    AffinityPolicy policy)
+                -> std::vector<std::size_t>
+                {
+                    if(policy == AffinityPolicy::None)
+                    {
+                        return std::vector<std::size_t>();
+                    }
+
+                    auto const & topology(detail::getCpuTopology());
+
+                    // The rank of each logical CPU among its SMT siblings and the rank of its core within its socket.
+                    struct CpuRank
+                    {
+                        std::size_t m_id;
+                        std::size_t m_socket;
+                        std::size_t m_core;
+                        std::size_t m_smtRank;
+                        std::size_t m_coreRank;
+                    };
+                    std::vector<CpuRank> ranks;
+                    for(auto const & logicalCpu : topology.m_logicalCpus)
+                    {
+                        CpuRank rank{logicalCpu.m_id, logicalCpu.m_socketId, logicalCpu.m_coreId, 0u, 0u};
+                        std::vector<std::size_t> socketCores;
+                        for(auto const & other : topology.m_logicalCpus)
+                        {
+                            if((other.m_coreId == logicalCpu.m_coreId) && (other.m_id < logicalCpu.m_id))
+                            {
+                                ++rank.m_smtRank;
+                            }
+                            if((other.m_socketId == logicalCpu.m_socketId)
+                                && (other.m_coreId < logicalCpu.m_coreId)
+                                && (std::find(socketCores.begin(), socketCores.end(), other.m_coreId) == socketCores.end()))
+                            {
+                                socketCores.push_back(other.m_coreId);
+                            }
+                        }
+                        rank.m_coreRank = socketCores.size();
+                        ranks.push_back(rank);
+                    }
+
+                    if(policy == AffinityPolicy::PhysicalCores)
+                    {
+                        ranks.erase(
+                            std::remove_if(
+                                ranks.begin(),
+                                ranks.end(),
+                                [](CpuRank const & rank){return rank.m_smtRank != 0u;}),
+                            ranks.end());
+                    }
+                    std::sort(
+                        ranks.begin(),
+                        ranks.end(),
+                        [policy](CpuRank const & a, CpuRank const & b)
+                        {
+                            return
+                                (policy == AffinityPolicy::Scatter)
+                                ? std::make_tuple(a.m_smtRank, a.m_coreRank, a.m_socket, a.m_id) < std::make_tuple(b.m_smtRank, b.m_coreRank, b.m_socket, b.m_id)
+                                : std::make_tuple(a.m_socket, a.m_coreRank, a.m_smtRank, a.m_id) < std::make_tuple(b.m_socket, b.m_coreRank, b.m_smtRank, b.m_id);
+                        });
+
+                    std::vector<std::size_t> cpus;
+                    for(auto const & rank : ranks)
+                    {
+                        cpus.push_back(rank.m_id);
+                    }
+                    return cpus;
+                }
+
+                AffinityPolicy m_policy;
+                std::vector<std::size_t> m_cpus;
+            };
+
+            //-----------------------------------------------------------------------------
+            //! \param str
+            //!     "none", "compact", "scatter", "cores" (AffinityPolicy::PhysicalCores)
+            //!     or a list of logical CPUs like "0-3,8" (AffinityPolicy::List).
+            //! \return The thread affinity described by the given string.
+            //! \throws std::invalid_argument if the string is not a valid description.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto parseThreadAffinity(
+                std::string const & str)
+            -> ThreadAffinity
+            {
+                if(str.empty() || (str == "none"))
+                {
+                    return ThreadAffinity(AffinityPolicy::None);
+                }
+                else if(str == "compact")
+                {
+                    return ThreadAffinity(AffinityPolicy::Compact);
+                }
+                else if(str == "scatter")
+                {
+                    return ThreadAffinity(AffinityPolicy::Scatter);
+                }
+                else if(str == "cores")
+                {
+                    return ThreadAffinity(AffinityPolicy::PhysicalCores);
+                }
+                else if(str.find_first_not_of("0123456789,-") == std::string::npos)
+                {
+                    auto const cpus(detail::parseCpuList(str));
+                    if(!cpus.empty())
+                    {
+                        return ThreadAffinity(AffinityPolicy::List, cpus);
+                    }
+                }
+                throw std::invalid_argument("'" + str + "' is not a valid thread affinity!");
+            }
+
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! The environment variable holding the default thread affinity in the format of parseThreadAffinity.
+                //-----------------------------------------------------------------------------
+                static constexpr char const * threadAffinityEnvVar = "ALPAKA_CPU_AFFINITY";
+
+                //-----------------------------------------------------------------------------
+                //! \return The thread affinity given by the ALPAKA_CPU_AFFINITY environment variable.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getDefaultThreadAffinity()
+                -> ThreadAffinity const &
+                {
+                    static ThreadAffinity const threadAffinity(
+                        [](){
+                            auto const * const str(std::getenv(threadAffinityEnvVar));
+                            return parseThreadAffinity(str ? std::string(str) : std::string());
+                        }());
+                    return threadAffinity;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The pointer to the thread affinity set for the current thread or nullptr.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getCurrentThreadAffinityPtr()
+                -> ThreadAffinity const * &
+                {
+                    static thread_local ThreadAffinity const * pThreadAffinity(nullptr);
+                    return pThreadAffinity;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The thread affinity for the workers started by executors on the current thread.
+                //! Streams set it to their affinity while executing tasks. Otherwise it is the default thread affinity.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getCurrentThreadAffinity()
+                -> ThreadAffinity const &
+                {
+                    auto const * const pThreadAffinity(getCurrentThreadAffinityPtr());
+                    return pThreadAffinity ? *pThreadAffinity : getDefaultThreadAffinity();
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The logical CPU the current thread has been pinned to by pinCurrentThread.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getCurrentThreadPinnedCpu()
+                -> std::size_t &
+                {
+                    static thread_local std::size_t pinnedCpu(std::numeric_limits<std::size_t>::max());
+                    return pinnedCpu;
+                }
+#if BOOST_OS_LINUX
+                //-----------------------------------------------------------------------------
+                //! \return The affinity mask the current thread had before it has been pinned by pinCurrentThread.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getCurrentThreadUnpinnedCpuSet()
+                -> cpu_set_t &
+                {
+                    static thread_local cpu_set_t cpuSet;
+                    return cpuSet;
+                }
+#elif BOOST_OS_WINDOWS
+                //-----------------------------------------------------------------------------
+                //! \return The affinity mask the current thread had before it has been pinned by pinCurrentThread.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getCurrentThreadUnpinnedMask()
+                -> DWORD_PTR &
+                {
+                    static thread_local DWORD_PTR mask(0u);
+                    return mask;
+                }
+#endif
+
+                //-----------------------------------------------------------------------------
+                //! Pins the current thread to the logical CPU of the given worker.
+                //!
+                //! Pinning is a hint. If it is not supported or fails, for example because the CPU is not available to the process, nothing happens.
+                //! The affinity mask of the thread before it is pinned the first time is saved and restored by unpinCurrentThread.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto pinCurrentThread(
+                    ThreadAffinity const & threadAffinity,
+                    std::size_t const workerIdx)
+                -> void
+                {
+                    if(!threadAffinity.isEnabled())
+                    {
+                        return;
+                    }
+                    auto const cpu(threadAffinity.getCpu(workerIdx));
+                    auto & pinnedCpu(getCurrentThreadPinnedCpu());
+                    if(pinnedCpu == cpu)
+                    {
+                        return;
+                    }
+#if BOOST_OS_LINUX
+                    if(cpu >= static_cast<std::size_t>(CPU_SETSIZE))
+                    {
+                        return;
+                    }
+                    if((pinnedCpu == std::numeric_limits<std::size_t>::max())
+                        && (sched_getaffinity(0, sizeof(cpu_set_t), &getCurrentThreadUnpinnedCpuSet()) != 0))
+                    {
+                        return;
+                    }
+                    cpu_set_t cpuSet;
+                    CPU_ZERO(&cpuSet);
+                    CPU_SET(cpu, &cpuSet);
+                    // The pid 0 denotes the calling thread.
+                    if(sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+                    {
+                        pinnedCpu = cpu;
+                    }
+#elif BOOST_OS_WINDOWS
+                    if(cpu >= sizeof(DWORD_PTR) * 8u)
+                    {
+                        return;
+                    }
+                    // The previous mask is returned when setting a new one.
+                    auto const previousMask(SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1u) << cpu));
+                    if(previousMask != 0)
+                    {
+                        if(pinnedCpu == std::numeric_limits<std::size_t>::max())
+                        {
+                            getCurrentThreadUnpinnedMask() = previousMask;
+                        }
+                        pinnedCpu = cpu;
+                    }
+#endif
+                }
+                //-----------------------------------------------------------------------------
+                //! Restores the affinity mask the current thread had before it has been pinned by pinCurrentThread.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto unpinCurrentThread()
+                -> void
+                {
+                    auto & pinnedCpu(getCurrentThreadPinnedCpu());
+                    if(pinnedCpu == std::numeric_limits<std::size_t>::max())
+                    {
+                        return;
+                    }
+#if BOOST_OS_LINUX
+                    sched_setaffinity(0, sizeof(cpu_set_t), &getCurrentThreadUnpinnedCpuSet());
+#elif BOOST_OS_WINDOWS
+                    SetThreadAffinityMask(GetCurrentThread(), getCurrentThreadUnpinnedMask());
+#endif
+                    pinnedCpu = std::numeric_limits<std::size_t>::max();
+                }
+
+                //#############################################################################
+                //! Sets the affinity used by the executors started on the current thread for the lifetime of this object.
+                //! The given affinity is referenced and has to outlive this object.
+                //#############################################################################
+                class ScopedThreadAffinity final
+                {
+                public:
+                    //-----------------------------------------------------------------------------
+                    //! Constructor.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST ScopedThreadAffinity(
+                        ThreadAffinity const & threadAffinity) :
+                            m_pPrevious(getCurrentThreadAffinityPtr())
+                    {
+                        getCurrentThreadAffinityPtr() = &threadAffinity;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Copy constructor.
+                    //-----------------------------------------------------------------------------
+                    ScopedThreadAffinity(ScopedThreadAffinity const &) = delete;
+                    //-----------------------------------------------------------------------------
+                    //! Copy assignment operator.
+                    //-----------------------------------------------------------------------------
+                    auto operator=(ScopedThreadAffinity const &) -> ScopedThreadAffinity & = delete;
+                    //-----------------------------------------------------------------------------
+                    //! Destructor.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST ~ScopedThreadAffinity()
+                    {
+                        getCurrentThreadAffinityPtr() = m_pPrevious;
+                    }
+
+                private:
+                    ThreadAffinity const * m_pPrevious;
+                };
+
+                //#############################################################################
+                //! Pins the current thread to the logical CPU of the given worker for the lifetime of this object.
+                //!
+                //! This is used for threads not owned by alpaka, for example the thread executing a kernel that is also the OpenMP master thread and the OpenMP worker threads.
+                //! Their previous affinity is restored on destruction.
+                //#############################################################################
+                class ScopedThreadPin final
+                {
+                public:
+                    //-----------------------------------------------------------------------------
+                    //! Constructor.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST ScopedThreadPin(
+                        ThreadAffinity const & threadAffinity,
+                        std::size_t const workerIdx) :
+                            m_bRestore(false),
+                            m_previousPinnedCpu(getCurrentThreadPinnedCpu())
+                    {
+                        // A thread already pinned to the logical CPU of the worker keeps its affinity.
+                        if((!threadAffinity.isEnabled()) || (m_previousPinnedCpu == threadAffinity.getCpu(workerIdx)))
+                        {
+                            return;
+                        }
+#if BOOST_OS_LINUX
+                        m_bRestore = (sched_getaffinity(0, sizeof(m_previousCpuSet), &m_previousCpuSet) == 0);
+#elif BOOST_OS_WINDOWS
+                        // The previous mask is returned when setting a new one.
+                        m_previousMask = SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(-1));
+                        m_bRestore = (m_previousMask != 0);
+#endif
+                        if(m_bRestore)
+                        {
+                            pinCurrentThread(threadAffinity, workerIdx);
+#if BOOST_OS_WINDOWS
+                            // pinCurrentThread has seen the temporary mask set above.
+                            if(m_previousPinnedCpu == std::numeric_limits<std::size_t>::max())
+                            {
+                                getCurrentThreadUnpinnedMask() = m_previousMask;
+                            }
+#endif
+                        }
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Copy constructor.
+                    //-----------------------------------------------------------------------------
+                    ScopedThreadPin(ScopedThreadPin const &) = delete;
+                    //-----------------------------------------------------------------------------
+                    //! Copy assignment operator.
+                    //-----------------------------------------------------------------------------
+                    auto operator=(ScopedThreadPin const &) -> ScopedThreadPin & = delete;
+                    //-----------------------------------------------------------------------------
+                    //! Destructor.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST ~ScopedThreadPin()
+                    {
+                        if(!m_bRestore)
+                        {
+                            return;
+                        }
+#if BOOST_OS_LINUX
+                        sched_setaffinity(0, sizeof(m_previousCpuSet), &m_previousCpuSet);
+#elif BOOST_OS_WINDOWS
+                        SetThreadAffinityMask(GetCurrentThread(), m_previousMask);
+#endif
+                        getCurrentThreadPinnedCpu() = m_previousPinnedCpu;
+                    }
+
+                private:
+                    bool m_bRestore;
+                    std::size_t m_previousPinnedCpu;
+#if BOOST_OS_LINUX
+                    cpu_set_t m_previousCpuSet;
+#elif BOOST_OS_WINDOWS
+                    DWORD_PTR m_previousMask;
+#endif
+                };
+            }
+        }
+    }
+}
@@ -0,0 +1,53 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/dev/MemStats.hpp>      // dev::detail::MemStatsCounters
+
+#include <alpaka/core/Common.hpp>       // ALPAKA_FN_HOST
+
+namespace alpaka
+{
+    namespace dev
+    {
+        namespace cpu
+        {
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! \return The buffer memory statistics counters of the given CPU device.
+                //! Each CPU device partition has its own counters shared by all handles of the device.
+                //!
+                //! This is a template so that it can be used by buffers only having a declaration of DevCpu.
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TDev>
+                ALPAKA_FN_HOST auto getMemStatsCounters(
+                    TDev const & dev)
+                -> dev::detail::MemStatsCounters &
+                {
+                    return dev.m_spDevCpuImpl->getMemStatsCounters();
+                }
+            }
+        }
+    }
+}
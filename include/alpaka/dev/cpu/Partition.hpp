@@ -0,0 +1,262 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <alpaka/dev/cpu/SysInfo.hpp>   // getCpuTopology, parseCpuList
+#include <alpaka/dev/cpu/Affinity.hpp>  // ThreadAffinity
+
+#include <alpaka/core/Common.hpp>       // ALPAKA_FN_HOST
+
+#include <algorithm>                    // std::find, std::all_of, std::none_of
+#include <cstdlib>                      // std::getenv
+#include <limits>                       // std::numeric_limits
+#include <mutex>                        // std::mutex
+#include <stdexcept>                    // std::invalid_argument
+#include <string>                       // std::string, std::to_string
+#include <utility>                      // std::move
+#include <vector>                       // std::vector
+
+namespace alpaka
+{
+    namespace dev
+    {
+        namespace cpu
+        {
+            //#############################################################################
+            //! The logical CPUs and the memory node of a CPU device.
+            //#############################################################################
+            struct DevPartition
+            {
+                std::vector<std::size_t> m_cpus;    //!< The ids of the logical CPUs. Empty if the device uses all of them.
+                std::size_t m_numaNodeOsId;         //!< The id the operating system uses for the NUMA node all the CPUs belong to.
+                                                    //!< std::numeric_limits<std::size_t>::max() if they span multiple nodes.
+            };
+
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! The environment variable holding the default partitioning in the format of setDevPartitioning.
+                //-----------------------------------------------------------------------------
+                static constexpr char const * devPartitionEnvVar = "ALPAKA_CPU_DEV_PARTITION";
+
+                //-----------------------------------------------------------------------------
+                //! \return The partition consisting of the given logical CPUs.
+                //! \throws std::invalid_argument if one of the CPUs is not online.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto makeDevPartition(
+                    std::vector<std::size_t> const & cpus)
+                -> DevPartition
+                {
+                    auto const & topology(getCpuTopology());
+
+                    DevPartition partition{cpus, std::numeric_limits<std::size_t>::max()};
+                    for(std::size_t nodeIdx(0u); nodeIdx < topology.m_numaNodeCount; ++nodeIdx)
+                    {
+                        auto const & nodeCpus(topology.m_numaNodeCpus[nodeIdx]);
+                        if(std::all_of(
+                            cpus.begin(),
+                            cpus.end(),
+                            [&nodeCpus](std::size_t const cpu){return std::find(nodeCpus.begin(), nodeCpus.end(), cpu) != nodeCpus.end();}))
+                        {
+                            partition.m_numaNodeOsId = topology.m_numaNodeOsIds[nodeIdx];
+                            return partition;
+                        }
+                    }
+                    for(auto const & cpu : cpus)
+                    {
+                        if(std::none_of(
+                            topology.m_logicalCpus.begin(),
+                            topology.m_logicalCpus.end(),
+                            [cpu](CpuLogical const & logicalCpu){return logicalCpu.m_id == cpu;}))
+                        {
+                            throw std::invalid_argument("The logical CPU " + std::to_string(cpu) + " of a CPU device partition is not online!");
+                        }
+                    }
+                    return partition;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The partitions described by the given string in the format of setDevPartitioning.
+                //! \throws std::invalid_argument if the string is not a valid description.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto parseDevPartitions(
+                    std::string const & str)
+                -> std::vector<DevPartition>
+                {
+                    auto const & topology(getCpuTopology());
+
+                    std::vector<DevPartition> partitions;
+                    if(str.empty() || (str == "none"))
+                    {
+                        partitions.push_back(
+                            DevPartition{
+                                std::vector<std::size_t>(),
+                                (topology.m_numaNodeCount == 1u) ? topology.m_numaNodeOsIds.front() : std::numeric_limits<std::size_t>::max()});
+                    }
+                    else if(str == "numa")
+                    {
+                        for(std::size_t nodeIdx(0u); nodeIdx < topology.m_numaNodeCount; ++nodeIdx)
+                        {
+                            partitions.push_back(DevPartition{topology.m_numaNodeCpus[nodeIdx], topology.m_numaNodeOsIds[nodeIdx]});
+                        }
+                    }
+                    else if(str.find_first_not_of("0123456789,-;") == std::string::npos)
+                    {
+                        std::string::size_type begin(0u);
+                        while(begin <= str.size())
+                        {
+                            auto const end(std::min(str.find(';', begin), str.size()));
+                            std::vector<std::size_t> cpus;
+                            try
+                            {
+                                cpus = parseCpuList(str.substr(begin, end - begin));
+                            }
+                            catch(std::logic_error const &)
+                            {
+                                // std::stoul failed.
+                                throw std::invalid_argument("'" + str + "' is not a valid CPU device partitioning!");
+                            }
+                            if(cpus.empty())
+                            {
+                                throw std::invalid_argument("'" + str + "' contains an empty CPU device partition!");
+                            }
+                            partitions.push_back(makeDevPartition(cpus));
+                            begin = end + 1u;
+                        }
+                    }
+                    else
+                    {
+                        throw std::invalid_argument("'" + str + "' is not a valid CPU device partitioning!");
+                    }
+                    return partitions;
+                }
+
+                //#############################################################################
+                //! The partitioning of the logical CPUs into CPU devices.
+                //#############################################################################
+                struct DevPartitioning
+                {
+                    std::mutex m_mutex;
+                    std::vector<DevPartition> m_partitions;
+                    std::size_t m_generation;               //!< Incremented on each change of the partitioning.
+                };
+                //-----------------------------------------------------------------------------
+                //! \return The partitioning. It is initialized from the ALPAKA_CPU_DEV_PARTITION environment variable.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getDevPartitioning()
+                -> DevPartitioning &
+                {
+                    static DevPartitioning partitioning{
+                        {},
+                        [](){
+                            auto const * const str(std::getenv(devPartitionEnvVar));
+                            return parseDevPartitions(str ? std::string(str) : std::string());
+                        }(),
+                        0u};
+                    return partitioning;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! \return The thread affinity restricted to the logical CPUs of the partition.
+                //! Workers of a partitioned device are always pinned. Without a policy the partition is filled compactly.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto restrictThreadAffinity(
+                    ThreadAffinity const & threadAffinity,
+                    DevPartition const & partition)
+                -> ThreadAffinity
+                {
+                    if(partition.m_cpus.empty())
+                    {
+                        return threadAffinity;
+                    }
+
+                    auto const orderedCpus(
+                        threadAffinity.isEnabled()
+                        ? threadAffinity.getCpus()
+                        : ThreadAffinity(AffinityPolicy::Compact).getCpus());
+                    std::vector<std::size_t> cpus;
+                    for(auto const & cpu : orderedCpus)
+                    {
+                        if(std::find(partition.m_cpus.begin(), partition.m_cpus.end(), cpu) != partition.m_cpus.end())
+                        {
+                            cpus.push_back(cpu);
+                        }
+                    }
+                    return ThreadAffinity(AffinityPolicy::List, cpus.empty() ? partition.m_cpus : cpus);
+                }
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Sets how the logical CPUs are partitioned into CPU devices.
+            //!
+            //! Each partition is a separate device of DevManCpu with its own pinned worker threads.
+            //! Buffers allocated on a device whose CPUs belong to a single NUMA node are placed on the memory of this node.
+            //! Device handles that already exist keep their partition and are not equal to the devices of the new partitioning.
+            //!
+            //! \param str
+            //!     "none" for a single device using all CPUs (the default),
+            //!     "numa" for a device per NUMA node
+            //!     or a ';' separated list of CPU lists like "0-7;8-15".
+            //!     The initial value is given by the ALPAKA_CPU_DEV_PARTITION environment variable.
+            //! \throws std::invalid_argument if the string is not a valid description.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto setDevPartitioning(
+                std::string const & str)
+            -> void
+            {
+                auto partitions(detail::parseDevPartitions(str));
+
+                auto & partitioning(detail::getDevPartitioning());
+                std::lock_guard<std::mutex> lk(partitioning.m_mutex);
+                partitioning.m_partitions = std::move(partitions);
+                ++partitioning.m_generation;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The partitions of the CPU devices in the order of their indices.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getDevPartitions()
+            -> std::vector<DevPartition>
+            {
+                auto & partitioning(detail::getDevPartitioning());
+                std::lock_guard<std::mutex> lk(partitioning.m_mutex);
+                return partitioning.m_partitions;
+            }
+
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! Gets the partitions of the CPU devices together with the generation of the partitioning they belong to.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getDevPartitionsAndGeneration(
+                    std::vector<DevPartition> & partitions,
+                    std::size_t & generation)
+                -> void
+                {
+                    auto & partitioning(getDevPartitioning());
+                    std::lock_guard<std::mutex> lk(partitioning.m_mutex);
+                    partitions = partitioning.m_partitions;
+                    generation = partitioning.m_generation;
+                }
+            }
+        }
+    }
+}
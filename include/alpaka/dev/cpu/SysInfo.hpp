@@ -22,6 +22,7 @@
 #pragma once
 
 #include <boost/predef.h>   // BOOST_XXX
+#include <boost/core/ignore_unused.hpp> // boost::ignore_unused
 
 #if BOOST_OS_WINDOWS || BOOST_OS_CYGWIN
     #ifndef NOMINMAX
@@ -46,8 +47,13 @@
     #include <fstream>
 #endif
 
+#include <algorithm>        // std::find, std::any_of
 #include <cstring>          // std::memcpy
+#include <sstream>          // std::istringstream
 #include <string>           // std::string
+#include <thread>           // std::thread::hardware_concurrency
+#include <utility>          // std::pair
+#include <vector>           // std::vector
 
 namespace alpaka
 {
@@ -240,7 +246,480 @@ namespace alpaka
     #error "getFreeGlobalMemSizeBytes not implemented for this system!"
 #endif
                 }
+                //-----------------------------------------------------------------------------
+                //! \param numaNodeOsId The id the operating system uses for the NUMA node.
+                //! \param key The meminfo entry like "MemTotal:" or "MemFree:".
+                //! \return The number of bytes of the given meminfo entry of the NUMA node or 0 if it can not be determined.
+                //-----------------------------------------------------------------------------
+                inline auto getNumaNodeMemInfoBytes(
+                    std::size_t const numaNodeOsId,
+                    std::string const & key)
+                -> std::size_t
+                {
+#if BOOST_OS_LINUX
+                    // The lines have the format "Node 0 MemTotal:       16314200 kB".
+                    std::ifstream file("/sys/devices/system/node/node" + std::to_string(numaNodeOsId) + "/meminfo");
+                    std::string token;
+                    while(file >> token)
+                    {
+                        if(token == key)
+                        {
+                            std::size_t sizeKiB(0u);
+                            if(file >> sizeKiB)
+                            {
+                                return sizeKiB * 1024u;
+                            }
+                            return 0u;
+                        }
+                    }
+#else
+                    boost::ignore_unused(numaNodeOsId, key);
+#endif
+                    return 0u;
+                }
+                //#############################################################################
+                //! The type of a CPU cache.
+                //#############################################################################
+                enum class CpuCacheType
+                {
+                    Data,
+                    Instruction,
+                    Unified,
+                };
+
+                //#############################################################################
+                //! A CPU cache instance.
+                //#############################################################################
+                struct CpuCache
+                {
+                    std::size_t m_level;                    //!< The cache level starting with 1.
+                    CpuCacheType m_type;                    //!< The type of the cached content.
+                    std::size_t m_sizeBytes;                //!< The size of the cache.
+                    std::size_t m_lineSizeBytes;            //!< The size of a cache line.
+                    std::vector<std::size_t> m_sharedCpus;  //!< The ids of the logical CPUs sharing this cache instance.
+                };
+
+                //#############################################################################
+                //! A logical CPU (hardware thread).
+                //#############################################################################
+                struct CpuLogical
+                {
+                    std::size_t m_id;           //!< The id the operating system uses for this logical CPU.
+                    std::size_t m_socketId;     //!< The index of the socket (package) in [0, m_socketCount).
+                    std::size_t m_coreId;       //!< The index of the physical core in [0, m_physicalCoreCount).
+                    std::size_t m_numaNodeId;   //!< The index of the NUMA node in [0, m_numaNodeCount).
+                };
+
+                //#############################################################################
+                //! The topology of the CPUs of the system.
+                //#############################################################################
+                struct CpuTopology
+                {
+                    std::vector<CpuLogical> m_logicalCpus;              //!< The online logical CPUs ordered by id.
+                    std::size_t m_socketCount;                          //!< The number of sockets (packages).
+                    std::size_t m_physicalCoreCount;                    //!< The number of physical cores.
+                    std::size_t m_numaNodeCount;                        //!< The number of NUMA nodes.
+                    std::vector<std::vector<std::size_t>> m_numaNodeCpus;//!< The ids of the logical CPUs of each NUMA node.
+                    std::vector<std::size_t> m_numaNodeOsIds;           //!< The id the operating system uses for each NUMA node.
+                    std::vector<CpuCache> m_caches;                     //!< All cache instances.
+                };
+
+                //-----------------------------------------------------------------------------
+                //! \return The ids in a CPU list like "0-3,8,10-11".
+                //-----------------------------------------------------------------------------
+                inline auto parseCpuList(
+                    std::string const & cpuList)
+                -> std::vector<std::size_t>
+                {
+                    std::vector<std::size_t> cpus;
+                    std::istringstream iss(cpuList);
+                    std::string range;
+                    while(std::getline(iss, range, ','))
+                    {
+                        if(range.find_first_of("0123456789") == std::string::npos)
+                        {
+                            continue;
+                        }
+                        auto const dash(range.find('-'));
+                        auto const first(static_cast<std::size_t>(std::stoul(range.substr(0u, dash))));
+                        auto const last(dash == std::string::npos ? first : static_cast<std::size_t>(std::stoul(range.substr(dash + 1u))));
+                        for(auto cpu(first); cpu <= last; ++cpu)
+                        {
+                            cpus.push_back(cpu);
+                        }
+                    }
+                    return cpus;
+                }
+
+#if BOOST_OS_LINUX
+                //-----------------------------------------------------------------------------
+                //! \return The first line of the given file or an empty string if it can not be read.
+                //-----------------------------------------------------------------------------
+                inline auto readSysFsLine(
+                    std::string const & path)
+                -> std::string
+                {
+                    std::ifstream file(path);
+                    std::string line;
+                    std::getline(file, line);
+                    return line;
+                }
+                //-----------------------------------------------------------------------------
+                //! Reads the topology from /sys/devices/system/cpu and /sys/devices/system/node.
+                //!
+                //! \return If the topology could be read.
+                //-----------------------------------------------------------------------------
+                inline auto readCpuTopologySysFs(
+                    CpuTopology & topology)
+                -> bool
+                {
+                    std::string const cpuPath("/sys/devices/system/cpu/");
+                    auto const cpuIds(parseCpuList(readSysFsLine(cpuPath + "online")));
+                    if(cpuIds.empty())
+                    {
+                        return false;
+                    }
+
+                    std::vector<std::size_t> socketIds;
+                    std::vector<std::pair<std::size_t, std::size_t>> coreIds;
+                    for(auto const & cpuId : cpuIds)
+                    {
+                        auto const cpuDir(cpuPath + "cpu" + std::to_string(cpuId) + "/");
+                        auto const socketLine(readSysFsLine(cpuDir + "topology/physical_package_id"));
+                        auto const coreLine(readSysFsLine(cpuDir + "topology/core_id"));
+                        // The package id is -1 on some virtual machines.
+                        auto const socket(socketLine.empty() || socketLine[0] == '-' ? 0u : static_cast<std::size_t>(std::stoul(socketLine)));
+                        auto const core(std::make_pair(socket, coreLine.empty() ? cpuId : static_cast<std::size_t>(std::stoul(coreLine))));
+
+                        auto socketIt(std::find(socketIds.begin(), socketIds.end(), socket));
+                        if(socketIt == socketIds.end())
+                        {
+                            socketIt = socketIds.insert(socketIds.end(), socket);
+                        }
+                        auto coreIt(std::find(coreIds.begin(), coreIds.end(), core));
+                        if(coreIt == coreIds.end())
+                        {
+                            coreIt = coreIds.insert(coreIds.end(), core);
+                        }
+                        topology.m_logicalCpus.push_back(
+                            CpuLogical{
+                                cpuId,
+                                static_cast<std::size_t>(socketIt - socketIds.begin()),
+                                static_cast<std::size_t>(coreIt - coreIds.begin()),
+                                0u});
+
+                        // Each cache instance is listed by all CPUs sharing it, so it is only added once.
+                        for(std::size_t index(0u);; ++index)
+                        {
+                            auto const cacheDir(cpuDir + "cache/index" + std::to_string(index) + "/");
+                            auto const levelLine(readSysFsLine(cacheDir + "level"));
+                            if(levelLine.empty())
+                            {
+                                break;
+                            }
+                            auto const typeLine(readSysFsLine(cacheDir + "type"));
+                            auto const sizeLine(readSysFsLine(cacheDir + "size"));
+                            auto const lineSizeLine(readSysFsLine(cacheDir + "coherency_line_size"));
+
+                            CpuCache cache;
+                            cache.m_level = static_cast<std::size_t>(std::stoul(levelLine));
+                            cache.m_type =
+                                typeLine == "Data"
+                                ? CpuCacheType::Data
+                                : typeLine == "Instruction"
+                                    ? CpuCacheType::Instruction
+                                    : CpuCacheType::Unified;
+                            cache.m_sizeBytes = 0u;
+                            if(!sizeLine.empty())
+                            {
+                                cache.m_sizeBytes = static_cast<std::size_t>(std::stoul(sizeLine));
+                                switch(sizeLine.back())
+                                {
+                                case 'K': cache.m_sizeBytes <<= 10u; break;
+                                case 'M': cache.m_sizeBytes <<= 20u; break;
+                                case 'G': cache.m_sizeBytes <<= 30u; break;
+                                default: break;
+                                }
+                            }
+                            cache.m_lineSizeBytes = lineSizeLine.empty() ? 0u : static_cast<std::size_t>(std::stoul(lineSizeLine));
+                            cache.m_sharedCpus = parseCpuList(readSysFsLine(cacheDir + "shared_cpu_list"));
+                            if(cache.m_sharedCpus.empty())
+                            {
+                                cache.m_sharedCpus.push_back(cpuId);
+                            }
+
+                            bool const bKnown(
+                                std::any_of(
+                                    topology.m_caches.begin(),
+                                    topology.m_caches.end(),
+                                    [&cache](CpuCache const & other)
+                                    {
+                                        return (other.m_level == cache.m_level)
+                                            && (other.m_type == cache.m_type)
+                                            && (other.m_sharedCpus == cache.m_sharedCpus);
+                                    }));
+                            if(!bKnown)
+                            {
+                                topology.m_caches.push_back(cache);
+                            }
+                        }
+                    }
+                    topology.m_socketCount = socketIds.size();
+                    topology.m_physicalCoreCount = coreIds.size();
+
+                    // Without NUMA support all CPUs belong to a single node.
+                    std::string const nodePath("/sys/devices/system/node/");
+                    for(auto const & nodeId : parseCpuList(readSysFsLine(nodePath + "online")))
+                    {
+                        auto const nodeCpus(parseCpuList(readSysFsLine(nodePath + "node" + std::to_string(nodeId) + "/cpulist")));
+                        // Memory only nodes are skipped.
+                        if(nodeCpus.empty())
+                        {
+                            continue;
+                        }
+                        for(auto & logicalCpu : topology.m_logicalCpus)
+                        {
+                            if(std::find(nodeCpus.begin(), nodeCpus.end(), logicalCpu.m_id) != nodeCpus.end())
+                            {
+                                logicalCpu.m_numaNodeId = topology.m_numaNodeCpus.size();
+                            }
+                        }
+                        topology.m_numaNodeCpus.push_back(nodeCpus);
+                        topology.m_numaNodeOsIds.push_back(nodeId);
+                    }
+                    if(topology.m_numaNodeCpus.empty())
+                    {
+                        topology.m_numaNodeCpus.push_back(cpuIds);
+                        topology.m_numaNodeOsIds.push_back(0u);
+                    }
+                    topology.m_numaNodeCount = topology.m_numaNodeCpus.size();
+
+                    return true;
+                }
+#endif
+#if BOOST_ARCH_X86 && (BOOST_COMP_GNUC || BOOST_COMP_CLANG || __INTEL_COMPILER || BOOST_COMP_MSVC)
+                //-----------------------------------------------------------------------------
+                //! Reads the topology with CPUID.
+                //!
+                //! CPUID only describes the executing package. A single socket and NUMA node is assumed
+                //! and consecutive logical CPU ids are assumed to share cores and caches.
+                //!
+                //! \return If the topology could be read.
+                //-----------------------------------------------------------------------------
+                inline auto readCpuTopologyCpuId(
+                    CpuTopology & topology)
+                -> bool
+                {
+                    std::size_t const logicalCpuCount(std::max(std::thread::hardware_concurrency(), 1u));
+
+                    std::uint32_t ex[4] = {0};
+                    cpuid(0, 0, ex);
+                    std::uint32_t const nIds(ex[0]);
+                    bool const bAmd((ex[1] == 0x68747541u) && (ex[3] == 0x69746e65u) && (ex[2] == 0x444d4163u)); // "AuthenticAMD"
+                    cpuid(0x80000000u, 0, ex);
+                    std::uint32_t const nExIds(ex[0]);
+
+                    // The number of logical CPUs per core from the SMT level of the extended topology leaf.
+                    std::size_t threadsPerCore(1u);
+                    if(nIds >= 0xBu)
+                    {
+                        cpuid(0xBu, 0, ex);
+                        if((((ex[2] >> 8u) & 0xFFu) == 1u) && ((ex[1] & 0xFFFFu) != 0u))
+                        {
+                            threadsPerCore = static_cast<std::size_t>(ex[1] & 0xFFFFu);
+                        }
+                    }
+
+                    for(std::size_t cpuId(0u); cpuId < logicalCpuCount; ++cpuId)
+                    {
+                        topology.m_logicalCpus.push_back(CpuLogical{cpuId, 0u, cpuId / threadsPerCore, 0u});
+                    }
+                    topology.m_socketCount = 1u;
+                    topology.m_physicalCoreCount = (logicalCpuCount + threadsPerCore - 1u) / threadsPerCore;
+                    topology.m_numaNodeCount = 1u;
+                    topology.m_numaNodeCpus.emplace_back();
+                    topology.m_numaNodeOsIds.push_back(0u);
+                    for(std::size_t cpuId(0u); cpuId < logicalCpuCount; ++cpuId)
+                    {
+                        topology.m_numaNodeCpus.back().push_back(cpuId);
+                    }
+
+                    // The deterministic cache parameters leaf. AMD uses the same layout at 0x8000001D.
+                    std::uint32_t const cacheLeaf(bAmd ? 0x8000001Du : 0x4u);
+                    if((bAmd && (nExIds < cacheLeaf)) || (!bAmd && (nIds < cacheLeaf)))
+                    {
+                        return false;
+                    }
+                    for(std::uint32_t subLeaf(0u);; ++subLeaf)
+                    {
+                        cpuid(cacheLeaf, subLeaf, ex);
+                        std::uint32_t const type(ex[0] & 0x1Fu);
+                        if(type == 0u)
+                        {
+                            break;
+                        }
+                        auto const sharingCount(std::min(static_cast<std::size_t>(((ex[0] >> 14u) & 0xFFFu) + 1u), logicalCpuCount));
+                        auto const lineSizeBytes(static_cast<std::size_t>((ex[1] & 0xFFFu) + 1u));
+                        auto const partitions(static_cast<std::size_t>(((ex[1] >> 12u) & 0x3FFu) + 1u));
+                        auto const ways(static_cast<std::size_t>(((ex[1] >> 22u) & 0x3FFu) + 1u));
+                        auto const sets(static_cast<std::size_t>(ex[2]) + 1u);
+
+                        for(std::size_t firstCpu(0u); firstCpu < logicalCpuCount; firstCpu += sharingCount)
+                        {
+                            CpuCache cache;
+                            cache.m_level = static_cast<std::size_t>((ex[0] >> 5u) & 0x7u);
+                            cache.m_type =
+                                type == 1u
+                                ? CpuCacheType::Data
+                                : type == 2u
+                                    ? CpuCacheType::Instruction
+                                    : CpuCacheType::Unified;
+                            cache.m_sizeBytes = ways * partitions * lineSizeBytes * sets;
+                            cache.m_lineSizeBytes = lineSizeBytes;
+                            for(auto cpuId(firstCpu); cpuId < std::min(firstCpu + sharingCount, logicalCpuCount); ++cpuId)
+                            {
+                                cache.m_sharedCpus.push_back(cpuId);
+                            }
+                            topology.m_caches.push_back(cache);
+                        }
+                    }
+                    return true;
+                }
+#endif
+                //-----------------------------------------------------------------------------
+                //! \return The topology of the CPUs read from sysfs or with CPUID.
+                //! If neither is available, each logical CPU is assumed to be a core of a single socket without cache information.
+                //-----------------------------------------------------------------------------
+                inline auto readCpuTopology()
+                -> CpuTopology
+                {
+                    CpuTopology topology;
+#if BOOST_OS_LINUX
+                    if(readCpuTopologySysFs(topology))
+                    {
+                        return topology;
+                    }
+                    topology = CpuTopology();
+#endif
+#if BOOST_ARCH_X86 && (BOOST_COMP_GNUC || BOOST_COMP_CLANG || __INTEL_COMPILER || BOOST_COMP_MSVC)
+                    if(readCpuTopologyCpuId(topology))
+                    {
+                        return topology;
+                    }
+                    topology = CpuTopology();
+#endif
+                    std::size_t const logicalCpuCount(std::max(std::thread::hardware_concurrency(), 1u));
+                    topology.m_numaNodeCpus.emplace_back();
+                    topology.m_numaNodeOsIds.push_back(0u);
+                    for(std::size_t cpuId(0u); cpuId < logicalCpuCount; ++cpuId)
+                    {
+                        topology.m_logicalCpus.push_back(CpuLogical{cpuId, 0u, cpuId, 0u});
+                        topology.m_numaNodeCpus.back().push_back(cpuId);
+                    }
+                    topology.m_socketCount = 1u;
+                    topology.m_physicalCoreCount = logicalCpuCount;
+                    topology.m_numaNodeCount = 1u;
+                    return topology;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The topology of the CPUs. It is read once per process.
+                //-----------------------------------------------------------------------------
+                inline auto getCpuTopology()
+                -> CpuTopology const &
+                {
+                    static CpuTopology const topology(readCpuTopology());
+                    return topology;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The ids of the logical CPUs on the same physical core as the given one, including itself.
+                //-----------------------------------------------------------------------------
+                inline auto getSmtSiblings(
+                    CpuTopology const & topology,
+                    std::size_t const cpuId)
+                -> std::vector<std::size_t>
+                {
+                    std::vector<std::size_t> siblings;
+                    auto const cpuIt(
+                        std::find_if(
+                            topology.m_logicalCpus.begin(),
+                            topology.m_logicalCpus.end(),
+                            [cpuId](CpuLogical const & logicalCpu){return logicalCpu.m_id == cpuId;}));
+                    if(cpuIt != topology.m_logicalCpus.end())
+                    {
+                        for(auto const & logicalCpu : topology.m_logicalCpus)
+                        {
+                            if(logicalCpu.m_coreId == cpuIt->m_coreId)
+                            {
+                                siblings.push_back(logicalCpu.m_id);
+                            }
+                        }
+                    }
+                    return siblings;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The data (or unified) cache of the given level used by the given logical CPU or nullptr if there is none.
+                //-----------------------------------------------------------------------------
+                inline auto getDataCache(
+                    CpuTopology const & topology,
+                    std::size_t const level,
+                    std::size_t const cpuId)
+                -> CpuCache const *
+                {
+                    for(auto const & cache : topology.m_caches)
+                    {
+                        if((cache.m_level == level)
+                            && (cache.m_type != CpuCacheType::Instruction)
+                            && (std::find(cache.m_sharedCpus.begin(), cache.m_sharedCpus.end(), cpuId) != cache.m_sharedCpus.end()))
+                        {
+                            return &cache;
+                        }
+                    }
+                    return nullptr;
+                }
+                //-----------------------------------------------------------------------------
+                //! \param level The cache level starting with 1.
+                //! \return The size in bytes of the data (or unified) cache of the given level of one core or 0 if it can not be determined.
+                //-----------------------------------------------------------------------------
+                inline auto getCacheSizeBytes(
+                    std::size_t const level)
+                -> std::size_t
+                {
+                    auto const & topology(getCpuTopology());
+                    auto const * const cache(getDataCache(topology, level, topology.m_logicalCpus.front().m_id));
+                    return cache ? cache->m_sizeBytes : 0u;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The size in bytes of the data (or unified) cache of the highest level of one core or 0 if it can not be determined.
+                //-----------------------------------------------------------------------------
+                inline auto getLastLevelCacheSizeBytes()
+                -> std::size_t
+                {
+                    std::size_t maxLevel(0u);
+                    for(auto const & cache : getCpuTopology().m_caches)
+                    {
+                        maxLevel = std::max(maxLevel, cache.m_level);
+                    }
+                    for(auto level(maxLevel); level > 0u; --level)
+                    {
+                        auto const cacheSizeBytes(getCacheSizeBytes(level));
+                        if(cacheSizeBytes > 0u)
+                        {
+                            return cacheSizeBytes;
+                        }
+                    }
+                    return 0u;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The size in bytes of a line of the first level data cache or 0 if it can not be determined.
+                //-----------------------------------------------------------------------------
+                inline auto getCacheLineSizeBytes()
+                -> std::size_t
+                {
+                    auto const & topology(getCpuTopology());
+                    auto const * const cache(getDataCache(topology, 1u, topology.m_logicalCpus.front().m_id));
+                    return cache ? cache->m_lineSizeBytes : 0u;
+                }
             }
         }
     }
-}
\ No newline at end of file
+}
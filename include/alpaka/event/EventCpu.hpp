@@ -29,11 +29,15 @@
 
 #include <alpaka/stream/StreamCpuAsync.hpp> // stream::StreamCpuAsync
 #include <alpaka/stream/StreamCpuSync.hpp>  // stream::StreamCpuSync
+#include <alpaka/stream/cpu/Stats.hpp>      // stream::cpu::detail::StreamStatsCollector
+#include <alpaka/profiler/Profiler.hpp>     // ALPAKA_PROFILER_EVENT_WAIT_SCOPE
 
 #include <boost/uuid/uuid.hpp>              // boost::uuids::uuid
 #include <boost/uuid/uuid_generators.hpp>   // boost::uuids::random_generator
 #include <boost/core/ignore_unused.hpp>     // boost::ignore_unused
 
+#include <exception>                        // std::exception_ptr, std::rethrow_exception
+#include <memory>                           // std::weak_ptr
 #include <mutex>                            // std::mutex
 #include <condition_variable>               // std::condition_variable
 #if ALPAKA_DEBUG >= ALPAKA_DEBUG_MINIMAL
@@ -107,6 +111,10 @@ namespace alpaka
                     bool m_bIsWaitedFor;                                    //!< If a (one or multiple) streams wait for this event. The event can not be changed (deleted/re-enqueued) until completion.
 
                     std::size_t m_canceledEnqueueCount;                    //!< The number of successive re-enqueues while it was already in the queue. Reset on completion.
+
+                    std::weak_ptr<stream::cpu::detail::StreamStatsCollector> m_wpStreamStats;  //!< The statistics of the asynchronous stream the event has last been enqueued into. Host threads waiting for the event are recorded there.
+
+                    std::exception_ptr m_exception;                         //!< The exception thrown by a task preceding the event in the stream. It is rethrown by the waits for the event.
                 };
             }
         }
@@ -276,9 +284,16 @@ namespace alpaka
                     // We can not unlock the mutex here, because the order of events enqueued has to be identical to the call order.
                     // Unlocking here would allow a later enqueue call to complete before this event is enqueued.
 
+#ifdef ALPAKA_STREAM_STATS_COLLECTED
+                    spEventCpuImpl->m_wpStreamStats = spStreamImpl->m_spStats;
+#endif
+
                     // Enqueue a task that only resets the events flag if it is completed.
-                    spStreamImpl->m_workerThread.enqueueTask(
-                        [spEventCpuImpl]()
+                    // It hands the exceptions of the preceding tasks over to the event.
+                    auto * const pStreamImpl(spStreamImpl.get());
+                    spStreamImpl->enqueueTask(
+                        stream::cpu::detail::StreamTaskKind::Internal,
+                        [spEventCpuImpl, pStreamImpl]()
                         {
                             {
                                 std::lock_guard<std::mutex> lk(spEventCpuImpl->m_Mutex);
@@ -290,6 +305,7 @@ namespace alpaka
                                 }
                                 else
                                 {
+                                    spEventCpuImpl->m_exception = pStreamImpl->takeException();
                                     spEventCpuImpl->m_bIsWaitedFor = false;
                                     spEventCpuImpl->m_bIsReady = true;
                                 }
@@ -379,6 +395,8 @@ namespace alpaka
                         }
                         else
                         {
+                            // The tasks of synchronous streams throw directly to the caller.
+                            spEventCpuImpl->m_exception = nullptr;
                             spEventCpuImpl->m_bIsWaitedFor = false;
                             spEventCpuImpl->m_bIsReady = true;
                         }
@@ -416,6 +434,7 @@ namespace alpaka
             //!
             //! Waits until the event itself and therefore all tasks preceding it in the stream it is enqueued to have been completed.
             //! If the event is not enqueued to a stream the method returns immediately.
+            //! If a task preceding the event in an asynchronous stream has thrown an exception, it is rethrown.
             //#############################################################################
             template<>
             struct CurrentThreadWaitFor<
@@ -455,9 +474,27 @@ namespace alpaka
                     if(!spEventCpuImpl->m_bIsReady)
                     {
                         spEventCpuImpl->m_bIsWaitedFor = true;
+
+#ifdef ALPAKA_STREAM_STATS_COLLECTED
+                        auto const spStreamStats(spEventCpuImpl->m_wpStreamStats.lock());
+                        ALPAKA_PROFILER_EVENT_WAIT_SCOPE(spStreamStats ? spStreamStats->getStreamIdx() : profiler::noStreamIdx);
+                        auto const waitStartTime(stream::cpu::detail::StreamStatsCollector::Clock::now());
+#endif
                         spEventCpuImpl->m_ConditionVariable.wait(
                             lk,
                             [spEventCpuImpl]{return spEventCpuImpl->m_bIsReady;});
+#ifdef ALPAKA_STREAM_STATS_COLLECTED
+                        // Waits of stream worker threads are recorded by the waiting stream itself.
+                        if(spStreamStats && !stream::cpu::detail::getCurrentThreadStreamStatsPtr())
+                        {
+                            spStreamStats->addHostEventWait(stream::cpu::detail::StreamStatsCollector::Clock::now() - waitStartTime);
+                        }
+#endif
+                    }
+
+                    if(spEventCpuImpl->m_exception)
+                    {
+                        std::rethrow_exception(spEventCpuImpl->m_exception);
                     }
                 }
             };
@@ -487,7 +524,8 @@ namespace alpaka
                     }
 
                     // Enqueue a task that waits for the given event.
-                    spStreamImpl->m_workerThread.enqueueTask(
+                    spStreamImpl->enqueueTask(
+                        stream::cpu::detail::StreamTaskKind::EventWait,
                         [spEventCpuImpl]()
                         {
                             wait::wait(spEventCpuImpl);
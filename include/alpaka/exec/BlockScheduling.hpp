@@ -0,0 +1,310 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <alpaka/dev/cpu/Affinity.hpp>      // dev::cpu::ThreadAffinity
+#include <alpaka/exec/BlockTraversal.hpp>   // exec::detail::getBlockTraversalMapper
+#include <alpaka/core/ParallelFor.hpp>      // core::parallelFor
+#include <alpaka/vec/Vec.hpp>               // Vec
+
+#include <alpaka/core/Common.hpp>           // ALPAKA_FN_HOST
+
+#include <algorithm>                        // std::min, std::max
+#include <atomic>                           // std::atomic
+#include <cstdlib>                          // std::getenv
+#include <mutex>                            // std::mutex
+#include <stdexcept>                        // std::invalid_argument
+#include <string>                           // std::string
+#include <thread>                           // std::thread::hardware_concurrency
+
+namespace alpaka
+{
+    namespace exec
+    {
+        //#############################################################################
+        //! The ways the CPU executors running blocks in parallel distribute the blocks of a grid to their workers.
+        //#############################################################################
+        enum class BlockScheduleKind
+        {
+            Serial,     //!< The executing thread executes all blocks one after another. This is the default.
+            Static,     //!< Each worker executes one contiguous range of equally many blocks.
+            Guided,     //!< The workers claim chunks of blocks from a shared counter. The chunks shrink as the remaining blocks drain.
+        };
+
+        //#############################################################################
+        //! A block schedule.
+        //#############################################################################
+        struct BlockSchedule
+        {
+            BlockScheduleKind m_kind;       //!< The kind.
+            std::size_t m_minChunkSize;     //!< The minimum number of blocks claimed at once for BlockScheduleKind::Guided.
+            std::size_t m_workerCount;      //!< The number of workers executing blocks in parallel. Zero selects it from the number of available CPUs.
+        };
+
+        //-----------------------------------------------------------------------------
+        //! \param str "serial", "static", "guided" or "guided:<minimum chunk size>". An empty string selects "serial".
+        //! \return The block schedule described by the given string. The number of workers is selected automatically.
+        //! \throws std::invalid_argument if the string is not a valid description.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto parseBlockSchedule(
+            std::string const & str)
+        -> BlockSchedule
+        {
+            if(str.empty() || (str == "serial"))
+            {
+                return BlockSchedule{BlockScheduleKind::Serial, 1u, 1u};
+            }
+            else if(str == "guided")
+            {
+                return BlockSchedule{BlockScheduleKind::Guided, 1u, 0u};
+            }
+            else if(str == "static")
+            {
+                return BlockSchedule{BlockScheduleKind::Static, 1u, 0u};
+            }
+            else if((str.compare(0u, 7u, "guided:") == 0)
+                && (str.size() > 7u)
+                && (str.find_first_not_of("0123456789", 7u) == std::string::npos))
+            {
+                auto const minChunkSize(static_cast<std::size_t>(std::stoul(str.substr(7u))));
+                if(minChunkSize > 0u)
+                {
+                    return BlockSchedule{BlockScheduleKind::Guided, minChunkSize, 0u};
+                }
+            }
+            throw std::invalid_argument("'" + str + "' is not a valid block schedule!");
+        }
+
+        namespace detail
+        {
+            //-----------------------------------------------------------------------------
+            //! The environment variable holding the initial block schedule in the format of parseBlockSchedule.
+            //-----------------------------------------------------------------------------
+            static constexpr char const * blockScheduleEnvVar = "ALPAKA_BLOCK_SCHEDULE";
+
+            //#############################################################################
+            //! The block schedule used by the CPU executors.
+            //#############################################################################
+            struct BlockScheduleSetting
+            {
+                std::mutex m_mutex;
+                BlockSchedule m_blockSchedule;
+            };
+            //-----------------------------------------------------------------------------
+            //! \return The block schedule used by the CPU executors. It is initialized from the ALPAKA_BLOCK_SCHEDULE environment variable.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getBlockScheduleSetting()
+            -> BlockScheduleSetting &
+            {
+                static BlockScheduleSetting setting{
+                    {},
+                    [](){
+                        auto const * const str(std::getenv(blockScheduleEnvVar));
+                        return parseBlockSchedule(str ? std::string(str) : std::string());
+                    }()};
+                return setting;
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The number of workers executing the blocks of a grid in parallel.
+            //!
+            //! \param blockSchedule The block schedule.
+            //! \param workerCpuCount The number of CPUs a single worker keeps busy.
+            //! \param threadAffinity The affinity of the workers. The workers share its CPUs.
+            //! \param blockCount The number of blocks in the grid.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getBlockWorkerCount(
+                BlockSchedule const & blockSchedule,
+                std::size_t const & workerCpuCount,
+                dev::cpu::ThreadAffinity const & threadAffinity,
+                std::size_t const & blockCount)
+            -> std::size_t
+            {
+                if(blockSchedule.m_kind == BlockScheduleKind::Serial)
+                {
+                    return 1u;
+                }
+                auto workerCount(blockSchedule.m_workerCount);
+                if(workerCount == 0u)
+                {
+                    auto const cpuCount(
+                        threadAffinity.isEnabled()
+                        ? threadAffinity.getCpus().size()
+                        : static_cast<std::size_t>(std::thread::hardware_concurrency()));
+                    workerCount = cpuCount / std::max(workerCpuCount, static_cast<std::size_t>(1u));
+                }
+                return std::max(std::min(workerCount, blockCount), static_cast<std::size_t>(1u));
+            }
+
+            //#############################################################################
+            //! Distributes the blocks of a grid to the workers executing them in parallel.
+            //!
+            //! The workers share the positions of the current block traversal. Positions outside of the grid are skipped.
+            //! Each worker executes its blocks in this order, so a single worker executes the blocks exactly like the serial executors.
+            //#############################################################################
+            template<
+                typename TDim,
+                typename TSize>
+            class BlockScheduler
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST BlockScheduler(
+                    Vec<TDim, TSize> const & gridBlockExtent,
+                    BlockSchedule const & blockSchedule,
+                    std::size_t const & workerCount) :
+                        m_blockTraversalMapper(getBlockTraversalMapper(gridBlockExtent)),
+                        m_positionCount(m_blockTraversalMapper.getPositionCount()),
+                        m_blockSchedule(blockSchedule),
+                        m_workerCount(workerCount),
+                        m_nextBlock(0u)
+                {}
+
+                //-----------------------------------------------------------------------------
+                //! \return The number of workers.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getWorkerCount() const
+                -> std::size_t
+                {
+                    return m_workerCount;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Calls f(gridBlockIdx) for each block assigned to the given worker.
+                //! The workers have to call this concurrently.
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TFnObj>
+                ALPAKA_FN_HOST auto forEachBlock(
+                    std::size_t const & workerIdx,
+                    TFnObj const & f)
+                -> void
+                {
+                    if(m_blockSchedule.m_kind != BlockScheduleKind::Guided)
+                    {
+                        execBlocks(
+                            m_positionCount * workerIdx / m_workerCount,
+                            m_positionCount * (workerIdx + 1u) / m_workerCount,
+                            f);
+                    }
+                    else
+                    {
+                        // Guided self-scheduling: Each claim takes a share of the remaining positions.
+                        // The first chunks are large to keep the contention on the counter low, the last ones are small to balance the load.
+                        auto const minChunkSize(std::max(m_blockSchedule.m_minChunkSize, static_cast<std::size_t>(1u)));
+                        auto begin(m_nextBlock.load(std::memory_order_relaxed));
+                        while(begin < m_positionCount)
+                        {
+                            auto const remaining(m_positionCount - begin);
+                            auto const chunkSize(std::min(std::max(remaining / (2u * m_workerCount), minChunkSize), remaining));
+                            if(m_nextBlock.compare_exchange_weak(begin, begin + chunkSize, std::memory_order_relaxed))
+                            {
+                                execBlocks(
+                                    begin,
+                                    begin + chunkSize,
+                                    f);
+                                begin = m_nextBlock.load(std::memory_order_relaxed);
+                            }
+                        }
+                    }
+                }
+
+            private:
+                //-----------------------------------------------------------------------------
+                //! Calls f(gridBlockIdx) for the blocks at the positions [begin, end) of the traversal.
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TFnObj>
+                ALPAKA_FN_HOST auto execBlocks(
+                    std::size_t const & begin,
+                    std::size_t const & end,
+                    TFnObj const & f) const
+                -> void
+                {
+                    auto gridBlockIdx(Vec<TDim, TSize>::zeros());
+                    for(auto position(begin); position < end; ++position)
+                    {
+                        if(m_blockTraversalMapper.mapPosition(position, gridBlockIdx))
+                        {
+                            f(gridBlockIdx);
+                        }
+                    }
+                }
+
+            private:
+                BlockTraversalMapper<TDim, TSize> const m_blockTraversalMapper;
+                std::size_t const m_positionCount;
+                BlockSchedule const m_blockSchedule;
+                std::size_t const m_workerCount;
+                std::atomic<std::size_t> m_nextBlock;
+            };
+
+            //-----------------------------------------------------------------------------
+            //! Calls f(workerIdx) for each of the workers of the block scheduler in parallel and waits for all of them.
+            //! This has the semantics of core::parallelFor.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TDim,
+                typename TSize,
+                typename TFnObj>
+            ALPAKA_FN_HOST auto runBlockWorkers(
+                BlockScheduler<TDim, TSize> const & blockScheduler,
+                TFnObj const & f)
+            -> void
+            {
+                core::parallelFor(
+                    blockScheduler.getWorkerCount(),
+                    f);
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Sets how the CPU executors running blocks in parallel distribute the blocks of a grid to their workers.
+        //!
+        //! The initial value is given by the ALPAKA_BLOCK_SCHEDULE environment variable. Without it the blocks are executed serially.
+        //! With a static or guided schedule ExecCpuThreads executes blocks in parallel if the CPUs can hold more than one block at a time.
+        //! ExecCpuFibers runs all fibers of a block on a single thread, so it uses one worker per CPU.
+        //! Guided scheduling balances irregular kernels where the run time of the blocks differs.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto setBlockSchedule(
+            BlockSchedule const & blockSchedule)
+        -> void
+        {
+            auto & setting(detail::getBlockScheduleSetting());
+            std::lock_guard<std::mutex> lk(setting.m_mutex);
+            setting.m_blockSchedule = blockSchedule;
+        }
+        //-----------------------------------------------------------------------------
+        //! \return How the CPU executors running blocks in parallel distribute the blocks of a grid to their workers.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto getBlockSchedule()
+        -> BlockSchedule
+        {
+            auto & setting(detail::getBlockScheduleSetting());
+            std::lock_guard<std::mutex> lk(setting.m_mutex);
+            return setting.m_blockSchedule;
+        }
+    }
+}
@@ -0,0 +1,529 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <alpaka/core/FastDivisor.hpp>  // core::FastDivisor, core::FastIdxMapper
+#include <alpaka/core/NdLoop.hpp>       // core::ndLoopIncIdx
+#include <alpaka/vec/Vec.hpp>           // Vec
+
+#include <alpaka/core/Common.hpp>       // ALPAKA_FN_HOST
+
+#include <algorithm>                    // std::min, std::max
+#include <cstdint>                      // std::uint64_t
+#include <cstdlib>                      // std::getenv
+#include <limits>                       // std::numeric_limits
+#include <mutex>                        // std::mutex
+#include <stdexcept>                    // std::invalid_argument
+#include <string>                       // std::string
+
+namespace alpaka
+{
+    namespace exec
+    {
+        //#############################################################################
+        //! The orders the CPU executors can enumerate the blocks of a grid in.
+        //#############################################################################
+        enum class BlockTraversalOrder
+        {
+            Lexicographic,  //!< Row major order with the last dimension being the fastest.
+            Morton,         //!< Z-order curve. The bits of the block indices are interleaved.
+            Hilbert,        //!< Hilbert curve. Consecutive blocks are always neighbours.
+            Tiled,          //!< Row major order of tiles, each traversed in row major order.
+        };
+
+        //#############################################################################
+        //! A block traversal.
+        //!
+        //! The Morton curve is defined on the smallest power of two extents enclosing the grid.
+        //! The Hilbert curve is defined on power of two hypercubes covering the grid in row major order.
+        //! Blocks outside of the grid are skipped, so neighbouring blocks stay close for any grid extent.
+        //#############################################################################
+        struct BlockTraversal
+        {
+            BlockTraversalOrder m_order;    //!< The order.
+            std::size_t m_tileSize;         //!< The extent of a tile in blocks in each dimension for BlockTraversalOrder::Tiled.
+        };
+
+        //-----------------------------------------------------------------------------
+        //! \param str "lexicographic", "morton", "hilbert", "tiled" or "tiled:<tile size>".
+        //! \return The block traversal described by the given string.
+        //! \throws std::invalid_argument if the string is not a valid description.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto parseBlockTraversal(
+            std::string const & str)
+        -> BlockTraversal
+        {
+            if(str.empty() || (str == "lexicographic"))
+            {
+                return BlockTraversal{BlockTraversalOrder::Lexicographic, 1u};
+            }
+            else if(str == "morton")
+            {
+                return BlockTraversal{BlockTraversalOrder::Morton, 1u};
+            }
+            else if(str == "hilbert")
+            {
+                return BlockTraversal{BlockTraversalOrder::Hilbert, 1u};
+            }
+            else if(str == "tiled")
+            {
+                return BlockTraversal{BlockTraversalOrder::Tiled, 4u};
+            }
+            else if((str.compare(0u, 6u, "tiled:") == 0)
+                && (str.size() > 6u)
+                && (str.find_first_not_of("0123456789", 6u) == std::string::npos))
+            {
+                auto const tileSize(static_cast<std::size_t>(std::stoul(str.substr(6u))));
+                if(tileSize > 0u)
+                {
+                    return BlockTraversal{BlockTraversalOrder::Tiled, tileSize};
+                }
+            }
+            throw std::invalid_argument("'" + str + "' is not a valid block traversal!");
+        }
+
+        namespace detail
+        {
+            //-----------------------------------------------------------------------------
+            //! The environment variable holding the initial block traversal in the format of parseBlockTraversal.
+            //-----------------------------------------------------------------------------
+            static constexpr char const * blockTraversalEnvVar = "ALPAKA_BLOCK_TRAVERSAL";
+
+            //#############################################################################
+            //! The block traversal used by the CPU executors.
+            //#############################################################################
+            struct BlockTraversalSetting
+            {
+                std::mutex m_mutex;
+                BlockTraversal m_blockTraversal;
+            };
+            //-----------------------------------------------------------------------------
+            //! \return The block traversal used by the CPU executors. It is initialized from the ALPAKA_BLOCK_TRAVERSAL environment variable.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getBlockTraversalSetting()
+            -> BlockTraversalSetting &
+            {
+                static BlockTraversalSetting setting{
+                    {},
+                    [](){
+                        auto const * const str(std::getenv(blockTraversalEnvVar));
+                        return parseBlockTraversal(str ? std::string(str) : std::string());
+                    }()};
+                return setting;
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Transforms the transposed Hilbert curve index of a hypercube into its coordinates.
+            //!
+            //! This is the inverse transform of the transpose representation by John Skilling, "Programming the Hilbert curve", AIP Conference Proceedings 707, 2004.
+            //! \param coords The transposed index with the first dimension holding the most significant bit of each level. It is replaced by the coordinates.
+            //! \param dim The number of dimensions.
+            //! \param bitCount The number of bits of each coordinate.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto transposeToHilbertCoords(
+                std::uint64_t * const coords,
+                std::size_t const dim,
+                std::size_t const bitCount)
+            -> void
+            {
+                if((dim == 0u) || (bitCount == 0u))
+                {
+                    return;
+                }
+                std::uint64_t const sideLength(static_cast<std::uint64_t>(1u) << bitCount);
+
+                // Gray decode.
+                auto t(coords[dim - 1u] >> 1u);
+                for(std::size_t i(dim - 1u); i > 0u; --i)
+                {
+                    coords[i] ^= coords[i - 1u];
+                }
+                coords[0] ^= t;
+
+                // Undo the excess work.
+                for(std::uint64_t q(2u); q != sideLength; q <<= 1u)
+                {
+                    auto const p(q - 1u);
+                    for(std::size_t i(dim); i > 0u; --i)
+                    {
+                        if(coords[i - 1u] & q)
+                        {
+                            coords[0] ^= p;
+                        }
+                        else
+                        {
+                            t = (coords[0] ^ coords[i - 1u]) & p;
+                            coords[0] ^= t;
+                            coords[i - 1u] ^= t;
+                        }
+                    }
+                }
+            }
+
+            //#############################################################################
+            //! Maps the positions of a block traversal to the blocks of a grid.
+            //!
+            //! The grid is covered by cells traversed in row major order. Within a cell the blocks are traversed
+            //! in row major order for BlockTraversalOrder::Tiled and along the curve for the other orders.
+            //! Positions of cells reaching over the border of the grid that are outside of the grid are skipped.
+            //! The order is computed from the position directly, so there is no per block state.
+            //#############################################################################
+            template<
+                typename TDim,
+                typename TSize>
+            class BlockTraversalMapper
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST BlockTraversalMapper(
+                    BlockTraversal const & blockTraversal,
+                    Vec<TDim, TSize> const & gridBlockExtent) :
+                        m_order(getMappedOrder(blockTraversal, gridBlockExtent)),
+                        m_gridBlockExtent(gridBlockExtent),
+                        m_cellExtent(getCellExtent(m_order, blockTraversal.m_tileSize, gridBlockExtent)),
+                        m_cellCountMapper(getCellCount(gridBlockExtent, m_cellExtent)),
+                        m_cellIdxMapper(m_cellExtent),
+                        m_cellVolume(m_cellExtent.prod()),
+                        m_cellVolumeDivisor(m_cellVolume),
+                        m_positionCount(static_cast<std::size_t>(m_cellCountMapper.getExtent().prod()) * static_cast<std::size_t>(m_cellVolume))
+                {
+                    for(std::size_t i(0u); i < TDim::value; ++i)
+                    {
+                        m_bitCounts[i] = 0u;
+                        while((static_cast<TSize>(1u) << m_bitCounts[i]) < m_cellExtent[i])
+                        {
+                            ++m_bitCounts[i];
+                        }
+                    }
+                }
+
+                //-----------------------------------------------------------------------------
+                //! \return If the blocks are traversed in row major order. The positions are the linear block indices then.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto isLexicographic() const
+                -> bool
+                {
+                    return m_order == BlockTraversalOrder::Lexicographic;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The number of positions of the traversal. It is at most 2^dim times the number of blocks.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getPositionCount() const
+                -> std::size_t
+                {
+                    return m_positionCount;
+                }
+                //-----------------------------------------------------------------------------
+                //! Maps a position of the traversal to the index of its block.
+                //!
+                //! \return If the position is inside the grid. Otherwise the block index is unspecified.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto mapPosition(
+                    std::size_t const & position,
+                    Vec<TDim, TSize> & gridBlockIdx) const
+                -> bool
+                {
+                    auto const pos(static_cast<TSize>(position));
+                    if(m_order == BlockTraversalOrder::Lexicographic)
+                    {
+                        gridBlockIdx = m_cellCountMapper.mapIdx(Vec<dim::DimInt<1u>, TSize>(pos));
+                        return true;
+                    }
+
+                    auto const cellIdx(m_cellVolumeDivisor.divide(pos));
+                    auto const innerIdx(static_cast<TSize>(pos - cellIdx * m_cellVolume));
+                    gridBlockIdx = m_cellCountMapper.mapIdx(Vec<dim::DimInt<1u>, TSize>(cellIdx));
+                    auto const innerBlockIdx(
+                        (m_order == BlockTraversalOrder::Tiled)
+                        ? m_cellIdxMapper.mapIdx(Vec<dim::DimInt<1u>, TSize>(innerIdx))
+                        : mapCurveIdx(static_cast<std::uint64_t>(innerIdx)));
+                    for(std::size_t i(0u); i < TDim::value; ++i)
+                    {
+                        gridBlockIdx[i] = static_cast<TSize>(gridBlockIdx[i] * m_cellExtent[i] + innerBlockIdx[i]);
+                        if(gridBlockIdx[i] >= m_gridBlockExtent[i])
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+            private:
+                //-----------------------------------------------------------------------------
+                //! \return The index within a cell of the given position on the Morton or Hilbert curve.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto mapCurveIdx(
+                    std::uint64_t curveIdx) const
+                -> Vec<TDim, TSize>
+                {
+                    // Deinterleave the bits. At each level the first dimension holds the most significant bit.
+                    std::uint64_t coords[TDim::value] = {};
+                    std::size_t maxBitCount(0u);
+                    for(std::size_t i(0u); i < TDim::value; ++i)
+                    {
+                        maxBitCount = std::max(maxBitCount, m_bitCounts[i]);
+                    }
+                    for(std::size_t b(0u); b < maxBitCount; ++b)
+                    {
+                        for(std::size_t i(TDim::value); i > 0u; --i)
+                        {
+                            if(m_bitCounts[i - 1u] > b)
+                            {
+                                coords[i - 1u] |= (curveIdx & 1u) << b;
+                                curveIdx >>= 1u;
+                            }
+                        }
+                    }
+
+                    // The Hilbert cells are hypercubes in the dimensions larger than one.
+                    if(m_order == BlockTraversalOrder::Hilbert)
+                    {
+                        std::uint64_t cubeCoords[TDim::value] = {};
+                        std::size_t cubeDim(0u);
+                        for(std::size_t i(0u); i < TDim::value; ++i)
+                        {
+                            if(m_bitCounts[i] > 0u)
+                            {
+                                cubeCoords[cubeDim++] = coords[i];
+                            }
+                        }
+                        transposeToHilbertCoords(cubeCoords, cubeDim, maxBitCount);
+                        cubeDim = 0u;
+                        for(std::size_t i(0u); i < TDim::value; ++i)
+                        {
+                            if(m_bitCounts[i] > 0u)
+                            {
+                                coords[i] = cubeCoords[cubeDim++];
+                            }
+                        }
+                    }
+
+                    auto idx(Vec<TDim, TSize>::zeros());
+                    for(std::size_t i(0u); i < TDim::value; ++i)
+                    {
+                        idx[i] = static_cast<TSize>(coords[i]);
+                    }
+                    return idx;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The extent of the cells covering the grid.
+                //!
+                //! Morton curves use a single cell of power of two extents enclosing the grid.
+                //! Hilbert curves use hypercubes with the largest power of two side length not exceeding the smallest extent larger than one.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto getCellExtent(
+                    BlockTraversalOrder const & order,
+                    std::size_t const & tileSize,
+                    Vec<TDim, TSize> const & gridBlockExtent)
+                -> Vec<TDim, TSize>
+                {
+                    auto cellExtent(Vec<TDim, TSize>::ones());
+                    switch(order)
+                    {
+                    case BlockTraversalOrder::Tiled:
+                        for(std::size_t i(0u); i < TDim::value; ++i)
+                        {
+                            cellExtent[i] = static_cast<TSize>(std::min(std::max(tileSize, static_cast<std::size_t>(1u)), static_cast<std::size_t>(gridBlockExtent[i])));
+                        }
+                        break;
+                    case BlockTraversalOrder::Morton:
+                        for(std::size_t i(0u); i < TDim::value; ++i)
+                        {
+                            while(cellExtent[i] < gridBlockExtent[i])
+                            {
+                                cellExtent[i] = static_cast<TSize>(cellExtent[i] * 2u);
+                            }
+                        }
+                        break;
+                    case BlockTraversalOrder::Hilbert:
+                        {
+                            auto minExtent(static_cast<TSize>(0u));
+                            for(std::size_t i(0u); i < TDim::value; ++i)
+                            {
+                                if((gridBlockExtent[i] > 1u) && ((minExtent == 0u) || (gridBlockExtent[i] < minExtent)))
+                                {
+                                    minExtent = gridBlockExtent[i];
+                                }
+                            }
+                            auto sideLength(static_cast<TSize>(1u));
+                            while((minExtent > 0u) && (sideLength <= minExtent / 2u))
+                            {
+                                sideLength = static_cast<TSize>(sideLength * 2u);
+                            }
+                            for(std::size_t i(0u); i < TDim::value; ++i)
+                            {
+                                if(gridBlockExtent[i] > 1u)
+                                {
+                                    cellExtent[i] = sideLength;
+                                }
+                            }
+                        }
+                        break;
+                    case BlockTraversalOrder::Lexicographic:
+                        break;
+                    }
+                    return cellExtent;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The number of cells in each dimension.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto getCellCount(
+                    Vec<TDim, TSize> const & gridBlockExtent,
+                    Vec<TDim, TSize> const & cellExtent)
+                -> Vec<TDim, TSize>
+                {
+                    auto cellCount(Vec<TDim, TSize>::ones());
+                    for(std::size_t i(0u); i < TDim::value; ++i)
+                    {
+                        cellCount[i] = static_cast<TSize>((gridBlockExtent[i] + cellExtent[i] - 1u) / cellExtent[i]);
+                    }
+                    return cellCount;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The order that is mapped.
+                //! Orders equal to the lexicographic one and grids whose positions do not fit into TSize are traversed lexicographically.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto getMappedOrder(
+                    BlockTraversal const & blockTraversal,
+                    Vec<TDim, TSize> const & gridBlockExtent)
+                -> BlockTraversalOrder
+                {
+                    auto const cellExtent(getCellExtent(blockTraversal.m_order, blockTraversal.m_tileSize, gridBlockExtent));
+                    auto const cellCount(getCellCount(gridBlockExtent, cellExtent));
+
+                    std::size_t curveDim(0u);
+                    std::uint64_t positionCount(1u);
+                    bool bOverflow(false);
+                    for(std::size_t i(0u); i < TDim::value; ++i)
+                    {
+                        if(gridBlockExtent[i] > 1u)
+                        {
+                            ++curveDim;
+                        }
+                        auto const paddedExtent(static_cast<std::uint64_t>(cellCount[i]) * static_cast<std::uint64_t>(cellExtent[i]));
+                        bOverflow = bOverflow || (paddedExtent > static_cast<std::uint64_t>(std::numeric_limits<TSize>::max()) / positionCount);
+                        positionCount *= bOverflow ? 1u : paddedExtent;
+                    }
+
+                    if((curveDim < 2u)
+                        || bOverflow
+                        || (positionCount > static_cast<std::uint64_t>(std::numeric_limits<std::size_t>::max()))
+                        || (cellExtent.prod() == 1u)
+                        || ((blockTraversal.m_order == BlockTraversalOrder::Tiled) && (cellCount.prod() == 1u)))
+                    {
+                        return BlockTraversalOrder::Lexicographic;
+                    }
+                    return blockTraversal.m_order;
+                }
+
+            private:
+                BlockTraversalOrder const m_order;
+                Vec<TDim, TSize> const m_gridBlockExtent;
+                Vec<TDim, TSize> const m_cellExtent;
+                core::FastIdxMapper<TDim, TSize> const m_cellCountMapper;
+                core::FastIdxMapper<TDim, TSize> const m_cellIdxMapper;
+                TSize const m_cellVolume;
+                core::FastDivisor<TSize> const m_cellVolumeDivisor;
+                std::size_t const m_positionCount;
+                std::size_t m_bitCounts[TDim::value];   //!< The number of bits of the cell index in each dimension for the curves.
+            };
+            //-----------------------------------------------------------------------------
+            //! \return The mapper of the positions of the current block traversal to the blocks of the given grid.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TDim,
+                typename TSize>
+            ALPAKA_FN_HOST auto getBlockTraversalMapper(
+                Vec<TDim, TSize> const & gridBlockExtent)
+            -> BlockTraversalMapper<TDim, TSize>
+            {
+                BlockTraversal blockTraversal;
+                {
+                    auto & setting(getBlockTraversalSetting());
+                    std::lock_guard<std::mutex> lk(setting.m_mutex);
+                    blockTraversal = setting.m_blockTraversal;
+                }
+                return BlockTraversalMapper<TDim, TSize>(blockTraversal, gridBlockExtent);
+            }
+            //-----------------------------------------------------------------------------
+            //! Calls f(gridBlockIdx) for each block of the grid in the order of the current block traversal.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TDim,
+                typename TSize,
+                typename TFnObj>
+            ALPAKA_FN_HOST auto ndLoopBlockTraversal(
+                Vec<TDim, TSize> const & gridBlockExtent,
+                TFnObj const & f)
+            -> void
+            {
+                auto const blockTraversalMapper(getBlockTraversalMapper(gridBlockExtent));
+                if(blockTraversalMapper.isLexicographic())
+                {
+                    core::ndLoopIncIdx(
+                        gridBlockExtent,
+                        f);
+                }
+                else
+                {
+                    auto gridBlockIdx(Vec<TDim, TSize>::zeros());
+                    for(std::size_t position(0u); position < blockTraversalMapper.getPositionCount(); ++position)
+                    {
+                        if(blockTraversalMapper.mapPosition(position, gridBlockIdx))
+                        {
+                            f(gridBlockIdx);
+                        }
+                    }
+                }
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Sets the order in which the CPU executors enumerate the blocks of a grid.
+        //!
+        //! The initial value is given by the ALPAKA_BLOCK_TRAVERSAL environment variable.
+        //! Space filling curves keep the blocks executed one after another close to each other.
+        //! This lets blocks reading the halos of their neighbours, like in stencils, find them in the shared caches.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto setBlockTraversal(
+            BlockTraversal const & blockTraversal)
+        -> void
+        {
+            auto & setting(detail::getBlockTraversalSetting());
+            std::lock_guard<std::mutex> lk(setting.m_mutex);
+            setting.m_blockTraversal = blockTraversal;
+        }
+        //-----------------------------------------------------------------------------
+        //! \return The order in which the CPU executors enumerate the blocks of a grid.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto getBlockTraversal()
+        -> BlockTraversal
+        {
+            auto & setting(detail::getBlockTraversalSetting());
+            std::lock_guard<std::mutex> lk(setting.m_mutex);
+            return setting.m_blockTraversal;
+        }
+    }
+}
@@ -31,8 +31,11 @@
 // Implementation details.
 #include <alpaka/acc/AccCpuFibers.hpp>          // acc:AccCpuFibers
 #include <alpaka/dev/DevCpu.hpp>                // dev::DevCpu
+#include <alpaka/dev/cpu/Affinity.hpp>          // dev::cpu::detail::pinCurrentThread
 #include <alpaka/kernel/Traits.hpp>             // kernel::getBlockSharedExternMemSizeBytes
 #include <alpaka/workdiv/WorkDivMembers.hpp>    // workdiv::WorkDivMembers
+#include <alpaka/profiler/Profiler.hpp>         // ALPAKA_PROFILER_KERNEL_SCOPE
+#include <alpaka/exec/BlockScheduling.hpp>      // exec::detail::BlockScheduler
 
 #include <alpaka/core/Fibers.hpp>
 #include <alpaka/core/ConcurrentExecPool.hpp>   // core::ConcurrentExecPool
@@ -43,6 +46,7 @@
 #include <boost/align.hpp>                      // boost::aligned_alloc
 
 #include <algorithm>                            // std::for_each
+#include <mutex>                                // std::mutex
 #include <vector>                               // std::vector
 #include <tuple>                                // std::tuple
 #include <type_traits>                          // std::decay
@@ -165,8 +169,55 @@ namespace alpaka
                 std::cout << BOOST_CURRENT_FUNCTION
                     << " BlockSharedExternMemSizeBytes: " << blockSharedExternMemSizeBytes << " B" << std::endl;
 #endif
+                ALPAKA_PROFILER_KERNEL_SCOPE(TKernelFnObj, *this, blockSharedExternMemSizeBytes, acc::AccCpuFibers<TDim, TSize>);
+
+                // All fibers of a worker run on the thread of the worker.
+                auto const & threadAffinity(dev::cpu::detail::getCurrentThreadAffinity());
+
+                // Each worker keeps one CPU busy, so multiple workers execute blocks in parallel.
+                auto const blockSchedule(exec::getBlockSchedule());
+                exec::detail::BlockScheduler<TDim, TSize> blockScheduler(
+                    gridBlockExtent,
+                    blockSchedule,
+                    exec::detail::getBlockWorkerCount(
+                        blockSchedule,
+                        1u,
+                        threadAffinity,
+                        static_cast<std::size_t>(gridBlockExtent.prod())));
+
+                // The atomic operations of all blocks of this grid are serialized by this mutex.
+                std::mutex mtxAtomic;
+
+                exec::detail::runBlockWorkers(
+                    blockScheduler,
+                    [&](std::size_t const & workerIdx)
+                    {
+                        this->workerExecHost(
+                            workerIdx,
+                            blockScheduler,
+                            blockThreadExtent,
+                            blockSharedExternMemSizeBytes,
+                            threadAffinity,
+                            mtxAtomic);
+                    });
+            }
+
+        private:
+            //-----------------------------------------------------------------------------
+            //! The function executed by each worker executing blocks.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto workerExecHost(
+                std::size_t const & workerIdx,
+                exec::detail::BlockScheduler<TDim, TSize> & blockScheduler,
+                Vec<TDim, TSize> const & blockThreadExtent,
+                std::size_t const & blockSharedExternMemSizeBytes,
+                dev::cpu::ThreadAffinity const & threadAffinity,
+                std::mutex & mtxAtomic) const
+            -> void
+            {
                 acc::AccCpuFibers<TDim, TSize> acc(
-                    *static_cast<workdiv::WorkDivMembers<TDim, TSize> const *>(this));
+                    *static_cast<workdiv::WorkDivMembers<TDim, TSize> const *>(this),
+                    mtxAtomic);
 
                 if(blockSharedExternMemSizeBytes > 0u)
                 {
@@ -175,6 +226,9 @@ namespace alpaka
                             boost::alignment::aligned_alloc(16u, blockSharedExternMemSizeBytes)));
                 }
 
+                // The thread of the worker is pinned according to the affinity of the stream for the duration of the kernel.
+                dev::cpu::detail::ScopedThreadPin const scopedThreadPin(threadAffinity, workerIdx);
+
                 auto const blockThreadCount(blockThreadExtent.prod());
                 FiberPool fiberPool(blockThreadCount, blockThreadCount);
 
@@ -195,16 +249,15 @@ namespace alpaka
                         },
                         m_args));
 
-                // Execute the blocks serially.
-                core::ndLoopIncIdx(
-                    gridBlockExtent,
+                // Execute the blocks assigned to this worker in the order of the block traversal.
+                blockScheduler.forEachBlock(
+                    workerIdx,
                     boundGridBlockExecHost);
 
                 // After all blocks have been processed, the external shared memory has to be deleted.
                 acc.m_externalSharedMem.reset();
             }
 
-        private:
             //-----------------------------------------------------------------------------
             //! The function executed for each grid block.
             //-----------------------------------------------------------------------------
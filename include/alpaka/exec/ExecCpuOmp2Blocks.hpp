@@ -31,11 +31,13 @@
 // Implementation details.
 #include <alpaka/acc/AccCpuOmp2Blocks.hpp>      // acc::AccCpuOmp2Blocks
 #include <alpaka/dev/DevCpu.hpp>                // dev::DevCpu
+#include <alpaka/dev/cpu/Affinity.hpp>          // dev::cpu::detail::pinCurrentThread
+#include <alpaka/exec/BlockTraversal.hpp>       // exec::detail::getBlockTraversalMapper
 #include <alpaka/kernel/Traits.hpp>             // kernel::getBlockSharedExternMemSizeBytes
 #include <alpaka/workdiv/WorkDivMembers.hpp>    // workdiv::WorkDivMembers
+#include <alpaka/profiler/Profiler.hpp>         // ALPAKA_PROFILER_KERNEL_SCOPE
 
 #include <alpaka/core/OpenMp.hpp>
-#include <alpaka/core/MapIdx.hpp>               // core::mapIdx
 #include <alpaka/core/ApplyTuple.hpp>           // core::Apply
 
 #include <boost/align.hpp>                      // boost::aligned_alloc
@@ -136,6 +138,8 @@ namespace alpaka
                 std::cout << BOOST_CURRENT_FUNCTION
                     << " BlockSharedExternMemSizeBytes: " << blockSharedExternMemSizeBytes << " B" << std::endl;
 #endif
+                ALPAKA_PROFILER_KERNEL_SCOPE(TKernelFnObj, *this, blockSharedExternMemSizeBytes, acc::AccCpuOmp2Blocks<TDim, TSize>);
+
                 // Bind all arguments except the accelerator.
                 // TODO: With C++14 we could create a perfectly argument forwarding function object within the constructor.
                 auto const boundKernelFnObj(
@@ -150,8 +154,11 @@ namespace alpaka
                         },
                         m_args));
 
-                // The number of blocks in the grid.
-                TSize const numBlocksInGrid(gridBlockExtent.prod());
+                // Maps the positions of the block traversal to the blocks without integer divisions.
+                // Each thread executes consecutive chunks of positions so neighbouring blocks share its caches.
+                auto const blockTraversalMapper(exec::detail::getBlockTraversalMapper(gridBlockExtent));
+                // The number of positions of the block traversal. It equals the number of blocks in the grid for the lexicographic order.
+                TSize const numBlocksInGrid(static_cast<TSize>(blockTraversalMapper.getPositionCount()));
                 // There is only ever one thread in a block in the OpenMP 2.0 block accelerator.
                 assert(blockThreadExtent.prod() == 1u);
 
@@ -159,10 +166,18 @@ namespace alpaka
                 int const ompIsDynamic(::omp_get_dynamic());
                 ::omp_set_dynamic(0);
 
+                // The OpenMP threads are pinned according to the affinity of the stream executing the kernel.
+                // The calling thread is the master thread. It is only pinned for the duration of the kernel.
+                auto const & threadAffinity(dev::cpu::detail::getCurrentThreadAffinity());
+                dev::cpu::detail::ScopedThreadPin const scopedThreadPin(threadAffinity, 0u);
+
                 // Execute the blocks in parallel.
                 // NOTE: Setting num_threads(number_of_cores) instead of the default thread number does not improve performance.
                 #pragma omp parallel
                 {
+                    // The worker threads of the OpenMP runtime are only pinned for the duration of the parallel region.
+                    // The master thread is already pinned for the whole kernel and keeps its affinity.
+                    dev::cpu::detail::ScopedThreadPin const threadPin(threadAffinity, static_cast<std::size_t>(::omp_get_thread_num()));
 #if ALPAKA_DEBUG >= ALPAKA_DEBUG_MINIMAL
                     // The first thread does some debug logging.
                     if(::omp_get_thread_num() == 0)
@@ -192,14 +207,16 @@ namespace alpaka
                     for(TSize i = 0; i < numBlocksInGrid; ++i)
 #endif
                     {
-                        acc.m_gridBlockIdx =
-                            core::mapIdx<TDim::value>(
 #if _OPENMP < 200805
-                                Vec<dim::DimInt<1u>, TSize>(static_cast<TSize>(i)),
+                        TSize const blockIdx(static_cast<TSize>(i));
 #else
-                                Vec<dim::DimInt<1u>, TSize>(i),
+                        TSize const blockIdx(i);
 #endif
-                                gridBlockExtent);
+                        // Positions outside of the grid are skipped.
+                        if(!blockTraversalMapper.mapPosition(static_cast<std::size_t>(blockIdx), acc.m_gridBlockIdx))
+                        {
+                            continue;
+                        }
 
                         boundKernelFnObj(
                             acc);
@@ -31,8 +31,11 @@
 // Implementation details.
 #include <alpaka/acc/AccCpuOmp2Threads.hpp>     // acc:AccCpuOmp2Threads
 #include <alpaka/dev/DevCpu.hpp>                // dev::DevCpu
+#include <alpaka/dev/cpu/Affinity.hpp>          // dev::cpu::detail::pinCurrentThread
 #include <alpaka/kernel/Traits.hpp>             // kernel::getBlockSharedExternMemSizeBytes
 #include <alpaka/workdiv/WorkDivMembers.hpp>    // workdiv::WorkDivMembers
+#include <alpaka/profiler/Profiler.hpp>         // ALPAKA_PROFILER_KERNEL_SCOPE
+#include <alpaka/exec/BlockTraversal.hpp>       // exec::detail::ndLoopBlockTraversal
 
 #include <alpaka/core/OpenMp.hpp>
 #include <alpaka/core/NdLoop.hpp>               // core::NdLoop
@@ -135,6 +138,8 @@ namespace alpaka
                 std::cout << BOOST_CURRENT_FUNCTION
                     << " BlockSharedExternMemSizeBytes: " << blockSharedExternMemSizeBytes << " B" << std::endl;
 #endif
+                ALPAKA_PROFILER_KERNEL_SCOPE(TKernelFnObj, *this, blockSharedExternMemSizeBytes, acc::AccCpuOmp2Threads<TDim, TSize>);
+
                 // Bind all arguments except the accelerator.
                 // TODO: With C++14 we could create a perfectly argument forwarding function object within the constructor.
                 auto const boundKernelFnObj(
@@ -167,8 +172,13 @@ namespace alpaka
                 int const ompIsDynamic(::omp_get_dynamic());
                 ::omp_set_dynamic(0);
 
-                // Execute the blocks serially.
-                core::ndLoopIncIdx(
+                // The OpenMP threads are pinned according to the affinity of the stream executing the kernel.
+                // The calling thread is the master thread. It is only pinned for the duration of the kernel.
+                auto const & threadAffinity(dev::cpu::detail::getCurrentThreadAffinity());
+                dev::cpu::detail::ScopedThreadPin const scopedThreadPin(threadAffinity, 0u);
+
+                // Execute the blocks serially in the order of the block traversal.
+                exec::detail::ndLoopBlockTraversal(
                     gridBlockExtent,
                     [&](Vec<TDim, TSize> const & gridBlockIdx)
                     {
@@ -182,6 +192,9 @@ namespace alpaka
                         // Therefore we use 'omp parallel' with the specified number of threads in a block.
                         #pragma omp parallel num_threads(iblockThreadCount)
                         {
+                            // The worker threads of the OpenMP runtime are only pinned for the duration of the parallel region.
+                            // The master thread is already pinned for the whole kernel and keeps its affinity.
+                            dev::cpu::detail::ScopedThreadPin const threadPin(threadAffinity, static_cast<std::size_t>(::omp_get_thread_num()));
 #if ALPAKA_DEBUG >= ALPAKA_DEBUG_MINIMAL
                             // GCC 5.1 fails with:
                             // error: redeclaration of const int& iblockThreadCount
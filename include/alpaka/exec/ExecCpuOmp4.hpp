@@ -33,6 +33,7 @@
 #include <alpaka/dev/DevCpu.hpp>                // dev::DevCpu
 #include <alpaka/kernel/Traits.hpp>             // kernel::getBlockSharedExternMemSizeBytes
 #include <alpaka/workdiv/WorkDivMembers.hpp>    // workdiv::WorkDivMembers
+#include <alpaka/profiler/Profiler.hpp>         // ALPAKA_PROFILER_KERNEL_SCOPE
 
 #include <alpaka/core/OpenMp.hpp>
 #include <alpaka/core/MapIdx.hpp>               // core::mapIdx
@@ -135,6 +136,8 @@ namespace alpaka
                 std::cout << BOOST_CURRENT_FUNCTION
                     << " BlockSharedExternMemSizeBytes: " << blockSharedExternMemSizeBytes << " B" << std::endl;
 #endif
+                ALPAKA_PROFILER_KERNEL_SCOPE(TKernelFnObj, *this, blockSharedExternMemSizeBytes, acc::AccCpuOmp4<TDim, TSize>);
+
                 // Bind all arguments except the accelerator.
                 // TODO: With C++14 we could create a perfectly argument forwarding function object within the constructor.
                 auto const boundKernelFnObj(
@@ -33,6 +33,8 @@
 #include <alpaka/dev/DevCpu.hpp>                // dev::DevCpu
 #include <alpaka/kernel/Traits.hpp>             // kernel::getBlockSharedExternMemSizeBytes
 #include <alpaka/workdiv/WorkDivMembers.hpp>    // workdiv::WorkDivMembers
+#include <alpaka/profiler/Profiler.hpp>         // ALPAKA_PROFILER_KERNEL_SCOPE
+#include <alpaka/exec/BlockTraversal.hpp>       // exec::detail::ndLoopBlockTraversal
 
 #include <alpaka/core/NdLoop.hpp>               // core::NdLoop
 #include <alpaka/core/ApplyTuple.hpp>           // core::Apply
@@ -134,6 +136,8 @@ namespace alpaka
                 std::cout << BOOST_CURRENT_FUNCTION
                     << " BlockSharedExternMemSizeBytes: " << blockSharedExternMemSizeBytes << " B" << std::endl;
 #endif
+                ALPAKA_PROFILER_KERNEL_SCOPE(TKernelFnObj, *this, blockSharedExternMemSizeBytes, acc::AccCpuSerial<TDim, TSize>);
+
                 // Bind all arguments except the accelerator.
                 // TODO: With C++14 we could create a perfectly argument forwarding function object within the constructor.
                 auto const boundKernelFnObj(
@@ -161,8 +165,8 @@ namespace alpaka
                 // There is only ever one thread in a block in the serial accelerator.
                 assert(blockThreadExtent.prod() == 1u);
 
-                // Execute the blocks serially.
-                core::ndLoopIncIdx(
+                // Execute the blocks serially in the order of the block traversal.
+                exec::detail::ndLoopBlockTraversal(
                     gridBlockExtent,
                     [&](Vec<TDim, TSize> const & blockThreadIdx)
                     {
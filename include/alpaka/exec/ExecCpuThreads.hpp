@@ -31,8 +31,11 @@
 // Implementation details.
 #include <alpaka/acc/AccCpuThreads.hpp>         // acc:AccCpuThreads
 #include <alpaka/dev/DevCpu.hpp>                // dev::DevCpu
+#include <alpaka/dev/cpu/Affinity.hpp>          // dev::cpu::detail::pinCurrentThread
 #include <alpaka/kernel/Traits.hpp>             // kernel::getBlockSharedExternMemSizeBytes
 #include <alpaka/workdiv/WorkDivMembers.hpp>    // workdiv::WorkDivMembers
+#include <alpaka/profiler/Profiler.hpp>         // ALPAKA_PROFILER_KERNEL_SCOPE
+#include <alpaka/exec/BlockScheduling.hpp>      // exec::detail::BlockScheduler
 
 #include <alpaka/core/ConcurrentExecPool.hpp>   // core::ConcurrentExecPool
 #include <alpaka/core/NdLoop.hpp>               // core::NdLoop
@@ -42,6 +45,7 @@
 #include <boost/align.hpp>                      // boost::aligned_alloc
 
 #include <algorithm>                            // std::for_each
+#include <mutex>                                // std::mutex
 #include <thread>                               // std::thread
 #include <vector>                               // std::vector
 #include <tuple>                                // std::tuple
@@ -163,8 +167,56 @@ namespace alpaka
                 std::cout << BOOST_CURRENT_FUNCTION
                     << " BlockSharedExternMemSizeBytes: " << blockSharedExternMemSizeBytes << " B" << std::endl;
 #endif
+                ALPAKA_PROFILER_KERNEL_SCOPE(TKernelFnObj, *this, blockSharedExternMemSizeBytes, acc::AccCpuThreads<TDim, TSize>);
+
+                // The block threads are pinned according to the affinity of the stream executing the kernel.
+                auto const & threadAffinity(dev::cpu::detail::getCurrentThreadAffinity());
+                auto const blockThreadCount(blockThreadExtent.prod());
+
+                // If the CPUs can hold multiple blocks at once, multiple workers execute blocks in parallel.
+                auto const blockSchedule(exec::getBlockSchedule());
+                exec::detail::BlockScheduler<TDim, TSize> blockScheduler(
+                    gridBlockExtent,
+                    blockSchedule,
+                    exec::detail::getBlockWorkerCount(
+                        blockSchedule,
+                        static_cast<std::size_t>(blockThreadCount),
+                        threadAffinity,
+                        static_cast<std::size_t>(gridBlockExtent.prod())));
+
+                // The atomic operations of all blocks of this grid are serialized by this mutex.
+                std::mutex mtxAtomic;
+
+                exec::detail::runBlockWorkers(
+                    blockScheduler,
+                    [&](std::size_t const & workerIdx)
+                    {
+                        this->workerExecHost(
+                            workerIdx,
+                            blockScheduler,
+                            blockThreadExtent,
+                            blockSharedExternMemSizeBytes,
+                            threadAffinity,
+                            mtxAtomic);
+                    });
+            }
+
+        private:
+            //-----------------------------------------------------------------------------
+            //! The function executed by each worker executing blocks.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto workerExecHost(
+                std::size_t const & workerIdx,
+                exec::detail::BlockScheduler<TDim, TSize> & blockScheduler,
+                Vec<TDim, TSize> const & blockThreadExtent,
+                std::size_t const & blockSharedExternMemSizeBytes,
+                dev::cpu::ThreadAffinity const & threadAffinity,
+                std::mutex & mtxAtomic) const
+            -> void
+            {
                 acc::AccCpuThreads<TDim, TSize> acc(
-                    *static_cast<workdiv::WorkDivMembers<TDim, TSize> const *>(this));
+                    *static_cast<workdiv::WorkDivMembers<TDim, TSize> const *>(this),
+                    mtxAtomic);
 
                 if(blockSharedExternMemSizeBytes > 0u)
                 {
@@ -173,8 +225,15 @@ namespace alpaka
                             boost::alignment::aligned_alloc(16u, blockSharedExternMemSizeBytes)));
                 }
 
+                // The threads of the workers are pinned to consecutive CPUs of the affinity.
                 auto const blockThreadCount(blockThreadExtent.prod());
-                ThreadPool threadPool(blockThreadCount, blockThreadCount);
+                ThreadPool threadPool(
+                    blockThreadCount,
+                    blockThreadCount,
+                    [&threadAffinity, workerIdx, blockThreadCount](TSize blockThreadIdx)
+                    {
+                        dev::cpu::detail::pinCurrentThread(threadAffinity, workerIdx * static_cast<std::size_t>(blockThreadCount) + static_cast<std::size_t>(blockThreadIdx));
+                    });
 
                 // Bind the kernel and its arguments to the grid block function.
                 auto const boundGridBlockExecHost(
@@ -193,16 +252,14 @@ namespace alpaka
                         },
                         m_args));
 
-                // Execute the blocks serially.
-                core::ndLoopIncIdx(
-                    gridBlockExtent,
+                // Execute the blocks assigned to this worker in the order of the block traversal.
+                blockScheduler.forEachBlock(
+                    workerIdx,
                     boundGridBlockExecHost);
 
                 // After all blocks have been processed, the external shared memory has to be deleted.
                 acc.m_externalSharedMem.reset();
             }
-
-        private:
             //-----------------------------------------------------------------------------
             //! The function executed for each grid block.
             //-----------------------------------------------------------------------------
@@ -0,0 +1,434 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <alpaka/idx/Traits.hpp>            // idx::getIdx
+#include <alpaka/workdiv/Traits.hpp>        // workdiv::getWorkDiv
+
+#include <alpaka/core/MapIdx.hpp>           // core::mapIdx
+#include <alpaka/core/Positioning.hpp>      // origin::Grid/Thread, unit::Threads/Elems
+#include <alpaka/vec/Vec.hpp>               // Vec
+#include <alpaka/core/Common.hpp>           // ALPAKA_FN_HOST_ACC
+
+namespace alpaka
+{
+    namespace idx
+    {
+        //#############################################################################
+        //! The contiguous range [begin, end) of linear element indices.
+        //!
+        //! The elements are visited one after another so the range can be used as the bounds of a plain loop the compiler can vectorise.
+        //#############################################################################
+        template<
+            typename TSize>
+        class ElemRangeContiguous
+        {
+        public:
+            //! The elements of the range are adjacent in memory.
+            static constexpr bool isContiguous = true;
+
+            //#############################################################################
+            //! The iterator over the element indices.
+            //#############################################################################
+            class Iterator
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC explicit Iterator(
+                    TSize const & idx) :
+                        m_idx(idx)
+                {}
+                //-----------------------------------------------------------------------------
+                //! \return The current element index.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC auto operator*() const
+                -> TSize
+                {
+                    return m_idx;
+                }
+                //-----------------------------------------------------------------------------
+                //! Advances to the next element.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC auto operator++()
+                -> Iterator &
+                {
+                    ++m_idx;
+                    return *this;
+                }
+                //-----------------------------------------------------------------------------
+                //! Inequality comparison operator.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC auto operator!=(
+                    Iterator const & rhs) const
+                -> bool
+                {
+                    return m_idx != rhs.m_idx;
+                }
+
+            private:
+                TSize m_idx;
+            };
+
+        public:
+            //-----------------------------------------------------------------------------
+            //! Constructor.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC ElemRangeContiguous(
+                TSize const & begin,
+                TSize const & end) :
+                    m_begin(begin),
+                    m_end((end > begin) ? end : begin)
+            {}
+
+            //-----------------------------------------------------------------------------
+            //! \return The iterator to the first element.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto begin() const
+            -> Iterator
+            {
+                return Iterator(m_begin);
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The iterator behind the last element.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto end() const
+            -> Iterator
+            {
+                return Iterator(m_end);
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The index of the first element.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto getBegin() const
+            -> TSize
+            {
+                return m_begin;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The index behind the last element.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto getEnd() const
+            -> TSize
+            {
+                return m_end;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The number of elements in the range.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto size() const
+            -> TSize
+            {
+                return m_end - m_begin;
+            }
+
+        private:
+            TSize m_begin;
+            TSize m_end;
+        };
+
+        //#############################################################################
+        //! The grid-strided range of linear element indices in [0, end).
+        //!
+        //! The range consists of contiguous chunks of chunkSize elements.
+        //! The first chunk starts at begin, each following one stride elements after the previous one.
+        //! This lets a fixed grid cover an arbitrary number of elements.
+        //#############################################################################
+        template<
+            typename TSize>
+        class ElemRangeGridStrided
+        {
+        public:
+            //! Consecutive elements of the range can be a stride apart.
+            static constexpr bool isContiguous = false;
+
+            //#############################################################################
+            //! The iterator over the element indices.
+            //#############################################################################
+            class Iterator
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC Iterator(
+                    TSize const & idx,
+                    ElemRangeGridStrided const & range) :
+                        m_idx(idx),
+                        m_chunkEnd(range.getChunkEnd(idx)),
+                        m_chunkSize(range.m_chunkSize),
+                        m_stride(range.m_stride),
+                        m_end(range.m_end)
+                {}
+                //-----------------------------------------------------------------------------
+                //! \return The current element index.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC auto operator*() const
+                -> TSize
+                {
+                    return m_idx;
+                }
+                //-----------------------------------------------------------------------------
+                //! Advances to the next element, jumping to the next chunk at the end of the current one.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC auto operator++()
+                -> Iterator &
+                {
+                    ++m_idx;
+                    if(m_idx == m_chunkEnd)
+                    {
+                        // Jump to the next chunk. Elements behind the end of the range are clamped to the end iterator.
+                        auto const chunkBegin(m_chunkEnd - m_chunkSize);
+                        m_idx = ((m_end - chunkBegin) > m_stride) ? chunkBegin + m_stride : m_end;
+                        m_chunkEnd = ((m_end - m_idx) > m_chunkSize) ? m_idx + m_chunkSize : m_end;
+                    }
+                    return *this;
+                }
+                //-----------------------------------------------------------------------------
+                //! Inequality comparison operator.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC auto operator!=(
+                    Iterator const & rhs) const
+                -> bool
+                {
+                    return m_idx != rhs.m_idx;
+                }
+
+            private:
+                TSize m_idx;
+                TSize m_chunkEnd;
+                TSize m_chunkSize;
+                TSize m_stride;
+                TSize m_end;
+            };
+
+            //#############################################################################
+            //! The iterator over the contiguous chunks.
+            //#############################################################################
+            class ChunkIterator
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC ChunkIterator(
+                    TSize const & chunkBegin,
+                    ElemRangeGridStrided const & range) :
+                        m_chunkBegin(chunkBegin),
+                        m_range(range)
+                {}
+                //-----------------------------------------------------------------------------
+                //! \return The current chunk.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC auto operator*() const
+                -> ElemRangeContiguous<TSize>
+                {
+                    return ElemRangeContiguous<TSize>(m_chunkBegin, m_range.getChunkEnd(m_chunkBegin));
+                }
+                //-----------------------------------------------------------------------------
+                //! Advances to the next chunk.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC auto operator++()
+                -> ChunkIterator &
+                {
+                    m_chunkBegin = ((m_range.m_end - m_chunkBegin) > m_range.m_stride) ? m_chunkBegin + m_range.m_stride : m_range.m_end;
+                    return *this;
+                }
+                //-----------------------------------------------------------------------------
+                //! Inequality comparison operator.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC auto operator!=(
+                    ChunkIterator const & rhs) const
+                -> bool
+                {
+                    return m_chunkBegin != rhs.m_chunkBegin;
+                }
+
+            private:
+                TSize m_chunkBegin;
+                ElemRangeGridStrided m_range;
+            };
+
+            //#############################################################################
+            //! The range of the contiguous chunks.
+            //#############################################################################
+            class Chunks
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC explicit Chunks(
+                    ElemRangeGridStrided const & range) :
+                        m_range(range)
+                {}
+                //-----------------------------------------------------------------------------
+                //! \return The iterator to the first chunk.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC auto begin() const
+                -> ChunkIterator
+                {
+                    return ChunkIterator(m_range.m_begin, m_range);
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The iterator behind the last chunk.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST_ACC auto end() const
+                -> ChunkIterator
+                {
+                    return ChunkIterator(m_range.m_end, m_range);
+                }
+
+            private:
+                ElemRangeGridStrided m_range;
+            };
+
+        public:
+            //-----------------------------------------------------------------------------
+            //! Constructor.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC ElemRangeGridStrided(
+                TSize const & begin,
+                TSize const & chunkSize,
+                TSize const & stride,
+                TSize const & end) :
+                    m_begin((begin < end) ? begin : end),
+                    m_chunkSize(chunkSize),
+                    m_stride(stride),
+                    m_end(end)
+            {}
+
+            //-----------------------------------------------------------------------------
+            //! \return The iterator to the first element.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto begin() const
+            -> Iterator
+            {
+                return Iterator(m_begin, *this);
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The iterator behind the last element.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto end() const
+            -> Iterator
+            {
+                return Iterator(m_end, *this);
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The range of the contiguous chunks making up this range.
+            //! Each chunk can be iterated by a plain loop the compiler can vectorise.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto chunks() const
+            -> Chunks
+            {
+                return Chunks(*this);
+            }
+
+        private:
+            //-----------------------------------------------------------------------------
+            //! \return The end of the chunk starting at chunkBegin.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST_ACC auto getChunkEnd(
+                TSize const & chunkBegin) const
+            -> TSize
+            {
+                return ((m_end - chunkBegin) > m_chunkSize) ? chunkBegin + m_chunkSize : m_end;
+            }
+
+        private:
+            TSize m_begin;
+            TSize m_chunkSize;
+            TSize m_stride;
+            TSize m_end;
+        };
+
+        namespace detail
+        {
+            //-----------------------------------------------------------------------------
+            //! \return The linearized index of the current thread in the grid.
+            //-----------------------------------------------------------------------------
+            ALPAKA_NO_HOST_ACC_WARNING
+            template<
+                typename TAcc>
+            ALPAKA_FN_HOST_ACC auto getGridThreadIdxLinear(
+                TAcc const & acc)
+            -> size::Size<TAcc>
+            {
+                return
+                    core::mapIdx<1u>(
+                        idx::getIdx<Grid, Threads>(acc),
+                        workdiv::getWorkDiv<Grid, Threads>(acc))[0u];
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //! \return The contiguous range of linear element indices in [0, numElements) handled by the current thread.
+        //!
+        //! The elements are split into one chunk of getWorkDiv<Thread, Elems>(acc).prod() elements per thread in the order of the linearized grid thread index.
+        //! The range of the last threads is shortened or empty if the grid covers more than numElements elements.
+        //! Elements not covered by the grid are not visited. Use elementsGridStrided for grids smaller than the problem.
+        //-----------------------------------------------------------------------------
+        ALPAKA_NO_HOST_ACC_WARNING
+        template<
+            typename TAcc,
+            typename TSize>
+        ALPAKA_FN_HOST_ACC auto elements(
+            TAcc const & acc,
+            TSize const & numElements)
+        -> ElemRangeContiguous<TSize>
+        {
+            auto const threadElemCount(static_cast<TSize>(workdiv::getWorkDiv<Thread, Elems>(acc).prod()));
+            auto const begin(static_cast<TSize>(detail::getGridThreadIdxLinear(acc)) * threadElemCount);
+            return
+                ElemRangeContiguous<TSize>(
+                    begin,
+                    ((numElements > begin) && ((numElements - begin) > threadElemCount)) ? begin + threadElemCount : numElements);
+        }
+        //-----------------------------------------------------------------------------
+        //! \return The grid-strided range of linear element indices in [0, numElements) handled by the current thread.
+        //!
+        //! Each thread handles chunks of getWorkDiv<Thread, Elems>(acc).prod() contiguous elements.
+        //! After each chunk the thread jumps ahead by the number of elements covered by the whole grid.
+        //! This covers all elements for any grid size. With one element per thread, neighbouring threads access neighbouring elements which coalesces the memory accesses on CUDA.
+        //-----------------------------------------------------------------------------
+        ALPAKA_NO_HOST_ACC_WARNING
+        template<
+            typename TAcc,
+            typename TSize>
+        ALPAKA_FN_HOST_ACC auto elementsGridStrided(
+            TAcc const & acc,
+            TSize const & numElements)
+        -> ElemRangeGridStrided<TSize>
+        {
+            auto const threadElemCount(static_cast<TSize>(workdiv::getWorkDiv<Thread, Elems>(acc).prod()));
+            auto const gridThreadCount(static_cast<TSize>(workdiv::getWorkDiv<Grid, Threads>(acc).prod()));
+            return
+                ElemRangeGridStrided<TSize>(
+                    static_cast<TSize>(detail::getGridThreadIdxLinear(acc)) * threadElemCount,
+                    threadElemCount,
+                    gridThreadCount * threadElemCount,
+                    numElements);
+        }
+    }
+}
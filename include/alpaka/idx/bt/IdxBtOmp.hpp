@@ -24,7 +24,7 @@
 #include <alpaka/idx/Traits.hpp>            // idx::GetIdx
 
 #include <alpaka/core/OpenMp.hpp>
-#include <alpaka/core/MapIdx.hpp>           // core::mapIdx
+#include <alpaka/core/FastDivisor.hpp>      // core::FastIdxMapper, core::mapIdx
 
 #include <boost/core/ignore_unused.hpp>     // boost::ignore_unused
 
@@ -48,7 +48,10 @@ namespace alpaka
                 //-----------------------------------------------------------------------------
                 //! Constructor.
                 //-----------------------------------------------------------------------------
-                ALPAKA_FN_ACC_NO_CUDA IdxBtOmp() = default;
+                ALPAKA_FN_ACC_NO_CUDA IdxBtOmp(
+                    Vec<TDim, TSize> const & blockThreadExtent) :
+                        m_blockThreadIdxMapper(blockThreadExtent)
+                {}
                 //-----------------------------------------------------------------------------
                 //! Copy constructor.
                 //-----------------------------------------------------------------------------
@@ -69,6 +72,10 @@ namespace alpaka
                 //! Destructor.
                 //-----------------------------------------------------------------------------
                 ALPAKA_FN_ACC_NO_CUDA /*virtual*/ ~IdxBtOmp() = default;
+
+            public:
+                //! Maps the OpenMP thread number to the index of the thread in the block without integer divisions.
+                core::FastIdxMapper<TDim, TSize> const m_blockThreadIdxMapper;
             };
         }
     }
@@ -115,13 +122,12 @@ namespace alpaka
                     TWorkDiv const & workDiv)
                 -> Vec<TDim, TSize>
                 {
-                    boost::ignore_unused(idx);
+                    boost::ignore_unused(workDiv);
                     // We assume that the thread id is positive.
                     assert(::omp_get_thread_num()>=0);
-                    // \TODO: Would it be faster to precompute the index and cache it inside an array?
                     return core::mapIdx<TDim::value>(
                         Vec<dim::DimInt<1u>, TSize>(static_cast<TSize>(::omp_get_thread_num())),
-                        workdiv::getWorkDiv<Block, Threads>(workDiv));
+                        idx.m_blockThreadIdxMapper);
                 }
             };
         }
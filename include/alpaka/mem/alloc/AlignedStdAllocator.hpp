@@ -0,0 +1,157 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/mem/alloc/AllocCpuBoostAligned.hpp>   // mem::alloc::AllocCpuBoostAligned
+
+#include <alpaka/core/Common.hpp>       // ALPAKA_FN_HOST
+
+#include <cstddef>                      // std::size_t
+#include <new>                          // std::bad_alloc
+#include <type_traits>                  // std::integral_constant
+
+namespace alpaka
+{
+    namespace mem
+    {
+        namespace alloc
+        {
+            //#############################################################################
+            //! A standard library allocator returning aligned memory.
+            //!
+            //! The memory is allocated by the same aligned allocator that is used by BufCpu.
+            //! A std::vector using this allocator can be passed as a buffer to kernels and memory operations
+            //! that then know the alignment of its data at compile time (see mem::view::Alignment).
+            //!
+            //! \tparam T The element type.
+            //! \tparam TAlignment The alignment in bytes. The default is the width of the widest SIMD registers (AVX-512) and of a cache line.
+            //#############################################################################
+            template<
+                typename T,
+                std::size_t TAlignment = 64u>
+            class AlignedStdAllocator
+            {
+                static_assert(
+                    (TAlignment & (TAlignment - 1u)) == 0u,
+                    "The alignment is required to be a power of two!");
+
+            public:
+                using value_type = T;
+                using pointer = T *;
+                using const_pointer = T const *;
+                using reference = T &;
+                using const_reference = T const &;
+                using size_type = std::size_t;
+                using difference_type = std::ptrdiff_t;
+
+                //! The alignment actually used which is at least the alignment of the element type.
+                static constexpr std::size_t alignment = (TAlignment > alignof(T)) ? TAlignment : alignof(T);
+
+                //#############################################################################
+                //! The allocator for other element types.
+                //#############################################################################
+                template<
+                    typename U>
+                struct rebind
+                {
+                    using other = AlignedStdAllocator<U, TAlignment>;
+                };
+
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST AlignedStdAllocator() noexcept = default;
+                //-----------------------------------------------------------------------------
+                //! Converting constructor.
+                //-----------------------------------------------------------------------------
+                template<
+                    typename U>
+                ALPAKA_FN_HOST AlignedStdAllocator(
+                    AlignedStdAllocator<U, TAlignment> const &) noexcept
+                {}
+
+                //-----------------------------------------------------------------------------
+                //! \return The pointer to the allocated memory for n elements.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto allocate(
+                    std::size_t const n)
+                -> T *
+                {
+                    if(n == 0u)
+                    {
+                        return nullptr;
+                    }
+                    T * const p(
+                        mem::alloc::alloc<T>(
+                            AllocCpuBoostAligned<std::integral_constant<std::size_t, alignment>>(),
+                            n));
+                    if(p == nullptr)
+                    {
+                        throw std::bad_alloc();
+                    }
+                    return p;
+                }
+                //-----------------------------------------------------------------------------
+                //! Frees the memory.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto deallocate(
+                    T * const p,
+                    std::size_t const) noexcept
+                -> void
+                {
+                    mem::alloc::free(
+                        AllocCpuBoostAligned<std::integral_constant<std::size_t, alignment>>(),
+                        p);
+                }
+            };
+
+            //-----------------------------------------------------------------------------
+            //! All instances are interchangeable.
+            //-----------------------------------------------------------------------------
+            template<
+                typename T,
+                typename U,
+                std::size_t TAlignment>
+            ALPAKA_FN_HOST auto operator==(
+                AlignedStdAllocator<T, TAlignment> const &,
+                AlignedStdAllocator<U, TAlignment> const &) noexcept
+            -> bool
+            {
+                return true;
+            }
+            //-----------------------------------------------------------------------------
+            //! All instances are interchangeable.
+            //-----------------------------------------------------------------------------
+            template<
+                typename T,
+                typename U,
+                std::size_t TAlignment>
+            ALPAKA_FN_HOST auto operator!=(
+                AlignedStdAllocator<T, TAlignment> const &,
+                AlignedStdAllocator<U, TAlignment> const &) noexcept
+            -> bool
+            {
+                return false;
+            }
+        }
+    }
+}
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <alpaka/dev/Traits.hpp>            // dev::traits::DevType
+#include <alpaka/dev/cpu/MemStats.hpp>      // dev::cpu::detail::getMemStatsCounters
 #include <alpaka/mem/buf/Traits.hpp>        // mem::buf::Alloc, ...
 
 #include <alpaka/vec/Vec.hpp>               // Vec
@@ -32,9 +33,21 @@
 #endif
 
 #include <alpaka/mem/alloc/AllocCpuBoostAligned.hpp>
+#include <alpaka/mem/buf/cpu/PageLock.hpp>  // mem::buf::cpu::PinMode, mem::buf::cpu::detail::lockPages
+#include <alpaka/mem/buf/cpu/NumaBind.hpp>  // mem::buf::cpu::detail::bindPagesToNumaNode
 
+#include <boost/predef.h>                   // BOOST_OS_UNIX
+
+#if BOOST_OS_UNIX
+    #include <sys/mman.h>                   // mmap, munmap
+#endif
+
+#include <atomic>                           // std::atomic
 #include <cassert>                          // assert
+#include <cstring>                          // std::memset
+#include <limits>                           // std::numeric_limits
 #include <memory>                           // std::shared_ptr
+#include <new>                              // std::bad_alloc
 
 namespace alpaka
 {
@@ -50,6 +63,25 @@ namespace alpaka
             {
                 namespace detail
                 {
+                    //-----------------------------------------------------------------------------
+                    //! The alignment of the memory of a CPU buffer.
+                    //-----------------------------------------------------------------------------
+                    static constexpr std::size_t bufCpuAlignmentBytes = 16u;
+                    //-----------------------------------------------------------------------------
+                    //! Zeroed allocations of at least this size are anonymous memory mappings.
+                    //! The pages are mapped to the shared zero page until they are written for the first time.
+                    //-----------------------------------------------------------------------------
+                    static constexpr std::size_t bufCpuZeroedMmapThresholdBytes = 128u << 10u;
+
+                    //#############################################################################
+                    //! The way the memory of a CPU buffer has been allocated.
+                    //#############################################################################
+                    enum class BufCpuAllocKind
+                    {
+                        Aligned,    //!< Allocated with the aligned allocator.
+                        Mmap        //!< Allocated zeroed as an anonymous memory mapping.
+                    };
+
                     //#############################################################################
                     //! The CPU memory buffer.
                     //#############################################################################
@@ -58,7 +90,7 @@ namespace alpaka
                         typename TDim,
                         typename TSize>
                     class BufCpuImpl :
-                        public mem::alloc::AllocCpuBoostAligned<std::integral_constant<std::size_t, 16u>>
+                        public mem::alloc::AllocCpuBoostAligned<std::integral_constant<std::size_t, bufCpuAlignmentBytes>>
                     {
                     public:
                         //-----------------------------------------------------------------------------
@@ -69,23 +101,58 @@ namespace alpaka
                         ALPAKA_FN_HOST BufCpuImpl(
                             dev::DevCpu const & dev,
                             TExtent const & extent) :
-                                mem::alloc::AllocCpuBoostAligned<std::integral_constant<std::size_t, 16u>>(),
+                                mem::alloc::AllocCpuBoostAligned<std::integral_constant<std::size_t, bufCpuAlignmentBytes>>(),
                                 m_dev(dev),
                                 m_extentElements(extent::getExtentVecEnd<TDim>(extent)),
+                                m_allocKind(BufCpuAllocKind::Aligned),
                                 m_pMem(mem::alloc::alloc<TElem>(*this, computeElementCount(extent))),
-                                m_pitchBytes(static_cast<TSize>(extent::getWidth(extent) * sizeof(TElem)))
-#if defined(ALPAKA_ACC_GPU_CUDA_ENABLED) && defined(__CUDACC__)
-                                ,m_bPinned(false)
+                                m_pitchBytes(static_cast<TSize>(extent::getWidth(extent) * sizeof(TElem))),
+                                m_bZeroed(false),
+                                m_bPinned(false)
+                        {
+                            ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                            checkExtent<TExtent>();
+                            bindToNumaNode(dev);
+
+                            dev::cpu::detail::getMemStatsCounters(m_dev).onAlloc(getSizeBytes());
+
+#if ALPAKA_DEBUG >= ALPAKA_DEBUG_FULL
+                            std::cout << BOOST_CURRENT_FUNCTION
+                                << " e: " << m_extentElements
+                                << " ptr: " << static_cast<void *>(m_pMem)
+                                << " pitch: " << m_pitchBytes
+                                << std::endl;
 #endif
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! Constructor allocating memory that is already zeroed.
+                        //!
+                        //! Large allocations are anonymous memory mappings so the zeroing cost is moved onto the first touch of each page.
+                        //! Small allocations are zeroed by this constructor.
+                        //-----------------------------------------------------------------------------
+                        template<
+                            typename TExtent>
+                        ALPAKA_FN_HOST BufCpuImpl(
+                            dev::DevCpu const & dev,
+                            TExtent const & extent,
+                            std::true_type const & zeroed) :
+                                mem::alloc::AllocCpuBoostAligned<std::integral_constant<std::size_t, bufCpuAlignmentBytes>>(),
+                                m_dev(dev),
+                                m_extentElements(extent::getExtentVecEnd<TDim>(extent)),
+                                m_allocKind(getZeroedAllocKind(computeElementCount(extent))),
+                                m_pMem(allocZeroed(m_allocKind, computeElementCount(extent))),
+                                m_pitchBytes(static_cast<TSize>(extent::getWidth(extent) * sizeof(TElem))),
+                                m_bZeroed(true),
+                                m_bPinned(false)
                         {
+                            boost::ignore_unused(zeroed);
                             ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
 
-                            static_assert(
-                                TDim::value == dim::Dim<TExtent>::value,
-                                "The dimensionality of TExtent and the dimensionality of the TDim template parameter have to be identical!");
-                            static_assert(
-                                std::is_same<TSize, size::Size<TExtent>>::value,
-                                "The size type of TExtent and the TSize template parameter have to be identical!");
+                            checkExtent<TExtent>();
+                            bindToNumaNode(dev);
+
+                            dev::cpu::detail::getMemStatsCounters(m_dev).onAlloc(getSizeBytes());
 
 #if ALPAKA_DEBUG >= ALPAKA_DEBUG_FULL
                             std::cout << BOOST_CURRENT_FUNCTION
@@ -118,15 +185,123 @@ namespace alpaka
                         {
                             ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
 
-#if defined(ALPAKA_ACC_GPU_CUDA_ENABLED) && defined(__CUDACC__)
                             // Unpin this memory if it is currently pinned.
                             mem::buf::unpin(*this);
+                            dev::cpu::detail::getMemStatsCounters(m_dev).onFree(getSizeBytes());
+
+                            switch(m_allocKind)
+                            {
+                            case BufCpuAllocKind::Aligned:
+                                // NOTE: m_pMem is allowed to be a nullptr here.
+                                mem::alloc::free(*this, m_pMem);
+                                break;
+                            case BufCpuAllocKind::Mmap:
+#if BOOST_OS_UNIX
+                                munmap(
+                                    reinterpret_cast<void *>(m_pMem),
+                                    getSizeBytes());
 #endif
-                            // NOTE: m_pMem is allowed to be a nullptr here.
-                            mem::alloc::free(*this, m_pMem);
+                                break;
+                            }
                         }
 
                     private:
+                        //-----------------------------------------------------------------------------
+                        //! \return The number of bytes allocated.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto getSizeBytes() const
+                        -> std::size_t
+                        {
+                            return static_cast<std::size_t>(m_extentElements.prod()) * sizeof(TElem);
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! Checks the extent type.
+                        //-----------------------------------------------------------------------------
+                        template<
+                            typename TExtent>
+                        ALPAKA_FN_HOST static auto checkExtent()
+                        -> void
+                        {
+                            static_assert(
+                                TDim::value == dim::Dim<TExtent>::value,
+                                "The dimensionality of TExtent and the dimensionality of the TDim template parameter have to be identical!");
+                            static_assert(
+                                std::is_same<TSize, size::Size<TExtent>>::value,
+                                "The size type of TExtent and the TSize template parameter have to be identical!");
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! Places the memory on the NUMA node of the device if it has been partitioned to one.
+                        //! The pages are placed when they are touched for the first time.
+                        //-----------------------------------------------------------------------------
+                        template<
+                            typename TDev>
+                        ALPAKA_FN_HOST auto bindToNumaNode(
+                            TDev const & dev) const
+                        -> void
+                        {
+                            auto const & partition(dev.m_spDevCpuImpl->getPartition());
+                            if(!partition.m_cpus.empty() && (partition.m_numaNodeOsId != std::numeric_limits<std::size_t>::max()))
+                            {
+                                bindPagesToNumaNode(m_pMem, getSizeBytes(), partition.m_numaNodeOsId);
+                            }
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! \return The way zeroed memory of the given number of elements is allocated.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST static auto getZeroedAllocKind(
+                            TSize const & elementCount)
+                        -> BufCpuAllocKind
+                        {
+#if BOOST_OS_UNIX
+                            if(static_cast<std::size_t>(elementCount) * sizeof(TElem) >= bufCpuZeroedMmapThresholdBytes)
+                            {
+                                return BufCpuAllocKind::Mmap;
+                            }
+#else
+                            boost::ignore_unused(elementCount);
+#endif
+                            return BufCpuAllocKind::Aligned;
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! \return The zeroed memory of the given number of elements.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto allocZeroed(
+                            BufCpuAllocKind const & allocKind,
+                            TSize const & elementCount)
+                        -> TElem *
+                        {
+                            void * pMem(nullptr);
+                            if(allocKind == BufCpuAllocKind::Mmap)
+                            {
+#if BOOST_OS_UNIX
+                                pMem = mmap(
+                                    nullptr,
+                                    static_cast<std::size_t>(elementCount) * sizeof(TElem),
+                                    PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS,
+                                    -1,
+                                    0);
+                                if(pMem == MAP_FAILED)
+                                {
+                                    pMem = nullptr;
+                                }
+#endif
+                            }
+                            else
+                            {
+                                // std::calloc does not guarantee bufCpuAlignmentBytes so small allocations are zeroed explicitly.
+                                pMem = reinterpret_cast<void *>(mem::alloc::alloc<TElem>(*this, elementCount));
+                                if(pMem != nullptr)
+                                {
+                                    std::memset(pMem, 0, static_cast<std::size_t>(elementCount) * sizeof(TElem));
+                                }
+                            }
+                            if(pMem == nullptr)
+                            {
+                                throw std::bad_alloc();
+                            }
+                            return reinterpret_cast<TElem *>(pMem);
+                        }
                         //-----------------------------------------------------------------------------
                         //! \return The number of elements to allocate.
                         //-----------------------------------------------------------------------------
@@ -145,11 +320,13 @@ namespace alpaka
                     public:
                         dev::DevCpu const m_dev;
                         Vec<TDim, TSize> const m_extentElements;
+                        BufCpuAllocKind const m_allocKind;
                         TElem * const m_pMem;
                         TSize const m_pitchBytes;
-#if defined(ALPAKA_ACC_GPU_CUDA_ENABLED) && defined(__CUDACC__)
+                        //! If the memory is known to be zero.
+                        //! This is reset as soon as a mutable pointer to the memory is handed out.
+                        std::atomic<bool> m_bZeroed;
                         bool m_bPinned;
-#endif
                     };
                 }
             }
@@ -174,6 +351,17 @@ namespace alpaka
                         m_spBufCpuImpl(std::make_shared<cpu::detail::BufCpuImpl<TElem, TDim, TSize>>(dev, extent))
                 {}
                 //-----------------------------------------------------------------------------
+                //! Constructor allocating memory that is already zeroed.
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TExtent>
+                ALPAKA_FN_HOST BufCpu(
+                    dev::DevCpu const & dev,
+                    TExtent const & extent,
+                    std::true_type const & zeroed) :
+                        m_spBufCpuImpl(std::make_shared<cpu::detail::BufCpuImpl<TElem, TDim, TSize>>(dev, extent, zeroed))
+                {}
+                //-----------------------------------------------------------------------------
                 //! Copy constructor.
                 //-----------------------------------------------------------------------------
                 ALPAKA_FN_HOST BufCpu(BufCpu const &) = default;
@@ -193,6 +381,55 @@ namespace alpaka
             public:
                 std::shared_ptr<cpu::detail::BufCpuImpl<TElem, TDim, TSize>> m_spBufCpuImpl;
             };
+
+            namespace cpu
+            {
+                //-----------------------------------------------------------------------------
+                //! Pins the buffer.
+                //!
+                //! Without CUDA the memory is locked into RAM with mlock so accessing it never causes a major page fault.
+                //! The memory locked by all buffers is limited by RLIMIT_MEMLOCK.
+                //! With CUDA the memory is page-locked and registered with the CUDA runtime and the mode is ignored.
+                //!
+                //! \param buf The buffer to pin.
+                //! \param mode If the pages are faulted in immediately or locked on their first touch.
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TElem,
+                    typename TDim,
+                    typename TSize>
+                ALPAKA_FN_HOST auto pin(
+                    BufCpu<TElem, TDim, TSize> & buf,
+                    PinMode const & mode)
+                -> void
+                {
+                    ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                    auto & bufImpl(*buf.m_spBufCpuImpl);
+                    if(!bufImpl.m_bPinned)
+                    {
+#if defined(ALPAKA_ACC_GPU_CUDA_ENABLED) && defined(__CUDACC__)
+                        boost::ignore_unused(mode);
+                        // - cudaHostRegisterDefault:
+                        //   See http://cgi.cs.indiana.edu/~nhusted/dokuwiki/doku.php?id=programming:cudaperformance1
+                        // - cudaHostRegisterPortable:
+                        //   The memory returned by this call will be considered as pinned memory by all CUDA contexts, not just the one that performed the allocation.
+                        ALPAKA_CUDA_RT_CHECK_IGNORE(
+                            cudaHostRegister(
+                                const_cast<void *>(reinterpret_cast<void const *>(bufImpl.m_pMem)),
+                                extent::getProductOfExtent(buf) * sizeof(TElem),
+                                cudaHostRegisterDefault),
+                            cudaErrorHostMemoryAlreadyRegistered);
+#else
+                        cpu::detail::lockPages(
+                            reinterpret_cast<void const *>(bufImpl.m_pMem),
+                            static_cast<std::size_t>(extent::getProductOfExtent(buf)) * sizeof(TElem),
+                            mode);
+#endif
+                        bufImpl.m_bPinned = true;
+                    }
+                }
+            }
         }
     }
 
@@ -360,6 +597,8 @@ namespace alpaka
                         mem::buf::BufCpu<TElem, TDim, TSize> & buf)
                     -> TElem *
                     {
+                        // The memory may be written through the returned pointer.
+                        buf.m_spBufCpuImpl->m_bZeroed = false;
                         return buf.m_spBufCpuImpl->m_pMem;
                     }
                 };
@@ -401,6 +640,8 @@ namespace alpaka
                     {
                         if(dev == dev::getDev(buf))
                         {
+                            // The memory may be written through the returned pointer.
+                            buf.m_spBufCpuImpl->m_bZeroed = false;
                             return buf.m_spBufCpuImpl->m_pMem;
                         }
                         else
@@ -430,6 +671,18 @@ namespace alpaka
                         return pitch.m_spBufCpuImpl->m_pitchBytes;
                     }
                 };
+                //#############################################################################
+                //! The BufCpu alignment trait specialization.
+                //#############################################################################
+                template<
+                    typename TElem,
+                    typename TDim,
+                    typename TSize>
+                struct AlignmentType<
+                    mem::buf::BufCpu<TElem, TDim, TSize>>
+                {
+                    using type = std::integral_constant<std::size_t, mem::buf::cpu::detail::bufCpuAlignmentBytes>;
+                };
             }
         }
         namespace buf
@@ -470,6 +723,60 @@ namespace alpaka
                     }
                 };
                 //#############################################################################
+                //! The BufCpu zeroed memory allocation trait specialization.
+                //#############################################################################
+                template<
+                    typename TElem,
+                    typename TDim,
+                    typename TSize>
+                struct AllocZeroed<
+                    TElem,
+                    TDim,
+                    TSize,
+                    dev::DevCpu>
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    template<
+                        typename TExtent>
+                    ALPAKA_FN_HOST static auto allocZeroed(
+                        dev::DevCpu const & dev,
+                        TExtent const & extent)
+                    -> mem::buf::BufCpu<TElem, TDim, TSize>
+                    {
+                        ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                        return mem::buf::BufCpu<
+                            TElem,
+                            TDim,
+                            TSize>(
+                                dev,
+                                extent,
+                                std::true_type());
+                    }
+                };
+                //#############################################################################
+                //! The BufCpu known zero state trait specialization.
+                //#############################################################################
+                template<
+                    typename TElem,
+                    typename TDim,
+                    typename TSize>
+                struct IsZeroed<
+                    mem::buf::BufCpu<TElem, TDim, TSize>>
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto isZeroed(
+                        mem::buf::BufCpu<TElem, TDim, TSize> const & buf)
+                    -> bool
+                    {
+                        return buf.m_spBufCpuImpl->m_bZeroed;
+                    }
+                };
+                //#############################################################################
                 //! The BufCpu memory mapping trait specialization.
                 //#############################################################################
                 template<
@@ -542,29 +849,7 @@ namespace alpaka
                         mem::buf::BufCpu<TElem, TDim, TSize> & buf)
                     -> void
                     {
-                        ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
-
-                        if(!mem::buf::isPinned(buf))
-                        {
-#if defined(ALPAKA_ACC_GPU_CUDA_ENABLED) && defined(__CUDACC__)
-                            // - cudaHostRegisterDefault:
-                            //   See http://cgi.cs.indiana.edu/~nhusted/dokuwiki/doku.php?id=programming:cudaperformance1
-                            // - cudaHostRegisterPortable:
-                            //   The memory returned by this call will be considered as pinned memory by all CUDA contexts, not just the one that performed the allocation.
-                            ALPAKA_CUDA_RT_CHECK_IGNORE(
-                                cudaHostRegister(
-                                    const_cast<void *>(reinterpret_cast<void const *>(mem::view::getPtrNative(buf))),
-                                    extent::getProductOfExtent(buf) * sizeof(elem::Elem<buf::BufCpu<TElem, TDim, TSize>>),
-                                    cudaHostRegisterDefault),
-                                cudaErrorHostMemoryAlreadyRegistered);
-
-                            buf.m_spBufCpuImpl->m_bPinned = true;
-#else
-                            static_assert(
-                                core::DependentFalseType<TElem>::value,
-                                "Memory pinning of BufCpu is not implemented when CUDA is not enabled!");
-#endif
-                        }
+                        mem::buf::cpu::pin(buf, mem::buf::cpu::PinMode::Prefault);
                     }
                 };
                 //#############################################################################
@@ -613,13 +898,12 @@ namespace alpaka
                                 cudaHostUnregister(
                                     const_cast<void *>(reinterpret_cast<void const *>(bufImpl.m_pMem))),
                                 cudaErrorHostMemoryNotRegistered);
-
-                            bufImpl.m_bPinned = false;
 #else
-                            static_assert(
-                                core::DependentFalseType<TElem>::value,
-                                "Memory unpinning of BufCpu is not implemented when CUDA is not enabled!");
+                            mem::buf::cpu::detail::unlockPages(
+                                reinterpret_cast<void const *>(bufImpl.m_pMem),
+                                static_cast<std::size_t>(bufImpl.m_extentElements.prod()) * sizeof(TElem));
 #endif
+                            bufImpl.m_bPinned = false;
                         }
                     }
                 };
@@ -661,12 +945,8 @@ namespace alpaka
                     -> bool
                     {
                         ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
-                        
-#if defined(ALPAKA_ACC_GPU_CUDA_ENABLED) && defined(__CUDACC__)
+
                         return bufImpl.m_bPinned;
-#else
-                        return false;
-#endif
                     }
                 };
             }
@@ -721,4 +1001,8 @@ namespace alpaka
 }
 
 #include <alpaka/mem/buf/cpu/Copy.hpp>
+#include <alpaka/mem/buf/cpu/CopyConvert.hpp>
+#include <alpaka/mem/buf/cpu/CopyPermuted.hpp>
+#include <alpaka/mem/buf/cpu/Fill.hpp>
+#include <alpaka/mem/buf/cpu/Halo.hpp>
 #include <alpaka/mem/buf/cpu/Set.hpp>
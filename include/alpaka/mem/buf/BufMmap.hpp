@@ -0,0 +1,635 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <boost/predef.h>                   // BOOST_OS_UNIX
+
+// Memory mapped files are only available on POSIX systems.
+#if BOOST_OS_UNIX
+
+#include <alpaka/dev/DevCpu.hpp>            // dev::DevCpu
+#include <alpaka/dev/Traits.hpp>            // dev::traits::DevType
+#include <alpaka/mem/buf/Traits.hpp>        // mem::buf::IsPinned, ...
+#include <alpaka/mem/view/Traits.hpp>       // mem::view::GetPtrNative, ...
+
+#include <alpaka/vec/Vec.hpp>               // Vec
+#include <alpaka/core/Common.hpp>           // ALPAKA_FN_HOST
+
+#include <sys/mman.h>                       // mmap, munmap, madvise
+#include <sys/stat.h>                       // fstat
+#include <fcntl.h>                          // open
+#include <unistd.h>                         // close, ftruncate, sysconf
+
+#include <cassert>                          // assert
+#include <cerrno>                           // errno
+#include <cstdint>                          // std::uint8_t
+#include <cstring>                          // std::strerror
+#include <memory>                           // std::shared_ptr
+#include <stdexcept>                        // std::runtime_error
+#include <string>                           // std::string
+#include <type_traits>                      // std::is_same, std::is_const
+
+namespace alpaka
+{
+    namespace mem
+    {
+        namespace buf
+        {
+            //#############################################################################
+            //! The expected access pattern of a memory mapped file buffer.
+            //#############################################################################
+            enum class MmapAdvice
+            {
+                Normal,     //!< No special treatment.
+                Sequential, //!< Pages are read ahead aggressively and freed soon after being accessed.
+                Random,     //!< Read ahead is disabled.
+                WillNeed,   //!< The whole range is read ahead asynchronously.
+            };
+
+            namespace mmap
+            {
+                namespace detail
+                {
+                    //-----------------------------------------------------------------------------
+                    //! Throws a std::runtime_error containing the errno description.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto throwErrno(
+                        std::string const & what,
+                        std::string const & path)
+                    -> void
+                    {
+                        throw std::runtime_error(what + " '" + path + "' failed: " + std::strerror(errno));
+                    }
+
+                    //#############################################################################
+                    //! The memory mapped file buffer.
+                    //#############################################################################
+                    template<
+                        typename TElem,
+                        typename TDim,
+                        typename TSize>
+                    class BufMmapImpl final
+                    {
+                    public:
+                        //-----------------------------------------------------------------------------
+                        //! Constructor
+                        //-----------------------------------------------------------------------------
+                        template<
+                            typename TExtent>
+                        ALPAKA_FN_HOST BufMmapImpl(
+                            dev::DevCpu const & dev,
+                            std::string const & path,
+                            TExtent const & extent,
+                            std::size_t const & offsetBytes,
+                            MmapAdvice const & advice) :
+                                m_dev(dev),
+                                m_extentElements(extent::getExtentVecEnd<TDim>(extent)),
+                                m_pitchBytes(static_cast<TSize>(extent::getWidth(extent) * sizeof(TElem))),
+                                m_pMapping(nullptr),
+                                m_mappingSizeBytes(0u),
+                                m_pMem(nullptr)
+                        {
+                            ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                            static_assert(
+                                TDim::value == dim::Dim<TExtent>::value,
+                                "The dimensionality of TExtent and the dimensionality of the TDim template parameter have to be identical!");
+                            static_assert(
+                                std::is_same<TSize, size::Size<TExtent>>::value,
+                                "The size type of TExtent and the TSize template parameter have to be identical!");
+
+                            auto const sizeBytes(static_cast<std::size_t>(extent::getProductOfExtent(extent)) * sizeof(TElem));
+                            assert(sizeBytes > 0u);
+
+                            if((offsetBytes % alignof(TElem)) != 0u)
+                            {
+                                throw std::runtime_error("The offset into the file '" + path + "' is not a multiple of the element alignment!");
+                            }
+
+                            // Buffers of const elements map the file read-only.
+                            auto const isReadOnly(std::is_const<TElem>::value);
+                            int const fd(
+                                isReadOnly
+                                ? ::open(path.c_str(), O_RDONLY)
+                                : ::open(path.c_str(), O_RDWR | O_CREAT, 0644));
+                            if(fd == -1)
+                            {
+                                throwErrno("open", path);
+                            }
+
+                            try
+                            {
+                                struct stat fileStat;
+                                if(::fstat(fd, &fileStat) == -1)
+                                {
+                                    throwErrno("fstat", path);
+                                }
+                                auto const fileSizeBytes(static_cast<std::size_t>(fileStat.st_size));
+                                if(fileSizeBytes < offsetBytes + sizeBytes)
+                                {
+                                    if(isReadOnly)
+                                    {
+                                        throw std::runtime_error("The file '" + path + "' is too small for the requested extent!");
+                                    }
+                                    else if(::ftruncate(fd, static_cast<off_t>(offsetBytes + sizeBytes)) == -1)
+                                    {
+                                        throwErrno("ftruncate", path);
+                                    }
+                                }
+
+                                // The offset of the mapping has to be a multiple of the page size.
+                                auto const pageSizeBytes(static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)));
+                                auto const pageOffsetBytes(offsetBytes % pageSizeBytes);
+                                m_mappingSizeBytes = sizeBytes + pageOffsetBytes;
+
+                                void * const pMapping(
+                                    ::mmap(
+                                        nullptr,
+                                        m_mappingSizeBytes,
+                                        isReadOnly ? PROT_READ : (PROT_READ | PROT_WRITE),
+                                        MAP_SHARED,
+                                        fd,
+                                        static_cast<off_t>(offsetBytes - pageOffsetBytes)));
+                                if(pMapping == MAP_FAILED)
+                                {
+                                    throwErrno("mmap", path);
+                                }
+                                m_pMapping = pMapping;
+                                m_pMem = reinterpret_cast<TElem *>(reinterpret_cast<std::uint8_t *>(pMapping) + pageOffsetBytes);
+                            }
+                            catch(...)
+                            {
+                                ::close(fd);
+                                throw;
+                            }
+
+                            // The mapping keeps a reference to the file.
+                            ::close(fd);
+
+                            advise(advice);
+
+#if ALPAKA_DEBUG >= ALPAKA_DEBUG_FULL
+                            std::cout << BOOST_CURRENT_FUNCTION
+                                << " path: " << path
+                                << " e: " << m_extentElements
+                                << " ptr: " << static_cast<void const *>(m_pMem)
+                                << " pitch: " << m_pitchBytes
+                                << std::endl;
+#endif
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! Copy constructor.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST BufMmapImpl(BufMmapImpl const &) = delete;
+                        //-----------------------------------------------------------------------------
+                        //! Move constructor.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST BufMmapImpl(BufMmapImpl &&) = delete;
+                        //-----------------------------------------------------------------------------
+                        //! Copy assignment operator.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto operator=(BufMmapImpl const &) -> BufMmapImpl & = delete;
+                        //-----------------------------------------------------------------------------
+                        //! Move assignment operator.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto operator=(BufMmapImpl &&) -> BufMmapImpl & = delete;
+                        //-----------------------------------------------------------------------------
+                        //! Destructor.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST ~BufMmapImpl()
+                        {
+                            ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                            // Shared mappings are written back to the file by the operating system.
+                            ::munmap(m_pMapping, m_mappingSizeBytes);
+                        }
+
+                        //-----------------------------------------------------------------------------
+                        //! Advises the operating system about the expected access pattern.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto advise(
+                            MmapAdvice const & advice) const
+                        -> void
+                        {
+                            int const posixAdvice(
+                                (advice == MmapAdvice::Sequential) ? MADV_SEQUENTIAL
+                                : (advice == MmapAdvice::Random) ? MADV_RANDOM
+                                : (advice == MmapAdvice::WillNeed) ? MADV_WILLNEED
+                                : MADV_NORMAL);
+                            // The advice is only a hint so a failure is not an error.
+                            ::madvise(m_pMapping, m_mappingSizeBytes, posixAdvice);
+                        }
+
+                    public:
+                        dev::DevCpu const m_dev;
+                        Vec<TDim, TSize> const m_extentElements;
+                        TSize const m_pitchBytes;
+                        void * m_pMapping;
+                        std::size_t m_mappingSizeBytes;
+                        TElem * m_pMem;
+                    };
+                }
+            }
+            //#############################################################################
+            //! A memory buffer backed by a memory mapped file.
+            //!
+            //! The file content is paged in on first access so kernels and copies can consume it without reading it into a BufCpu first.
+            //!
+            //! A const element type (e.g. BufMmap<float const, ...>) maps the file read-only. The file has to be large enough.
+            //! Otherwise the file is mapped for reading and writing. It is created or grown if it is too small and changes are written back to it.
+            //#############################################################################
+            template<
+                typename TElem,
+                typename TDim,
+                typename TSize>
+            class BufMmap
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor
+                //!
+                //! \param dev The device the buffer is accessible from.
+                //! \param path The path of the file to map.
+                //! \param extent The extent of the buffer in elements.
+                //! \param offsetBytes The byte offset of the buffer within the file. It has to be a multiple of the element alignment.
+                //! \param advice The expected access pattern.
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TExtent>
+                ALPAKA_FN_HOST BufMmap(
+                    dev::DevCpu const & dev,
+                    std::string const & path,
+                    TExtent const & extent,
+                    std::size_t const & offsetBytes = 0u,
+                    MmapAdvice const & advice = MmapAdvice::Normal) :
+                        m_spBufMmapImpl(std::make_shared<mmap::detail::BufMmapImpl<TElem, TDim, TSize>>(dev, path, extent, offsetBytes, advice))
+                {}
+                //-----------------------------------------------------------------------------
+                //! Copy constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST BufMmap(BufMmap const &) = default;
+                //-----------------------------------------------------------------------------
+                //! Move constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST BufMmap(BufMmap &&) = default;
+                //-----------------------------------------------------------------------------
+                //! Copy assignment operator.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto operator=(BufMmap const &) -> BufMmap & = default;
+                //-----------------------------------------------------------------------------
+                //! Move assignment operator.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto operator=(BufMmap &&) -> BufMmap & = default;
+
+            public:
+                std::shared_ptr<mmap::detail::BufMmapImpl<TElem, TDim, TSize>> m_spBufMmapImpl;
+            };
+
+            //-----------------------------------------------------------------------------
+            //! Advises the operating system about the expected access pattern of the memory mapped file buffer.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TElem,
+                typename TDim,
+                typename TSize>
+            ALPAKA_FN_HOST auto advise(
+                BufMmap<TElem, TDim, TSize> const & buf,
+                MmapAdvice const & advice)
+            -> void
+            {
+                buf.m_spBufMmapImpl->advise(advice);
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    // Trait specializations for BufMmap.
+    //-----------------------------------------------------------------------------
+    namespace dev
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The BufMmap device type trait specialization.
+            //#############################################################################
+            template<
+                typename TElem,
+                typename TDim,
+                typename TSize>
+            struct DevType<
+                mem::buf::BufMmap<TElem, TDim, TSize>>
+            {
+                using type = dev::DevCpu;
+            };
+            //#############################################################################
+            //! The BufMmap device get trait specialization.
+            //#############################################################################
+            template<
+                typename TElem,
+                typename TDim,
+                typename TSize>
+            struct GetDev<
+                mem::buf::BufMmap<TElem, TDim, TSize>>
+            {
+                ALPAKA_FN_HOST static auto getDev(
+                    mem::buf::BufMmap<TElem, TDim, TSize> const & buf)
+                -> dev::DevCpu
+                {
+                    return buf.m_spBufMmapImpl->m_dev;
+                }
+            };
+        }
+    }
+    namespace dim
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The BufMmap dimension getter trait.
+            //#############################################################################
+            template<
+                typename TElem,
+                typename TDim,
+                typename TSize>
+            struct DimType<
+                mem::buf::BufMmap<TElem, TDim, TSize>>
+            {
+                using type = TDim;
+            };
+        }
+    }
+    namespace elem
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The BufMmap memory element type get trait specialization.
+            //#############################################################################
+            template<
+                typename TElem,
+                typename TDim,
+                typename TSize>
+            struct ElemType<
+                mem::buf::BufMmap<TElem, TDim, TSize>>
+            {
+                using type = TElem;
+            };
+        }
+    }
+    namespace extent
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The BufMmap width get trait specialization.
+            //#############################################################################
+            template<
+                typename TIdx,
+                typename TElem,
+                typename TDim,
+                typename TSize>
+            struct GetExtent<
+                TIdx,
+                mem::buf::BufMmap<TElem, TDim, TSize>,
+                typename std::enable_if<(TDim::value > TIdx::value)>::type>
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto getExtent(
+                    mem::buf::BufMmap<TElem, TDim, TSize> const & extent)
+                -> TSize
+                {
+                    return extent.m_spBufMmapImpl->m_extentElements[TIdx::value];
+                }
+            };
+        }
+    }
+    namespace mem
+    {
+        namespace view
+        {
+            namespace traits
+            {
+                //#############################################################################
+                //! The BufMmap buf trait specialization.
+                //#############################################################################
+                template<
+                    typename TElem,
+                    typename TDim,
+                    typename TSize>
+                struct GetBuf<
+                    mem::buf::BufMmap<TElem, TDim, TSize>>
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto getBuf(
+                        mem::buf::BufMmap<TElem, TDim, TSize> const & buf)
+                    -> mem::buf::BufMmap<TElem, TDim, TSize> const &
+                    {
+                        return buf;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto getBuf(
+                        mem::buf::BufMmap<TElem, TDim, TSize> & buf)
+                    -> mem::buf::BufMmap<TElem, TDim, TSize> &
+                    {
+                        return buf;
+                    }
+                };
+                //#############################################################################
+                //! The BufMmap native pointer get trait specialization.
+                //#############################################################################
+                template<
+                    typename TElem,
+                    typename TDim,
+                    typename TSize>
+                struct GetPtrNative<
+                    mem::buf::BufMmap<TElem, TDim, TSize>>
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto getPtrNative(
+                        mem::buf::BufMmap<TElem, TDim, TSize> const & buf)
+                    -> TElem const *
+                    {
+                        return buf.m_spBufMmapImpl->m_pMem;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto getPtrNative(
+                        mem::buf::BufMmap<TElem, TDim, TSize> & buf)
+                    -> TElem *
+                    {
+                        return buf.m_spBufMmapImpl->m_pMem;
+                    }
+                };
+                //#############################################################################
+                //! The BufMmap pointer on device get trait specialization.
+                //#############################################################################
+                template<
+                    typename TElem,
+                    typename TDim,
+                    typename TSize>
+                struct GetPtrDev<
+                    mem::buf::BufMmap<TElem, TDim, TSize>,
+                    dev::DevCpu>
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto getPtrDev(
+                        mem::buf::BufMmap<TElem, TDim, TSize> const & buf,
+                        dev::DevCpu const & dev)
+                    -> TElem const *
+                    {
+                        if(dev == dev::getDev(buf))
+                        {
+                            return buf.m_spBufMmapImpl->m_pMem;
+                        }
+                        else
+                        {
+                            throw std::runtime_error("The buffer is not accessible from the given device!");
+                        }
+                    }
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto getPtrDev(
+                        mem::buf::BufMmap<TElem, TDim, TSize> & buf,
+                        dev::DevCpu const & dev)
+                    -> TElem *
+                    {
+                        if(dev == dev::getDev(buf))
+                        {
+                            return buf.m_spBufMmapImpl->m_pMem;
+                        }
+                        else
+                        {
+                            throw std::runtime_error("The buffer is not accessible from the given device!");
+                        }
+                    }
+                };
+                //#############################################################################
+                //! The BufMmap pitch get trait specialization.
+                //#############################################################################
+                template<
+                    typename TElem,
+                    typename TDim,
+                    typename TSize>
+                struct GetPitchBytes<
+                    dim::DimInt<TDim::value - 1u>,
+                    mem::buf::BufMmap<TElem, TDim, TSize>>
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto getPitchBytes(
+                        mem::buf::BufMmap<TElem, TDim, TSize> const & pitch)
+                    -> TSize
+                    {
+                        return pitch.m_spBufMmapImpl->m_pitchBytes;
+                    }
+                };
+            }
+        }
+        namespace buf
+        {
+            namespace traits
+            {
+                //#############################################################################
+                //! The BufMmap memory pin state trait specialization.
+                //#############################################################################
+                template<
+                    typename TElem,
+                    typename TDim,
+                    typename TSize>
+                struct IsPinned<
+                    mem::buf::BufMmap<TElem, TDim, TSize>>
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto isPinned(
+                        mem::buf::BufMmap<TElem, TDim, TSize> const &)
+                    -> bool
+                    {
+                        return false;
+                    }
+                };
+            }
+        }
+    }
+    namespace offset
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The BufMmap offset get trait specialization.
+            //#############################################################################
+            template<
+                typename TIdx,
+                typename TElem,
+                typename TDim,
+                typename TSize>
+            struct GetOffset<
+                TIdx,
+                mem::buf::BufMmap<TElem, TDim, TSize>>
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto getOffset(
+                    mem::buf::BufMmap<TElem, TDim, TSize> const &)
+                -> TSize
+                {
+                    return 0u;
+                }
+            };
+        }
+    }
+    namespace size
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The BufMmap size type trait specialization.
+            //#############################################################################
+            template<
+                typename TElem,
+                typename TDim,
+                typename TSize>
+            struct SizeType<
+                mem::buf::BufMmap<TElem, TDim, TSize>>
+            {
+                using type = TSize;
+            };
+        }
+    }
+}
+
+#endif
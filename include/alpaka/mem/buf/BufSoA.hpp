@@ -0,0 +1,524 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/dev/Traits.hpp>            // dev::traits::DevType
+#include <alpaka/dev/cpu/MemStats.hpp>      // dev::cpu::detail::getMemStatsCounters
+#include <alpaka/mem/buf/BufPlainPtrWrapper.hpp>    // mem::buf::BufPlainPtrWrapper
+#include <alpaka/mem/buf/Traits.hpp>        // mem::buf::Alloc, ...
+#include <alpaka/mem/view/Traits.hpp>       // mem::view::taskCopy
+
+#include <alpaka/core/MapIdx.hpp>           // core::mapIdx
+#include <alpaka/vec/Vec.hpp>               // Vec
+
+#include <alpaka/mem/alloc/AllocCpuBoostAligned.hpp>
+
+#include <cassert>                          // assert
+#include <cstdint>                          // std::uint8_t
+#include <memory>                           // std::shared_ptr
+#include <stdexcept>                        // std::runtime_error
+#include <tuple>                            // std::tuple, std::tuple_element
+
+namespace alpaka
+{
+    namespace dev
+    {
+        class DevCpu;
+    }
+    namespace mem
+    {
+        namespace buf
+        {
+            namespace soa
+            {
+                namespace detail
+                {
+                    //-----------------------------------------------------------------------------
+                    //! The alignment in bytes of the allocation and of each field array.
+                    //! This is the width of the widest SIMD registers (AVX-512) and of a cache line.
+                    //-----------------------------------------------------------------------------
+                    static constexpr std::size_t soaAlignmentBytes = 64u;
+                }
+            }
+
+            //#############################################################################
+            //! The structure of arrays accessor.
+            //!
+            //! This is a trivially copyable handle to the memory of a BufSoA that can be passed to kernels.
+            //#############################################################################
+            template<
+                typename TTuple,
+                typename TDim,
+                typename TSize>
+            class SoAAccessor;
+
+            //#############################################################################
+            //! The structure of arrays accessor.
+            //#############################################################################
+            template<
+                typename... TElems,
+                typename TDim,
+                typename TSize>
+            class SoAAccessor<
+                std::tuple<TElems...>,
+                TDim,
+                TSize>
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! \return The pointer to the array of the field with the given index.
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    std::size_t TIdx>
+                ALPAKA_FN_HOST_ACC auto field() const
+                -> typename std::tuple_element<TIdx, std::tuple<TElems...>>::type *
+                {
+                    static_assert(
+                        TIdx < sizeof...(TElems),
+                        "The field index is out of range!");
+
+                    return
+                        reinterpret_cast<typename std::tuple_element<TIdx, std::tuple<TElems...>>::type *>(
+                            m_pMem + m_fieldOffsetBytes[TIdx]);
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The element of the field with the given index at the given linearized index.
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    std::size_t TIdx>
+                ALPAKA_FN_HOST_ACC auto get(
+                    TSize const & idx) const
+                -> typename std::tuple_element<TIdx, std::tuple<TElems...>>::type &
+                {
+                    return field<TIdx>()[idx];
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The element of the field with the given index at the given index.
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                template<
+                    std::size_t TIdx>
+                ALPAKA_FN_HOST_ACC auto get(
+                    Vec<TDim, TSize> const & idx) const
+                -> typename std::tuple_element<TIdx, std::tuple<TElems...>>::type &
+                {
+                    return field<TIdx>()[core::mapIdx<1u>(idx, m_extentElements)[0u]];
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The number of elements of each field.
+                //-----------------------------------------------------------------------------
+                ALPAKA_NO_HOST_ACC_WARNING
+                ALPAKA_FN_HOST_ACC auto getElementCount() const
+                -> TSize
+                {
+                    return m_extentElements.prod();
+                }
+
+            public:
+                std::uint8_t * m_pMem;
+                std::size_t m_fieldOffsetBytes[sizeof...(TElems)];
+                Vec<TDim, TSize> m_extentElements;
+            };
+
+            namespace soa
+            {
+                namespace detail
+                {
+                    //#############################################################################
+                    //! The structure of arrays buffer implementation.
+                    //#############################################################################
+                    template<
+                        typename TTuple,
+                        typename TDim,
+                        typename TSize>
+                    class BufSoAImpl;
+
+                    //#############################################################################
+                    //! The structure of arrays buffer implementation.
+                    //#############################################################################
+                    template<
+                        typename... TElems,
+                        typename TDim,
+                        typename TSize>
+                    class BufSoAImpl<
+                        std::tuple<TElems...>,
+                        TDim,
+                        TSize> :
+                        public mem::alloc::AllocCpuBoostAligned<std::integral_constant<std::size_t, soaAlignmentBytes>>
+                    {
+                    public:
+                        //-----------------------------------------------------------------------------
+                        //! Constructor
+                        //-----------------------------------------------------------------------------
+                        template<
+                            typename TExtent>
+                        ALPAKA_FN_HOST BufSoAImpl(
+                            dev::DevCpu const & dev,
+                            TExtent const & extent) :
+                                mem::alloc::AllocCpuBoostAligned<std::integral_constant<std::size_t, soaAlignmentBytes>>(),
+                                m_dev(dev),
+                                m_extentElements(extent::getExtentVecEnd<TDim>(extent)),
+                                m_sizeBytes(computeFieldOffsets(extent::getProductOfExtent(extent), m_fieldOffsetBytes)),
+                                m_pMem(mem::alloc::alloc<std::uint8_t>(*this, m_sizeBytes))
+                        {
+                            ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                            static_assert(
+                                TDim::value == dim::Dim<TExtent>::value,
+                                "The dimensionality of TExtent and the dimensionality of the TDim template parameter have to be identical!");
+                            static_assert(
+                                std::is_same<TSize, size::Size<TExtent>>::value,
+                                "The size type of TExtent and the TSize template parameter have to be identical!");
+
+                            if(m_pMem == nullptr)
+                            {
+                                throw std::runtime_error("Allocating the structure of arrays buffer failed!");
+                            }
+
+                            dev::cpu::detail::getMemStatsCounters(m_dev).onAlloc(m_sizeBytes);
+
+#if ALPAKA_DEBUG >= ALPAKA_DEBUG_FULL
+                            std::cout << BOOST_CURRENT_FUNCTION
+                                << " e: " << m_extentElements
+                                << " ptr: " << static_cast<void *>(m_pMem)
+                                << " size: " << m_sizeBytes
+                                << std::endl;
+#endif
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! Copy constructor.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST BufSoAImpl(BufSoAImpl const &) = delete;
+                        //-----------------------------------------------------------------------------
+                        //! Move constructor.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST BufSoAImpl(BufSoAImpl &&) = default;
+                        //-----------------------------------------------------------------------------
+                        //! Copy assignment operator.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto operator=(BufSoAImpl const &) -> BufSoAImpl & = delete;
+                        //-----------------------------------------------------------------------------
+                        //! Move assignment operator.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto operator=(BufSoAImpl &&) -> BufSoAImpl & = default;
+                        //-----------------------------------------------------------------------------
+                        //! Destructor.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST ~BufSoAImpl()
+                        {
+                            ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                            dev::cpu::detail::getMemStatsCounters(m_dev).onFree(m_sizeBytes);
+
+                            mem::alloc::free(*this, m_pMem);
+                        }
+
+                    private:
+                        //-----------------------------------------------------------------------------
+                        //! Calculates the offsets of the field arrays each padded to the alignment.
+                        //! \return The number of bytes to allocate.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST static auto computeFieldOffsets(
+                            TSize const & elementCount,
+                            std::size_t (& fieldOffsetBytes)[sizeof...(TElems)])
+                        -> std::size_t
+                        {
+                            assert(elementCount > 0);
+
+                            std::size_t const elemSizes[] = {sizeof(TElems)...};
+                            std::size_t sizeBytes(0u);
+                            for(std::size_t i(0u); i < sizeof...(TElems); ++i)
+                            {
+                                fieldOffsetBytes[i] = sizeBytes;
+                                auto const fieldBytes(static_cast<std::size_t>(elementCount) * elemSizes[i]);
+                                sizeBytes += ((fieldBytes + soaAlignmentBytes - 1u) / soaAlignmentBytes) * soaAlignmentBytes;
+                            }
+                            return sizeBytes;
+                        }
+
+                    public:
+                        dev::DevCpu const m_dev;
+                        Vec<TDim, TSize> const m_extentElements;
+                        std::size_t m_fieldOffsetBytes[sizeof...(TElems)];
+                        std::size_t const m_sizeBytes;
+                        std::uint8_t * const m_pMem;
+                    };
+                }
+            }
+
+            //#############################################################################
+            //! The structure of arrays buffer.
+            //!
+            //! All fields are stored in a single aligned allocation one array after the other.
+            //! Each field array starts at a multiple of the SIMD width so loops over a field can be vectorized without peeling.
+            //#############################################################################
+            template<
+                typename TTuple,
+                typename TDim,
+                typename TSize>
+            class BufSoA
+            {
+                static_assert(
+                    (std::tuple_size<TTuple>::value > 0u),
+                    "The structure of arrays buffer is required to have at least one field!");
+
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TExtent>
+                ALPAKA_FN_HOST BufSoA(
+                    dev::DevCpu const & dev,
+                    TExtent const & extent) :
+                        m_spBufSoAImpl(std::make_shared<soa::detail::BufSoAImpl<TTuple, TDim, TSize>>(dev, extent))
+                {}
+                //-----------------------------------------------------------------------------
+                //! Copy constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST BufSoA(BufSoA const &) = default;
+                //-----------------------------------------------------------------------------
+                //! Move constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST BufSoA(BufSoA &&) = default;
+                //-----------------------------------------------------------------------------
+                //! Copy assignment operator.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto operator=(BufSoA const &) -> BufSoA & = default;
+                //-----------------------------------------------------------------------------
+                //! Move assignment operator.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto operator=(BufSoA &&) -> BufSoA & = default;
+
+            public:
+                std::shared_ptr<soa::detail::BufSoAImpl<TTuple, TDim, TSize>> m_spBufSoAImpl;
+            };
+
+            //-----------------------------------------------------------------------------
+            //! \return The accessor to the fields of the buffer to be passed to kernels.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TTuple,
+                typename TDim,
+                typename TSize>
+            ALPAKA_FN_HOST auto getAccessor(
+                BufSoA<TTuple, TDim, TSize> const & buf)
+            -> SoAAccessor<TTuple, TDim, TSize>
+            {
+                auto const & impl(*buf.m_spBufSoAImpl);
+                SoAAccessor<TTuple, TDim, TSize> accessor{impl.m_pMem, {}, impl.m_extentElements};
+                for(std::size_t i(0u); i < std::tuple_size<TTuple>::value; ++i)
+                {
+                    accessor.m_fieldOffsetBytes[i] = impl.m_fieldOffsetBytes[i];
+                }
+                return accessor;
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return A view of the array of the field with the given index.
+            //! This can be used with the usual memory operations like mem::view::copy.
+            //-----------------------------------------------------------------------------
+            template<
+                std::size_t TIdx,
+                typename TTuple,
+                typename TDim,
+                typename TSize>
+            ALPAKA_FN_HOST auto getField(
+                BufSoA<TTuple, TDim, TSize> const & buf)
+            -> BufPlainPtrWrapper<dev::DevCpu, typename std::tuple_element<TIdx, TTuple>::type, TDim, TSize>
+            {
+                auto const & impl(*buf.m_spBufSoAImpl);
+                return
+                    BufPlainPtrWrapper<dev::DevCpu, typename std::tuple_element<TIdx, TTuple>::type, TDim, TSize>(
+                        reinterpret_cast<typename std::tuple_element<TIdx, TTuple>::type *>(impl.m_pMem + impl.m_fieldOffsetBytes[TIdx]),
+                        impl.m_dev,
+                        impl.m_extentElements);
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Creates a task copying all fields of a structure of arrays buffer.
+            //!
+            //! Buffers of equal extent have an identical layout so all fields are copied as a single contiguous block.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TTuple,
+                typename TDim,
+                typename TSize>
+            ALPAKA_FN_HOST auto taskCopySoA(
+                BufSoA<TTuple, TDim, TSize> & bufDst,
+                BufSoA<TTuple, TDim, TSize> const & bufSrc)
+            -> decltype(
+                mem::view::taskCopy(
+                    std::declval<BufPlainPtrWrapper<dev::DevCpu, std::uint8_t, dim::DimInt<1u>, TSize> &>(),
+                    std::declval<BufPlainPtrWrapper<dev::DevCpu, std::uint8_t, dim::DimInt<1u>, TSize> const &>(),
+                    std::declval<Vec<dim::DimInt<1u>, TSize>>()))
+            {
+                auto const & implDst(*bufDst.m_spBufSoAImpl);
+                auto const & implSrc(*bufSrc.m_spBufSoAImpl);
+                if(implDst.m_extentElements != implSrc.m_extentElements)
+                {
+                    throw std::runtime_error("The source and the destination structure of arrays buffers are required to have the same extent!");
+                }
+
+                Vec<dim::DimInt<1u>, TSize> const extentBytes(static_cast<TSize>(implDst.m_sizeBytes));
+                BufPlainPtrWrapper<dev::DevCpu, std::uint8_t, dim::DimInt<1u>, TSize> bytesDst(implDst.m_pMem, implDst.m_dev, extentBytes);
+                BufPlainPtrWrapper<dev::DevCpu, std::uint8_t, dim::DimInt<1u>, TSize> const bytesSrc(implSrc.m_pMem, implSrc.m_dev, extentBytes);
+                return
+                    mem::view::taskCopy(
+                        bytesDst,
+                        bytesSrc,
+                        extentBytes);
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Copies all fields of a structure of arrays buffer asynchronously.
+            //!
+            //! \param stream The stream to enqueue the buffer copy task into.
+            //! \param bufDst The destination buffer.
+            //! \param bufSrc The source buffer.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TTuple,
+                typename TDim,
+                typename TSize,
+                typename TStream>
+            ALPAKA_FN_HOST auto copySoA(
+                TStream & stream,
+                BufSoA<TTuple, TDim, TSize> & bufDst,
+                BufSoA<TTuple, TDim, TSize> const & bufSrc)
+            -> void
+            {
+                stream::enqueue(
+                    stream,
+                    mem::buf::taskCopySoA(
+                        bufDst,
+                        bufSrc));
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    // Trait specializations for BufSoA.
+    //-----------------------------------------------------------------------------
+    namespace dev
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The BufSoA device type trait specialization.
+            //#############################################################################
+            template<
+                typename TTuple,
+                typename TDim,
+                typename TSize>
+            struct DevType<
+                mem::buf::BufSoA<TTuple, TDim, TSize>>
+            {
+                using type = dev::DevCpu;
+            };
+            //#############################################################################
+            //! The BufSoA device get trait specialization.
+            //#############################################################################
+            template<
+                typename TTuple,
+                typename TDim,
+                typename TSize>
+            struct GetDev<
+                mem::buf::BufSoA<TTuple, TDim, TSize>>
+            {
+                ALPAKA_FN_HOST static auto getDev(
+                    mem::buf::BufSoA<TTuple, TDim, TSize> const & buf)
+                -> dev::DevCpu
+                {
+                    return buf.m_spBufSoAImpl->m_dev;
+                }
+            };
+        }
+    }
+    namespace dim
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The BufSoA dimension getter trait.
+            //#############################################################################
+            template<
+                typename TTuple,
+                typename TDim,
+                typename TSize>
+            struct DimType<
+                mem::buf::BufSoA<TTuple, TDim, TSize>>
+            {
+                using type = TDim;
+            };
+        }
+    }
+    namespace extent
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The BufSoA extent get trait specialization.
+            //#############################################################################
+            template<
+                typename TIdx,
+                typename TTuple,
+                typename TDim,
+                typename TSize>
+            struct GetExtent<
+                TIdx,
+                mem::buf::BufSoA<TTuple, TDim, TSize>,
+                typename std::enable_if<(TDim::value > TIdx::value)>::type>
+            {
+                //-----------------------------------------------------------------------------
+                //!
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto getExtent(
+                    mem::buf::BufSoA<TTuple, TDim, TSize> const & extent)
+                -> TSize
+                {
+                    return extent.m_spBufSoAImpl->m_extentElements[TIdx::value];
+                }
+            };
+        }
+    }
+    namespace size
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The BufSoA size type trait specialization.
+            //#############################################################################
+            template<
+                typename TTuple,
+                typename TDim,
+                typename TSize>
+            struct SizeType<
+                mem::buf::BufSoA<TTuple, TDim, TSize>>
+            {
+                using type = TSize;
+            };
+        }
+    }
+}
@@ -23,6 +23,8 @@
 
 #include <alpaka/mem/buf/Traits.hpp>    // dev::traits::DevType, DimType, GetExtent,Copy, GetOffset, ...
 
+#include <alpaka/mem/alloc/AlignedStdAllocator.hpp>  // mem::alloc::AlignedStdAllocator
+
 #include <alpaka/core/Common.hpp>       // ALPAKA_FN_HOST
 
 // FIXME: This include can lead to circular include problems!
@@ -710,6 +712,17 @@ namespace alpaka
                         return sizeof(TElem) * pitch.size();
                     }
                 };
+                //#############################################################################
+                //! The std::vector alignment trait specialization for the aligned allocator.
+                //#############################################################################
+                template<
+                    typename TElem,
+                    std::size_t TAlignment>
+                struct AlignmentType<
+                    std::vector<TElem, mem::alloc::AlignedStdAllocator<TElem, TAlignment>>>
+                {
+                    using type = std::integral_constant<std::size_t, mem::alloc::AlignedStdAllocator<TElem, TAlignment>::alignment>;
+                };
             }
         }
     }
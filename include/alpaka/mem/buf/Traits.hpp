@@ -64,6 +64,38 @@ namespace alpaka
                     typename TSfinae = void>
                 struct Alloc;
 
+                //#############################################################################
+                //! The zeroed memory allocator trait.
+                //#############################################################################
+                template<
+                    typename TElem,
+                    typename TDim,
+                    typename TSize,
+                    typename TDev,
+                    typename TSfinae = void>
+                struct AllocZeroed;
+
+                //#############################################################################
+                //! The memory known zero state trait.
+                //!
+                //! By default the content of a buffer is unknown.
+                //#############################################################################
+                template<
+                    typename TBuf,
+                    typename TSfinae = void>
+                struct IsZeroed
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto isZeroed(
+                        TBuf const &)
+                    -> bool
+                    {
+                        return false;
+                    }
+                };
+
                 //#############################################################################
                 //! The memory mapping trait.
                 //#############################################################################
@@ -156,6 +188,48 @@ namespace alpaka
                         extent);
             }
             //-----------------------------------------------------------------------------
+            //! Allocates memory on the given device that is already zeroed.
+            //!
+            //! Other than alloc followed by a set this does not write the memory.
+            //! Depending on the device the zeroing cost is moved onto the first touch of each page.
+            //! A zero set of the buffer directly following the allocation is skipped.
+            //!
+            //! \tparam TElem The element type of the returned buffer.
+            //! \tparam TExtent The extent of the buffer.
+            //! \tparam TDev The type of device the buffer is allocated on.
+            //! \param dev The device to allocate the buffer on.
+            //! \param extent The extent of the buffer.
+            //! \return The newly allocated buffer.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TElem,
+                typename TSize,
+                typename TExtent,
+                typename TDev>
+            ALPAKA_FN_HOST auto allocZeroed(
+                TDev const & dev,
+                TExtent const & extent = TExtent())
+            -> decltype(
+                traits::AllocZeroed<
+                    TElem,
+                    dim::Dim<TExtent>,
+                    TSize,
+                    TDev>
+                ::allocZeroed(
+                    dev,
+                    extent))
+            {
+                return
+                    traits::AllocZeroed<
+                        TElem,
+                        dim::Dim<TExtent>,
+                        TSize,
+                        TDev>
+                    ::allocZeroed(
+                        dev,
+                        extent);
+            }
+            //-----------------------------------------------------------------------------
             //! Maps the buffer into the memory of the given device.
             //!
             //! \tparam TBuf The buffer type.
@@ -257,6 +331,25 @@ namespace alpaka
                     ::isPinned(
                         buf);
             }
+            //-----------------------------------------------------------------------------
+            //! \return If the content of the buffer is known to be zero.
+            //! This is the case after a zeroed allocation until a mutable pointer to the memory is handed out.
+            //!
+            //! \tparam TBuf The buffer type.
+            //! \param buf The buffer to get the zero state of.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TBuf>
+            ALPAKA_FN_HOST auto isZeroed(
+                TBuf const & buf)
+            -> bool
+            {
+                return
+                    traits::IsZeroed<
+                        TBuf>
+                    ::isZeroed(
+                        buf);
+            }
         }
     }
 }
@@ -24,6 +24,8 @@
 #include <alpaka/dim/DimIntegralConst.hpp>  // dim::DimInt<N>
 #include <alpaka/extent/Traits.hpp>         // extent::getXXX
 #include <alpaka/mem/view/Traits.hpp>       // mem::view::Copy, ...
+#include <alpaka/mem/buf/cpu/NonTemporal.hpp>   // mem::view::cpu::detail::memcpyStreaming
+#include <alpaka/profiler/Profiler.hpp>     // ALPAKA_PROFILER_MEM_SCOPE
 #include <alpaka/stream/StreamCpuAsync.hpp> // stream::StreamCpuAsync
 #include <alpaka/stream/StreamCpuSync.hpp>  // stream::StreamCpuSync
 
@@ -160,6 +162,8 @@ namespace alpaka
 #if ALPAKA_DEBUG >= ALPAKA_DEBUG_FULL
                             printDebug();
 #endif
+                            ALPAKA_PROFILER_MEM_SCOPE(Copy, m_extentWidthBytes * m_extentHeight * m_extentDepth);
+
                             auto const equalWidths(
                                 (m_extentWidth == m_dstWidth)
                                 && (m_extentWidth == m_srcWidth)
@@ -188,12 +192,33 @@ namespace alpaka
                                 && (dstSliceSizeBytes == srcSliceSizeBytes)
                                 && copySliceAtOnce);
 
+                            // Copies larger than the last level cache bypass the caches for the destination.
+                            // This does not evict the working set and saves the read for ownership of each destination line.
+                            auto const streaming(
+                                useStreamingStores(
+                                    static_cast<std::size_t>(m_extentWidthBytes * m_extentHeight * m_extentDepth)));
+                            auto const copyBytes(
+                                [streaming](std::uint8_t * const dst, std::uint8_t const * const src, std::size_t const & sizeBytes)
+                                {
+                                    if(streaming)
+                                    {
+                                        memcpyStreaming(dst, src, sizeBytes);
+                                    }
+                                    else
+                                    {
+                                        std::memcpy(
+                                            reinterpret_cast<void *>(dst),
+                                            reinterpret_cast<void const *>(src),
+                                            sizeBytes);
+                                    }
+                                });
+
                             if(copyAllAtOnce)
                             {
-                                std::memcpy(
-                                    reinterpret_cast<void *>(m_dstMemNative),
-                                    reinterpret_cast<void const *>(m_srcMemNative),
-                                    dstSliceSizeBytes*m_extentDepth);
+                                copyBytes(
+                                    m_dstMemNative,
+                                    m_srcMemNative,
+                                    static_cast<std::size_t>(dstSliceSizeBytes*m_extentDepth));
                             }
                             else
                             {
@@ -201,23 +226,28 @@ namespace alpaka
                                 {
                                     if(copySliceAtOnce)
                                     {
-                                        std::memcpy(
-                                            reinterpret_cast<void *>(m_dstMemNative + z*dstSliceSizeBytes),
-                                            reinterpret_cast<void const *>(m_srcMemNative + z*srcSliceSizeBytes),
-                                            m_dstPitchBytes*m_extentHeight);
+                                        copyBytes(
+                                            m_dstMemNative + z*dstSliceSizeBytes,
+                                            m_srcMemNative + z*srcSliceSizeBytes,
+                                            static_cast<std::size_t>(m_dstPitchBytes*m_extentHeight));
                                     }
                                     else
                                     {
                                         for(auto y((decltype(m_extentHeight)(0))); y < m_extentHeight; ++y)
                                         {
-                                            std::memcpy(
-                                                reinterpret_cast<void *>(m_dstMemNative + y*m_dstPitchBytes + z*dstSliceSizeBytes),
-                                                reinterpret_cast<void const *>(m_srcMemNative + y*m_srcPitchBytes + z*srcSliceSizeBytes),
-                                                m_extentWidthBytes);
+                                            copyBytes(
+                                                m_dstMemNative + y*m_dstPitchBytes + z*dstSliceSizeBytes,
+                                                m_srcMemNative + y*m_srcPitchBytes + z*srcSliceSizeBytes,
+                                                static_cast<std::size_t>(m_extentWidthBytes));
                                         }
                                     }
                                 }
                             }
+
+                            if(streaming)
+                            {
+                                streamingStoresFence();
+                            }
                         }
 
                         Size m_extentWidth;
@@ -0,0 +1,212 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/dim/DimIntegralConst.hpp>  // dim::DimInt<N>
+#include <alpaka/extent/Traits.hpp>         // extent::getXXX
+#include <alpaka/mem/view/Traits.hpp>       // mem::view::TaskCopyConvert, ...
+#include <alpaka/stream/StreamCpuAsync.hpp> // stream::StreamCpuAsync
+#include <alpaka/stream/StreamCpuSync.hpp>  // stream::StreamCpuSync
+
+#include <cassert>                          // assert
+
+namespace alpaka
+{
+    namespace dev
+    {
+        class DevCpu;
+    }
+}
+
+namespace alpaka
+{
+    namespace mem
+    {
+        namespace view
+        {
+            namespace cpu
+            {
+                namespace detail
+                {
+                    //#############################################################################
+                    //! The CPU device memory converting copy task.
+                    //!
+                    //! Copies from CPU memory into CPU memory converting the elements in a single pass.
+                    //#############################################################################
+                    template<
+                        typename TBufDst,
+                        typename TBufSrc,
+                        typename TExtent,
+                        typename TConverter>
+                    struct TaskCopyConvert
+                    {
+                        using Size = size::Size<TExtent>;
+                        using ElemDst = elem::Elem<TBufDst>;
+                        using ElemSrc = typename std::remove_const<elem::Elem<TBufSrc>>::type;
+
+                        static_assert(
+                            dim::Dim<TBufDst>::value == dim::Dim<TBufSrc>::value,
+                            "The source and the destination buffers are required to have the same dimensionality!");
+                        static_assert(
+                            dim::Dim<TBufDst>::value == dim::Dim<TExtent>::value,
+                            "The buffers and the extent are required to have the same dimensionality!");
+                        static_assert(
+                            dim::Dim<TBufDst>::value <= 3u,
+                            "The converting copy is only implemented for up to three dimensions!");
+
+                        //-----------------------------------------------------------------------------
+                        //! Constructor.
+                        //-----------------------------------------------------------------------------
+                        TaskCopyConvert(
+                            TBufDst & bufDst,
+                            TBufSrc const & bufSrc,
+                            TExtent const & extent,
+                            TConverter const & converter) :
+                                m_converter(converter),
+                                m_extentWidth(extent::getWidth(extent)),
+                                m_extentHeight(extent::getHeight(extent)),
+                                m_extentDepth(extent::getDepth(extent)),
+                                m_dstPitchBytes(static_cast<Size>(mem::view::getPitchBytes<dim::Dim<TBufDst>::value - 1u>(bufDst))),
+                                m_srcPitchBytes(static_cast<Size>(mem::view::getPitchBytes<dim::Dim<TBufSrc>::value - 1u>(bufSrc))),
+                                m_dstSliceSizeBytes(static_cast<Size>(m_dstPitchBytes * extent::getHeight(mem::view::getBuf(bufDst)))),
+                                m_srcSliceSizeBytes(static_cast<Size>(m_srcPitchBytes * extent::getHeight(mem::view::getBuf(bufSrc)))),
+                                m_dstMemNative(reinterpret_cast<std::uint8_t *>(mem::view::getPtrNative(bufDst))),
+                                m_srcMemNative(reinterpret_cast<std::uint8_t const *>(mem::view::getPtrNative(bufSrc)))
+                        {
+                            assert(m_extentWidth <= static_cast<Size>(extent::getWidth(bufDst)));
+                            assert(m_extentHeight <= static_cast<Size>(extent::getHeight(bufDst)));
+                            assert(m_extentDepth <= static_cast<Size>(extent::getDepth(bufDst)));
+                            assert(m_extentWidth <= static_cast<Size>(extent::getWidth(bufSrc)));
+                            assert(m_extentHeight <= static_cast<Size>(extent::getHeight(bufSrc)));
+                            assert(m_extentDepth <= static_cast<Size>(extent::getDepth(bufSrc)));
+                        }
+                        //-----------------------------------------------------------------------------
+                        //!
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto operator()() const
+                        -> void
+                        {
+                            ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+#if ALPAKA_DEBUG >= ALPAKA_DEBUG_FULL
+                            std::cout << BOOST_CURRENT_FUNCTION
+                                << " ew: " << m_extentWidth
+                                << " eh: " << m_extentHeight
+                                << " ed: " << m_extentDepth
+                                << " dpitchb: " << m_dstPitchBytes
+                                << " spitchb: " << m_srcPitchBytes
+                                << std::endl;
+#endif
+                            for(auto z(decltype(m_extentDepth)(0)); z < m_extentDepth; ++z)
+                            {
+                                for(auto y(decltype(m_extentHeight)(0)); y < m_extentHeight; ++y)
+                                {
+                                    convertRow(
+                                        reinterpret_cast<ElemDst *>(m_dstMemNative + y*m_dstPitchBytes + z*m_dstSliceSizeBytes),
+                                        reinterpret_cast<ElemSrc const *>(m_srcMemNative + y*m_srcPitchBytes + z*m_srcSliceSizeBytes));
+                                }
+                            }
+                        }
+
+                    private:
+                        //-----------------------------------------------------------------------------
+                        //! Converts one row.
+                        //!
+                        //! The loop body is a plain element wise conversion so the compiler is able to vectorize it.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto convertRow(
+                            ElemDst * const pDst,
+                            ElemSrc const * const pSrc) const
+                        -> void
+                        {
+                            auto const converter(m_converter);
+                            auto const width(m_extentWidth);
+                            for(auto x(decltype(width)(0)); x < width; ++x)
+                            {
+                                pDst[x] = converter.template convert<ElemDst>(pSrc[x]);
+                            }
+                        }
+
+                        TConverter m_converter;
+
+                        Size m_extentWidth;
+                        Size m_extentHeight;
+                        Size m_extentDepth;
+
+                        Size m_dstPitchBytes;
+                        Size m_srcPitchBytes;
+                        Size m_dstSliceSizeBytes;
+                        Size m_srcSliceSizeBytes;
+
+                        std::uint8_t * m_dstMemNative;
+                        std::uint8_t const * m_srcMemNative;
+                    };
+                }
+            }
+
+            namespace traits
+            {
+                //#############################################################################
+                //! The CPU device memory converting copy trait specialization.
+                //#############################################################################
+                template<
+                    typename TDim>
+                struct TaskCopyConvert<
+                    TDim,
+                    dev::DevCpu,
+                    dev::DevCpu>
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    template<
+                        typename TExtent,
+                        typename TBufSrc,
+                        typename TBufDst,
+                        typename TConverter>
+                    ALPAKA_FN_HOST static auto taskCopyConvert(
+                        TBufDst & bufDst,
+                        TBufSrc const & bufSrc,
+                        TExtent const & extent,
+                        TConverter const & converter)
+                    -> cpu::detail::TaskCopyConvert<
+                        TBufDst,
+                        TBufSrc,
+                        TExtent,
+                        TConverter>
+                    {
+                        return
+                            cpu::detail::TaskCopyConvert<
+                                TBufDst,
+                                TBufSrc,
+                                TExtent,
+                                TConverter>(
+                                    bufDst,
+                                    bufSrc,
+                                    extent,
+                                    converter);
+                    }
+                };
+            }
+        }
+    }
+}
@@ -0,0 +1,400 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/dim/DimIntegralConst.hpp>  // dim::DimInt<N>
+#include <alpaka/extent/Traits.hpp>         // extent::getXXX
+#include <alpaka/mem/view/Traits.hpp>       // mem::view::TaskCopyPermuted, ...
+#include <alpaka/stream/StreamCpuAsync.hpp> // stream::StreamCpuAsync
+#include <alpaka/stream/StreamCpuSync.hpp>  // stream::StreamCpuSync
+#include <alpaka/vec/Vec.hpp>               // Vec
+
+#include <boost/predef.h>                   // BOOST_ARCH_X86
+
+#if BOOST_ARCH_X86 && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1)))
+    #define ALPAKA_MEM_CPU_COPY_PERMUTED_SSE
+    #include <xmmintrin.h>                  // _MM_TRANSPOSE4_PS, _mm_loadu_ps, _mm_storeu_ps
+#endif
+
+#include <algorithm>                        // std::min
+#include <array>                            // std::array
+#include <cassert>                          // assert
+#include <cstring>                          // std::memcpy
+#include <stdexcept>                        // std::runtime_error
+
+namespace alpaka
+{
+    namespace dev
+    {
+        class DevCpu;
+    }
+}
+
+namespace alpaka
+{
+    namespace mem
+    {
+        namespace view
+        {
+            namespace cpu
+            {
+                namespace detail
+                {
+                    //-----------------------------------------------------------------------------
+                    //! The edge length in elements of the square tiles transposed at once.
+                    //! A source and a destination tile of 8 byte elements fit into a 32 KiB L1 cache.
+                    //-----------------------------------------------------------------------------
+                    static constexpr std::size_t copyPermutedTileElems = 32u;
+
+                    //#############################################################################
+                    //! Transposes a tile whose elements are contiguous along the rows in the destination and along the columns in the source.
+                    //#############################################################################
+                    template<
+                        std::size_t TElemSize>
+                    struct TransposeTile
+                    {
+                        //-----------------------------------------------------------------------------
+                        //!
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST static auto transposeTile(
+                            std::uint8_t * const pDst,
+                            std::size_t const & dstRowPitchBytes,
+                            std::uint8_t const * const pSrc,
+                            std::size_t const & srcRowPitchBytes,
+                            std::size_t const & rows,
+                            std::size_t const & cols)
+                        -> void
+                        {
+                            for(std::size_t r(0u); r < rows; ++r)
+                            {
+                                for(std::size_t c(0u); c < cols; ++c)
+                                {
+                                    std::memcpy(
+                                        pDst + r*dstRowPitchBytes + c*TElemSize,
+                                        pSrc + c*srcRowPitchBytes + r*TElemSize,
+                                        TElemSize);
+                                }
+                            }
+                        }
+                    };
+#if defined(ALPAKA_MEM_CPU_COPY_PERMUTED_SSE)
+                    //#############################################################################
+                    //! Transposes a tile of 4 byte elements with 4x4 in-register transposes.
+                    //#############################################################################
+                    template<>
+                    struct TransposeTile<
+                        4u>
+                    {
+                        //-----------------------------------------------------------------------------
+                        //!
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST static auto transposeTile(
+                            std::uint8_t * const pDst,
+                            std::size_t const & dstRowPitchBytes,
+                            std::uint8_t const * const pSrc,
+                            std::size_t const & srcRowPitchBytes,
+                            std::size_t const & rows,
+                            std::size_t const & cols)
+                        -> void
+                        {
+                            // The shuffles only move bits so this is valid for all 4 byte element types.
+                            std::size_t const rows4(rows - rows % 4u);
+                            std::size_t const cols4(cols - cols % 4u);
+                            for(std::size_t r(0u); r < rows4; r += 4u)
+                            {
+                                for(std::size_t c(0u); c < cols4; c += 4u)
+                                {
+                                    std::uint8_t const * const pSrcBlock(pSrc + c*srcRowPitchBytes + r*4u);
+                                    __m128 row0(_mm_loadu_ps(reinterpret_cast<float const *>(pSrcBlock)));
+                                    __m128 row1(_mm_loadu_ps(reinterpret_cast<float const *>(pSrcBlock + srcRowPitchBytes)));
+                                    __m128 row2(_mm_loadu_ps(reinterpret_cast<float const *>(pSrcBlock + 2u*srcRowPitchBytes)));
+                                    __m128 row3(_mm_loadu_ps(reinterpret_cast<float const *>(pSrcBlock + 3u*srcRowPitchBytes)));
+                                    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+                                    std::uint8_t * const pDstBlock(pDst + r*dstRowPitchBytes + c*4u);
+                                    _mm_storeu_ps(reinterpret_cast<float *>(pDstBlock), row0);
+                                    _mm_storeu_ps(reinterpret_cast<float *>(pDstBlock + dstRowPitchBytes), row1);
+                                    _mm_storeu_ps(reinterpret_cast<float *>(pDstBlock + 2u*dstRowPitchBytes), row2);
+                                    _mm_storeu_ps(reinterpret_cast<float *>(pDstBlock + 3u*dstRowPitchBytes), row3);
+                                }
+                            }
+                            // The remaining columns of the full rows.
+                            if(cols4 < cols)
+                            {
+                                transposeTileScalar(pDst + cols4*4u, dstRowPitchBytes, pSrc + cols4*srcRowPitchBytes, srcRowPitchBytes, rows4, cols - cols4);
+                            }
+                            // The remaining rows.
+                            if(rows4 < rows)
+                            {
+                                transposeTileScalar(pDst + rows4*dstRowPitchBytes, dstRowPitchBytes, pSrc + rows4*4u, srcRowPitchBytes, rows - rows4, cols);
+                            }
+                        }
+                        //-----------------------------------------------------------------------------
+                        //!
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST static auto transposeTileScalar(
+                            std::uint8_t * const pDst,
+                            std::size_t const & dstRowPitchBytes,
+                            std::uint8_t const * const pSrc,
+                            std::size_t const & srcRowPitchBytes,
+                            std::size_t const & rows,
+                            std::size_t const & cols)
+                        -> void
+                        {
+                            for(std::size_t r(0u); r < rows; ++r)
+                            {
+                                for(std::size_t c(0u); c < cols; ++c)
+                                {
+                                    std::memcpy(
+                                        pDst + r*dstRowPitchBytes + c*4u,
+                                        pSrc + c*srcRowPitchBytes + r*4u,
+                                        4u);
+                                }
+                            }
+                        }
+                    };
+#endif
+
+                    //#############################################################################
+                    //! The CPU device memory dimension permuting copy task.
+                    //!
+                    //! The two destination dimensions that are contiguous in the destination and in the source respectively are copied in cache sized tiles.
+                    //! All other dimensions are iterated in the destination order.
+                    //#############################################################################
+                    template<
+                        typename TBufDst,
+                        typename TBufSrc,
+                        typename TExtent>
+                    struct TaskCopyPermuted
+                    {
+                        using Dim = dim::Dim<TBufDst>;
+                        using Size = size::Size<TExtent>;
+                        using Elem = elem::Elem<TBufDst>;
+
+                        static_assert(
+                            dim::Dim<TBufDst>::value == dim::Dim<TBufSrc>::value,
+                            "The source and the destination buffers are required to have the same dimensionality!");
+                        static_assert(
+                            dim::Dim<TBufDst>::value == dim::Dim<TExtent>::value,
+                            "The buffers and the extent are required to have the same dimensionality!");
+                        static_assert(
+                            std::is_same<elem::Elem<TBufDst>, typename std::remove_const<elem::Elem<TBufSrc>>::type>::value,
+                            "The source and the destination buffers are required to have the same element type!");
+
+                        //-----------------------------------------------------------------------------
+                        //! Constructor.
+                        //-----------------------------------------------------------------------------
+                        TaskCopyPermuted(
+                            TBufDst & bufDst,
+                            TBufSrc const & bufSrc,
+                            TExtent const & extent,
+                            Vec<Dim, Size> const & permutation) :
+                                m_dstMemNative(reinterpret_cast<std::uint8_t *>(mem::view::getPtrNative(bufDst))),
+                                m_srcMemNative(reinterpret_cast<std::uint8_t const *>(mem::view::getPtrNative(bufSrc))),
+                                m_srcInnerDim(0u)
+                        {
+                            auto const srcExtent(extent::getExtentVec(extent));
+                            auto const dstPitchBytes(mem::view::getPitchBytesVec(bufDst));
+                            auto const srcPitchBytes(mem::view::getPitchBytesVec(bufSrc));
+
+                            std::array<bool, Dim::value> srcDimUsed;
+                            srcDimUsed.fill(false);
+                            for(std::size_t d(0u); d < Dim::value; ++d)
+                            {
+                                auto const srcDim(static_cast<std::size_t>(permutation[d]));
+                                if((srcDim >= Dim::value) || srcDimUsed[srcDim])
+                                {
+                                    throw std::runtime_error("The permutation has to contain each dimension exactly once!");
+                                }
+                                srcDimUsed[srcDim] = true;
+
+                                m_extent[d] = static_cast<std::size_t>(srcExtent[srcDim]);
+                                m_dstStrideBytes[d] = (d == Dim::value - 1u) ? sizeof(Elem) : static_cast<std::size_t>(dstPitchBytes[d + 1u]);
+                                m_srcStrideBytes[d] = (srcDim == Dim::value - 1u) ? sizeof(Elem) : static_cast<std::size_t>(srcPitchBytes[srcDim + 1u]);
+                                if(srcDim == Dim::value - 1u)
+                                {
+                                    m_srcInnerDim = d;
+                                }
+
+                                assert(m_extent[d] <= static_cast<std::size_t>(extent::getExtentVec(bufDst)[d]));
+                            }
+                        }
+                        //-----------------------------------------------------------------------------
+                        //!
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto operator()() const
+                        -> void
+                        {
+                            ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                            std::size_t const dstInnerDim(Dim::value - 1u);
+
+                            for(std::size_t d(0u); d < Dim::value; ++d)
+                            {
+                                if(m_extent[d] == 0u)
+                                {
+                                    return;
+                                }
+                            }
+
+                            // Iterate all dimensions except the two tiled ones.
+                            std::array<std::size_t, Dim::value> idx;
+                            idx.fill(0u);
+                            while(true)
+                            {
+                                std::size_t dstOffsetBytes(0u);
+                                std::size_t srcOffsetBytes(0u);
+                                for(std::size_t d(0u); d < Dim::value; ++d)
+                                {
+                                    dstOffsetBytes += idx[d] * m_dstStrideBytes[d];
+                                    srcOffsetBytes += idx[d] * m_srcStrideBytes[d];
+                                }
+
+                                if(m_srcInnerDim == dstInnerDim)
+                                {
+                                    // The innermost dimension is not permuted so whole rows are contiguous in both buffers.
+                                    std::memcpy(
+                                        m_dstMemNative + dstOffsetBytes,
+                                        m_srcMemNative + srcOffsetBytes,
+                                        m_extent[dstInnerDim] * sizeof(Elem));
+                                }
+                                else
+                                {
+                                    copyTiled(
+                                        m_dstMemNative + dstOffsetBytes,
+                                        m_srcMemNative + srcOffsetBytes);
+                                }
+
+                                // Increment the index of the outer dimensions starting with the fastest varying one.
+                                std::size_t d(Dim::value);
+                                while(d > 0u)
+                                {
+                                    --d;
+                                    if((d == dstInnerDim) || (d == m_srcInnerDim))
+                                    {
+                                        continue;
+                                    }
+                                    if(++idx[d] < m_extent[d])
+                                    {
+                                        break;
+                                    }
+                                    idx[d] = 0u;
+                                }
+                                // All indices wrapped around.
+                                bool finished(true);
+                                for(std::size_t i(0u); i < Dim::value; ++i)
+                                {
+                                    finished = finished && (idx[i] == 0u);
+                                }
+                                if(finished)
+                                {
+                                    return;
+                                }
+                            }
+                        }
+
+                    private:
+                        //-----------------------------------------------------------------------------
+                        //! Copies the plane spanned by the destination inner dimension and the source inner dimension tile by tile.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto copyTiled(
+                            std::uint8_t * const pDst,
+                            std::uint8_t const * const pSrc) const
+                        -> void
+                        {
+                            std::size_t const dstInnerDim(Dim::value - 1u);
+                            // The rows of the plane are contiguous in the destination, the columns in the source.
+                            std::size_t const rows(m_extent[m_srcInnerDim]);
+                            std::size_t const cols(m_extent[dstInnerDim]);
+                            std::size_t const dstRowPitchBytes(m_dstStrideBytes[m_srcInnerDim]);
+                            std::size_t const srcColPitchBytes(m_srcStrideBytes[dstInnerDim]);
+
+                            for(std::size_t r(0u); r < rows; r += copyPermutedTileElems)
+                            {
+                                for(std::size_t c(0u); c < cols; c += copyPermutedTileElems)
+                                {
+                                    TransposeTile<sizeof(Elem)>::transposeTile(
+                                        pDst + r*dstRowPitchBytes + c*sizeof(Elem),
+                                        dstRowPitchBytes,
+                                        pSrc + c*srcColPitchBytes + r*sizeof(Elem),
+                                        srcColPitchBytes,
+                                        std::min(copyPermutedTileElems, rows - r),
+                                        std::min(copyPermutedTileElems, cols - c));
+                                }
+                            }
+                        }
+
+                        std::array<std::size_t, Dim::value> m_extent;
+                        std::array<std::size_t, Dim::value> m_dstStrideBytes;
+                        std::array<std::size_t, Dim::value> m_srcStrideBytes;
+
+                        std::uint8_t * m_dstMemNative;
+                        std::uint8_t const * m_srcMemNative;
+
+                        std::size_t m_srcInnerDim;
+                    };
+                }
+            }
+
+            namespace traits
+            {
+                //#############################################################################
+                //! The CPU device memory permuting copy trait specialization.
+                //#############################################################################
+                template<
+                    typename TDim>
+                struct TaskCopyPermuted<
+                    TDim,
+                    dev::DevCpu,
+                    dev::DevCpu>
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    template<
+                        typename TExtent,
+                        typename TBufSrc,
+                        typename TBufDst>
+                    ALPAKA_FN_HOST static auto taskCopyPermuted(
+                        TBufDst & bufDst,
+                        TBufSrc const & bufSrc,
+                        TExtent const & extent,
+                        Vec<dim::Dim<TExtent>, size::Size<TExtent>> const & permutation)
+                    -> cpu::detail::TaskCopyPermuted<
+                        TBufDst,
+                        TBufSrc,
+                        TExtent>
+                    {
+                        return
+                            cpu::detail::TaskCopyPermuted<
+                                TBufDst,
+                                TBufSrc,
+                                TExtent>(
+                                    bufDst,
+                                    bufSrc,
+                                    extent,
+                                    permutation);
+                    }
+                };
+            }
+        }
+    }
+}
@@ -0,0 +1,289 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/dim/DimIntegralConst.hpp>  // dim::DimInt<N>
+#include <alpaka/core/ParallelFor.hpp>      // core::parallelFor
+#include <alpaka/extent/Traits.hpp>         // extent::getXXX
+#include <alpaka/mem/view/Traits.hpp>       // mem::view::TaskFill, ...
+#include <alpaka/profiler/Profiler.hpp>     // ALPAKA_PROFILER_MEM_SCOPE
+#include <alpaka/stream/StreamCpuAsync.hpp> // stream::StreamCpuAsync
+#include <alpaka/stream/StreamCpuSync.hpp>  // stream::StreamCpuSync
+
+#include <algorithm>                        // std::min
+#include <cassert>                          // assert
+#include <cstring>                          // std::memcpy, std::memset
+#include <thread>                           // std::thread::hardware_concurrency
+
+namespace alpaka
+{
+    namespace dev
+    {
+        class DevCpu;
+    }
+}
+
+namespace alpaka
+{
+    namespace mem
+    {
+        namespace view
+        {
+            namespace cpu
+            {
+                namespace detail
+                {
+                    //-----------------------------------------------------------------------------
+                    //! Fills below this number of bytes are executed by the calling thread only.
+                    //-----------------------------------------------------------------------------
+                    static constexpr std::size_t fillParallelThresholdBytes = 2u << 20u;
+                    //-----------------------------------------------------------------------------
+                    //! The minimum number of bytes filled by each thread of a parallel fill.
+                    //-----------------------------------------------------------------------------
+                    static constexpr std::size_t fillThreadMinBytes = 1u << 20u;
+                    //-----------------------------------------------------------------------------
+                    //! The size of the pattern replicated within a row before it is copied as a whole.
+                    //! This is small enough to stay in the L1 cache while being copied.
+                    //-----------------------------------------------------------------------------
+                    static constexpr std::size_t fillPatternBytesMax = 4096u;
+
+                    //#############################################################################
+                    //! The CPU device memory fill task.
+                    //!
+                    //! Sets each element of CPU memory to a value.
+                    //#############################################################################
+                    template<
+                        typename TBuf,
+                        typename TExtent>
+                    struct TaskFill
+                    {
+                        using Size = size::Size<TExtent>;
+                        using Elem = elem::Elem<TBuf>;
+
+                        static_assert(
+                            dim::Dim<TBuf>::value == dim::Dim<TExtent>::value,
+                            "The destination buffer and the extent are required to have the same dimensionality!");
+
+                        //-----------------------------------------------------------------------------
+                        //! Constructor.
+                        //-----------------------------------------------------------------------------
+                        TaskFill(
+                            TBuf & buf,
+                            Elem const & value,
+                            TExtent const & extent) :
+                                m_value(value),
+                                m_extentWidth(extent::getWidth(extent)),
+                                m_extentHeight(extent::getHeight(extent)),
+                                m_extentDepth(extent::getDepth(extent)),
+                                m_dstPitchBytes(static_cast<Size>(mem::view::getPitchBytes<dim::Dim<TBuf>::value - 1u>(buf))),
+                                m_dstSliceSizeBytes(static_cast<Size>(m_dstPitchBytes * extent::getHeight(buf))),
+                                m_dstMemNative(reinterpret_cast<std::uint8_t *>(mem::view::getPtrNative(buf)))
+                        {
+                            assert(m_extentWidth <= static_cast<Size>(extent::getWidth(buf)));
+                            assert(m_extentHeight <= static_cast<Size>(extent::getHeight(buf)));
+                            assert(m_extentDepth <= static_cast<Size>(extent::getDepth(buf)));
+                            assert(m_extentWidth * sizeof(Elem) <= m_dstPitchBytes);
+                        }
+                        //-----------------------------------------------------------------------------
+                        //!
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto operator()() const
+                        -> void
+                        {
+                            ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                            auto const elemCount(m_extentWidth * m_extentHeight * m_extentDepth);
+                            auto const fillBytes(static_cast<std::size_t>(elemCount) * sizeof(Elem));
+
+#if ALPAKA_DEBUG >= ALPAKA_DEBUG_FULL
+                            std::cout << BOOST_CURRENT_FUNCTION
+                                << " ew: " << m_extentWidth
+                                << " eh: " << m_extentHeight
+                                << " ed: " << m_extentDepth
+                                << " dptr: " << reinterpret_cast<void *>(m_dstMemNative)
+                                << " dpitchb: " << m_dstPitchBytes
+                                << std::endl;
+#endif
+                            ALPAKA_PROFILER_MEM_SCOPE(Fill, fillBytes);
+
+                            // Large fills are split into contiguous ranges of elements executed in parallel.
+                            std::size_t threadCount(1u);
+                            if(fillBytes >= fillParallelThresholdBytes)
+                            {
+                                threadCount = std::min(
+                                    static_cast<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u)),
+                                    fillBytes / fillThreadMinBytes);
+                            }
+
+                            if(threadCount <= 1u)
+                            {
+                                fillElems(0u, elemCount);
+                            }
+                            else
+                            {
+                                auto const threadElemCount(
+                                    static_cast<Size>(
+                                        (static_cast<std::size_t>(elemCount) + threadCount - 1u) / threadCount));
+
+                                core::parallelFor(
+                                    threadCount,
+                                    [this, threadElemCount, elemCount](std::size_t const & t)
+                                    {
+                                        auto const begin(std::min(static_cast<Size>(t * threadElemCount), elemCount));
+                                        auto const end(std::min(static_cast<Size>(begin + threadElemCount), elemCount));
+                                        fillElems(begin, end);
+                                    });
+                            }
+                        }
+
+                    private:
+                        //-----------------------------------------------------------------------------
+                        //! Fills the elements [begin, end) of the extent linearized in row major order.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto fillElems(
+                            Size const & begin,
+                            Size const & end) const
+                        -> void
+                        {
+                            auto i(begin);
+                            while(i < end)
+                            {
+                                auto const row(i / m_extentWidth);
+                                auto const x(i % m_extentWidth);
+                                auto const y(row % m_extentHeight);
+                                auto const z(row / m_extentHeight);
+                                auto const count(std::min(static_cast<Size>(m_extentWidth - x), static_cast<Size>(end - i)));
+
+                                fillRow(
+                                    reinterpret_cast<Elem *>(m_dstMemNative + z*m_dstSliceSizeBytes + y*m_dstPitchBytes) + x,
+                                    count);
+
+                                i += count;
+                            }
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! Fills count consecutive elements.
+                        //!
+                        //! The value is replicated by doubling a pattern in place until it reaches fillPatternBytesMax.
+                        //! The pattern is then copied as a whole, letting std::memcpy use the widest vector stores available.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto fillRow(
+                            Elem * const pDst,
+                            Size const & count) const
+                        -> void
+                        {
+                            if(count == 0u)
+                            {
+                                return;
+                            }
+
+                            if(sizeof(Elem) == 1u)
+                            {
+                                std::memset(
+                                    reinterpret_cast<void *>(pDst),
+                                    static_cast<int>(*reinterpret_cast<std::uint8_t const *>(&m_value)),
+                                    static_cast<std::size_t>(count));
+                                return;
+                            }
+
+                            std::memcpy(
+                                reinterpret_cast<void *>(pDst),
+                                reinterpret_cast<void const *>(&m_value),
+                                sizeof(Elem));
+                            Size filled(1u);
+
+                            // Double the pattern.
+                            while((filled < count) && (static_cast<std::size_t>(filled) * sizeof(Elem) < fillPatternBytesMax))
+                            {
+                                auto const copyCount(std::min(filled, static_cast<Size>(count - filled)));
+                                std::memcpy(
+                                    reinterpret_cast<void *>(pDst + filled),
+                                    reinterpret_cast<void const *>(pDst),
+                                    static_cast<std::size_t>(copyCount) * sizeof(Elem));
+                                filled += copyCount;
+                            }
+
+                            // Copy the pattern.
+                            auto const patternCount(filled);
+                            while(filled < count)
+                            {
+                                auto const copyCount(std::min(patternCount, static_cast<Size>(count - filled)));
+                                std::memcpy(
+                                    reinterpret_cast<void *>(pDst + filled),
+                                    reinterpret_cast<void const *>(pDst),
+                                    static_cast<std::size_t>(copyCount) * sizeof(Elem));
+                                filled += copyCount;
+                            }
+                        }
+
+                        Elem m_value;
+
+                        Size m_extentWidth;
+                        Size m_extentHeight;
+                        Size m_extentDepth;
+
+                        Size m_dstPitchBytes;
+                        Size m_dstSliceSizeBytes;
+
+                        std::uint8_t * m_dstMemNative;
+                    };
+                }
+            }
+
+            namespace traits
+            {
+                //#############################################################################
+                //! The CPU device memory fill trait specialization.
+                //#############################################################################
+                template<
+                    typename TDim>
+                struct TaskFill<
+                    TDim,
+                    dev::DevCpu>
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    template<
+                        typename TExtent,
+                        typename TBuf>
+                    ALPAKA_FN_HOST static auto taskFill(
+                        TBuf & buf,
+                        elem::Elem<TBuf> const & value,
+                        TExtent const & extent)
+                    -> cpu::detail::TaskFill<
+                        TBuf,
+                        TExtent>
+                    {
+                        return
+                            cpu::detail::TaskFill<
+                                TBuf,
+                                TExtent>(
+                                    buf,
+                                    value,
+                                    extent);
+                    }
+                };
+            }
+        }
+    }
+}
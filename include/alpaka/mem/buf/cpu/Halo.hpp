@@ -0,0 +1,434 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/core/ParallelFor.hpp>      // core::parallelFor
+#include <alpaka/extent/Traits.hpp>         // extent::getExtentVec
+#include <alpaka/mem/halo/Traits.hpp>       // mem::halo::TaskPack, ...
+#include <alpaka/mem/view/Traits.hpp>       // mem::view::getPitchBytesVec, ...
+#include <alpaka/stream/StreamCpuAsync.hpp> // stream::StreamCpuAsync
+#include <alpaka/stream/StreamCpuSync.hpp>  // stream::StreamCpuSync
+
+#include <algorithm>                        // std::min
+#include <array>                            // std::array
+#include <cstring>                          // std::memcpy
+#include <stdexcept>                        // std::runtime_error
+#include <thread>                           // std::thread::hardware_concurrency
+#include <vector>                           // std::vector
+
+namespace alpaka
+{
+    namespace dev
+    {
+        class DevCpu;
+    }
+}
+
+namespace alpaka
+{
+    namespace mem
+    {
+        namespace halo
+        {
+            namespace cpu
+            {
+                namespace detail
+                {
+                    //-----------------------------------------------------------------------------
+                    //! Halo transfers below this number of bytes are executed by the calling thread only.
+                    //-----------------------------------------------------------------------------
+                    static constexpr std::size_t haloParallelThresholdBytes = 1u << 20u;
+                    //-----------------------------------------------------------------------------
+                    //! The minimum number of bytes transferred by each thread of a parallel halo transfer.
+                    //-----------------------------------------------------------------------------
+                    static constexpr std::size_t haloThreadMinBytes = 256u << 10u;
+
+                    //#############################################################################
+                    //! The geometry of the halo regions shared by the pack and the unpack task.
+                    //!
+                    //! Each region is split into rows along the last dimension which are contiguous in the buffer and in the staging buffer.
+                    //#############################################################################
+                    template<
+                        typename TDim>
+                    class TaskHaloBase
+                    {
+                    protected:
+                        //#############################################################################
+                        //! A region of the buffer.
+                        //#############################################################################
+                        struct Region
+                        {
+                            std::array<std::size_t, TDim::value> m_offset;
+                            std::array<std::size_t, TDim::value> m_extent;
+                            std::size_t m_rowCount;
+                            std::size_t m_rowBytes;
+                            std::size_t m_stagingOffsetBytes;
+                        };
+
+                        //-----------------------------------------------------------------------------
+                        //! Constructor.
+                        //!
+                        //! \param isGhost If the ghost layer is addressed instead of the innermost layer of the buffer interior.
+                        //-----------------------------------------------------------------------------
+                        template<
+                            typename TBuf>
+                        TaskHaloBase(
+                            TBuf const & buf,
+                            Vec<TDim, size::Size<TBuf>> const & haloWidth,
+                            std::vector<Direction<TDim>> const & directions,
+                            std::size_t const & stagingBytes,
+                            bool const & isGhost) :
+                                m_stagingBytes(0u)
+                        {
+                            auto const extent(extent::getExtentVec(buf));
+                            auto const pitchBytes(mem::view::getPitchBytesVec(buf));
+                            mem::halo::detail::checkHalo(extent, haloWidth, directions);
+
+                            for(std::size_t d(0u); d < TDim::value; ++d)
+                            {
+                                m_strideBytes[d] = (d == TDim::value - 1u) ? sizeof(elem::Elem<TBuf>) : static_cast<std::size_t>(pitchBytes[d + 1u]);
+                            }
+
+                            m_regions.reserve(directions.size());
+                            for(auto const & direction : directions)
+                            {
+                                Region region;
+                                region.m_rowCount = 1u;
+                                for(std::size_t d(0u); d < TDim::value; ++d)
+                                {
+                                    auto const e(static_cast<std::size_t>(extent[d]));
+                                    auto const h(static_cast<std::size_t>(haloWidth[d]));
+                                    if(direction[d] == 0)
+                                    {
+                                        region.m_offset[d] = h;
+                                        region.m_extent[d] = e - 2u * h;
+                                    }
+                                    else
+                                    {
+                                        region.m_offset[d] = (direction[d] < 0)
+                                            ? (isGhost ? 0u : h)
+                                            : (isGhost ? e - h : e - 2u * h);
+                                        region.m_extent[d] = h;
+                                    }
+                                    if(d != TDim::value - 1u)
+                                    {
+                                        region.m_rowCount *= region.m_extent[d];
+                                    }
+                                }
+                                region.m_rowBytes = region.m_extent[TDim::value - 1u] * sizeof(elem::Elem<TBuf>);
+                                if(region.m_rowBytes == 0u)
+                                {
+                                    region.m_rowCount = 0u;
+                                }
+                                region.m_stagingOffsetBytes = m_stagingBytes;
+                                m_stagingBytes += region.m_rowCount * region.m_rowBytes;
+                                m_regions.push_back(region);
+                            }
+
+                            if(m_stagingBytes > stagingBytes)
+                            {
+                                throw std::runtime_error("The staging buffer is too small to hold the halo regions!");
+                            }
+                        }
+
+                        //-----------------------------------------------------------------------------
+                        //! Calls f(bufOffsetBytes, stagingOffsetBytes, rowBytes) for each row of all regions.
+                        //!
+                        //! Large transfers are split into contiguous byte ranges of the staging buffer executed in parallel.
+                        //-----------------------------------------------------------------------------
+                        template<
+                            typename TFnObj>
+                        ALPAKA_FN_HOST auto forEachRow(
+                            TFnObj const & f) const
+                        -> void
+                        {
+                            std::size_t threadCount(1u);
+                            if(m_stagingBytes >= haloParallelThresholdBytes)
+                            {
+                                threadCount = std::min(
+                                    static_cast<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u)),
+                                    m_stagingBytes / haloThreadMinBytes);
+                            }
+
+                            if(threadCount <= 1u)
+                            {
+                                forEachRowInRange(f, 0u, m_stagingBytes);
+                            }
+                            else
+                            {
+                                auto const threadBytes((m_stagingBytes + threadCount - 1u) / threadCount);
+
+                                core::parallelFor(
+                                    threadCount,
+                                    [this, &f, threadBytes](std::size_t const & t)
+                                    {
+                                        auto const begin(std::min(t * threadBytes, m_stagingBytes));
+                                        auto const end(std::min(begin + threadBytes, m_stagingBytes));
+                                        forEachRowInRange(f, begin, end);
+                                    });
+                            }
+                        }
+
+                    private:
+                        //-----------------------------------------------------------------------------
+                        //! Calls f for each row starting within the staging buffer byte range [begin, end).
+                        //-----------------------------------------------------------------------------
+                        template<
+                            typename TFnObj>
+                        ALPAKA_FN_HOST auto forEachRowInRange(
+                            TFnObj const & f,
+                            std::size_t const & begin,
+                            std::size_t const & end) const
+                        -> void
+                        {
+                            for(auto const & region : m_regions)
+                            {
+                                auto const regionEnd(region.m_stagingOffsetBytes + region.m_rowCount * region.m_rowBytes);
+                                if((region.m_rowCount == 0u) || (regionEnd <= begin) || (region.m_stagingOffsetBytes >= end))
+                                {
+                                    continue;
+                                }
+
+                                // The first rows starting at or after begin and end respectively.
+                                auto const rowBegin((begin <= region.m_stagingOffsetBytes) ? 0u : (begin - region.m_stagingOffsetBytes + region.m_rowBytes - 1u) / region.m_rowBytes);
+                                auto const rowEnd(std::min((end - region.m_stagingOffsetBytes + region.m_rowBytes - 1u) / region.m_rowBytes, region.m_rowCount));
+
+                                for(auto row(rowBegin); row < rowEnd; ++row)
+                                {
+                                    // Decompose the row index into the indices of the outer dimensions.
+                                    std::size_t bufOffsetBytes(region.m_offset[TDim::value - 1u] * m_strideBytes[TDim::value - 1u]);
+                                    std::size_t rest(row);
+                                    std::size_t d(TDim::value - 1u);
+                                    while(d > 0u)
+                                    {
+                                        --d;
+                                        bufOffsetBytes += (region.m_offset[d] + rest % region.m_extent[d]) * m_strideBytes[d];
+                                        rest /= region.m_extent[d];
+                                    }
+
+                                    f(bufOffsetBytes, region.m_stagingOffsetBytes + row * region.m_rowBytes, region.m_rowBytes);
+                                }
+                            }
+                        }
+
+                        std::array<std::size_t, TDim::value> m_strideBytes;
+                        std::vector<Region> m_regions;
+                        std::size_t m_stagingBytes;
+                    };
+
+                    //#############################################################################
+                    //! The CPU halo pack task.
+                    //#############################################################################
+                    template<
+                        typename TStaging,
+                        typename TBuf>
+                    class TaskPack :
+                        private TaskHaloBase<dim::Dim<TBuf>>
+                    {
+                        static_assert(
+                            std::is_same<elem::Elem<TStaging>, typename std::remove_const<elem::Elem<TBuf>>::type>::value,
+                            "The staging buffer and the buffer are required to have the same element type!");
+
+                    public:
+                        //-----------------------------------------------------------------------------
+                        //! Constructor.
+                        //-----------------------------------------------------------------------------
+                        TaskPack(
+                            TStaging & staging,
+                            TBuf const & buf,
+                            Vec<dim::Dim<TBuf>, size::Size<TBuf>> const & haloWidth,
+                            std::vector<Direction<dim::Dim<TBuf>>> const & directions) :
+                                TaskHaloBase<dim::Dim<TBuf>>(
+                                    buf,
+                                    haloWidth,
+                                    directions,
+                                    static_cast<std::size_t>(extent::getWidth(staging)) * sizeof(elem::Elem<TStaging>),
+                                    false),
+                                m_stagingMemNative(reinterpret_cast<std::uint8_t *>(mem::view::getPtrNative(staging))),
+                                m_bufMemNative(reinterpret_cast<std::uint8_t const *>(mem::view::getPtrNative(buf)))
+                        {}
+                        //-----------------------------------------------------------------------------
+                        //!
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto operator()() const
+                        -> void
+                        {
+                            ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                            auto const pStaging(m_stagingMemNative);
+                            auto const pBuf(m_bufMemNative);
+                            this->forEachRow(
+                                [pStaging, pBuf](
+                                    std::size_t const & bufOffsetBytes,
+                                    std::size_t const & stagingOffsetBytes,
+                                    std::size_t const & rowBytes)
+                                {
+                                    std::memcpy(
+                                        pStaging + stagingOffsetBytes,
+                                        pBuf + bufOffsetBytes,
+                                        rowBytes);
+                                });
+                        }
+
+                    private:
+                        std::uint8_t * m_stagingMemNative;
+                        std::uint8_t const * m_bufMemNative;
+                    };
+
+                    //#############################################################################
+                    //! The CPU halo unpack task.
+                    //#############################################################################
+                    template<
+                        typename TBuf,
+                        typename TStaging>
+                    class TaskUnpack :
+                        private TaskHaloBase<dim::Dim<TBuf>>
+                    {
+                        static_assert(
+                            std::is_same<elem::Elem<TBuf>, typename std::remove_const<elem::Elem<TStaging>>::type>::value,
+                            "The buffer and the staging buffer are required to have the same element type!");
+
+                    public:
+                        //-----------------------------------------------------------------------------
+                        //! Constructor.
+                        //-----------------------------------------------------------------------------
+                        TaskUnpack(
+                            TBuf & buf,
+                            TStaging const & staging,
+                            Vec<dim::Dim<TBuf>, size::Size<TBuf>> const & haloWidth,
+                            std::vector<Direction<dim::Dim<TBuf>>> const & directions) :
+                                TaskHaloBase<dim::Dim<TBuf>>(
+                                    buf,
+                                    haloWidth,
+                                    directions,
+                                    static_cast<std::size_t>(extent::getWidth(staging)) * sizeof(elem::Elem<TStaging>),
+                                    true),
+                                m_bufMemNative(reinterpret_cast<std::uint8_t *>(mem::view::getPtrNative(buf))),
+                                m_stagingMemNative(reinterpret_cast<std::uint8_t const *>(mem::view::getPtrNative(staging)))
+                        {}
+                        //-----------------------------------------------------------------------------
+                        //!
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto operator()() const
+                        -> void
+                        {
+                            ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                            auto const pBuf(m_bufMemNative);
+                            auto const pStaging(m_stagingMemNative);
+                            this->forEachRow(
+                                [pBuf, pStaging](
+                                    std::size_t const & bufOffsetBytes,
+                                    std::size_t const & stagingOffsetBytes,
+                                    std::size_t const & rowBytes)
+                                {
+                                    std::memcpy(
+                                        pBuf + bufOffsetBytes,
+                                        pStaging + stagingOffsetBytes,
+                                        rowBytes);
+                                });
+                        }
+
+                    private:
+                        std::uint8_t * m_bufMemNative;
+                        std::uint8_t const * m_stagingMemNative;
+                    };
+                }
+            }
+
+            namespace traits
+            {
+                //#############################################################################
+                //! The CPU halo pack trait specialization.
+                //#############################################################################
+                template<
+                    typename TDim>
+                struct TaskPack<
+                    TDim,
+                    dev::DevCpu,
+                    dev::DevCpu>
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    template<
+                        typename TStaging,
+                        typename TBuf>
+                    ALPAKA_FN_HOST static auto taskPack(
+                        TStaging & staging,
+                        TBuf const & buf,
+                        Vec<TDim, size::Size<TBuf>> const & haloWidth,
+                        std::vector<Direction<TDim>> const & directions)
+                    -> cpu::detail::TaskPack<
+                        TStaging,
+                        TBuf>
+                    {
+                        return
+                            cpu::detail::TaskPack<
+                                TStaging,
+                                TBuf>(
+                                    staging,
+                                    buf,
+                                    haloWidth,
+                                    directions);
+                    }
+                };
+
+                //#############################################################################
+                //! The CPU halo unpack trait specialization.
+                //#############################################################################
+                template<
+                    typename TDim>
+                struct TaskUnpack<
+                    TDim,
+                    dev::DevCpu,
+                    dev::DevCpu>
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    template<
+                        typename TBuf,
+                        typename TStaging>
+                    ALPAKA_FN_HOST static auto taskUnpack(
+                        TBuf & buf,
+                        TStaging const & staging,
+                        Vec<TDim, size::Size<TBuf>> const & haloWidth,
+                        std::vector<Direction<TDim>> const & directions)
+                    -> cpu::detail::TaskUnpack<
+                        TBuf,
+                        TStaging>
+                    {
+                        return
+                            cpu::detail::TaskUnpack<
+                                TBuf,
+                                TStaging>(
+                                    buf,
+                                    staging,
+                                    haloWidth,
+                                    directions);
+                    }
+                };
+            }
+        }
+    }
+}
@@ -0,0 +1,260 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/dev/cpu/SysInfo.hpp>   // dev::cpu::detail::getLastLevelCacheSizeBytes
+#include <alpaka/core/Common.hpp>       // ALPAKA_FN_HOST
+
+#include <boost/predef.h>               // BOOST_ARCH_X86
+#include <boost/core/ignore_unused.hpp> // boost::ignore_unused
+
+#if BOOST_ARCH_X86 && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+    #define ALPAKA_MEM_CPU_NON_TEMPORAL_SSE2
+    #include <xmmintrin.h>              // _mm_prefetch, _mm_sfence
+    #include <emmintrin.h>              // _mm_stream_si128, _mm_loadu_si128, _mm_set1_epi8
+#endif
+
+#include <atomic>                       // std::atomic
+#include <cstddef>                      // std::size_t
+#include <cstdint>                      // std::uint8_t, std::uintptr_t
+#include <cstring>                      // std::memcpy, std::memset
+
+namespace alpaka
+{
+    namespace mem
+    {
+        namespace view
+        {
+            namespace cpu
+            {
+                //#############################################################################
+                //! The usage policy of non-temporal (streaming) stores for CPU memory copies and sets.
+                //#############################################################################
+                enum class StreamingStores
+                {
+                    Auto,       //!< Use streaming stores if the bytes written exceed the threshold (by default the last level cache size).
+                    Enabled,    //!< Always use streaming stores.
+                    Disabled,   //!< Never use streaming stores.
+                };
+
+                namespace detail
+                {
+                    //-----------------------------------------------------------------------------
+                    //! \return The storage of the streaming store policy.
+                    //! The initial value can be forced by defining ALPAKA_MEM_CPU_STREAMING_STORES_FORCE_ON or ALPAKA_MEM_CPU_STREAMING_STORES_FORCE_OFF.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto streamingStoresStorage()
+                    -> std::atomic<StreamingStores> &
+                    {
+                        static std::atomic<StreamingStores> streamingStores(
+#if defined(ALPAKA_MEM_CPU_STREAMING_STORES_FORCE_ON)
+                            StreamingStores::Enabled
+#elif defined(ALPAKA_MEM_CPU_STREAMING_STORES_FORCE_OFF)
+                            StreamingStores::Disabled
+#else
+                            StreamingStores::Auto
+#endif
+                            );
+                        return streamingStores;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The storage of the streaming store threshold in bytes.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto streamingStoresThresholdBytesStorage()
+                    -> std::atomic<std::size_t> &
+                    {
+                        // Fall back to a typical last level cache size if it can not be queried.
+                        static std::size_t const llcSizeBytes(dev::cpu::detail::getLastLevelCacheSizeBytes());
+                        static std::atomic<std::size_t> thresholdBytes(
+                            (llcSizeBytes > 0u) ? llcSizeBytes : static_cast<std::size_t>(8u << 20u));
+                        return thresholdBytes;
+                    }
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Sets the usage policy of non-temporal stores for all following CPU memory copies and sets.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto setStreamingStores(
+                    StreamingStores const & streamingStores)
+                -> void
+                {
+                    detail::streamingStoresStorage().store(streamingStores);
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The usage policy of non-temporal stores for CPU memory copies and sets.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getStreamingStores()
+                -> StreamingStores
+                {
+                    return detail::streamingStoresStorage().load();
+                }
+                //-----------------------------------------------------------------------------
+                //! Sets the number of bytes above which StreamingStores::Auto uses non-temporal stores.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto setStreamingStoresThresholdBytes(
+                    std::size_t const & thresholdBytes)
+                -> void
+                {
+                    detail::streamingStoresThresholdBytesStorage().store(thresholdBytes);
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The number of bytes above which StreamingStores::Auto uses non-temporal stores.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getStreamingStoresThresholdBytes()
+                -> std::size_t
+                {
+                    return detail::streamingStoresThresholdBytesStorage().load();
+                }
+
+                namespace detail
+                {
+                    //-----------------------------------------------------------------------------
+                    //! The number of bytes the source is prefetched ahead of the current copy position.
+                    //-----------------------------------------------------------------------------
+                    static constexpr std::size_t streamingPrefetchDistanceBytes = 512u;
+
+                    //-----------------------------------------------------------------------------
+                    //! \return If a memory operation writing the given number of bytes should use non-temporal stores.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto useStreamingStores(
+                        std::size_t const & sizeBytes)
+                    -> bool
+                    {
+#if defined(ALPAKA_MEM_CPU_NON_TEMPORAL_SSE2)
+                        switch(getStreamingStores())
+                        {
+                        case StreamingStores::Enabled:
+                            return true;
+                        case StreamingStores::Disabled:
+                            return false;
+                        default:
+                            return sizeBytes > getStreamingStoresThresholdBytes();
+                        }
+#else
+                        // There are no non-temporal stores available on this architecture.
+                        boost::ignore_unused(sizeBytes);
+                        return false;
+#endif
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The number of bytes from the given pointer to the next 16 byte aligned address.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto bytesToAlignment16(
+                        std::uint8_t const * const ptr,
+                        std::size_t const & sizeBytes)
+                    -> std::size_t
+                    {
+                        std::size_t const misalignment(static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(ptr) & 15u));
+                        std::size_t const headBytes((misalignment == 0u) ? 0u : (16u - misalignment));
+                        return (headBytes < sizeBytes) ? headBytes : sizeBytes;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Copies the memory bypassing the caches for the destination.
+                    //!
+                    //! The stores are weakly ordered. streamingStoresFence has to be called after the last one.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto memcpyStreaming(
+                        std::uint8_t * dst,
+                        std::uint8_t const * src,
+                        std::size_t sizeBytes)
+                    -> void
+                    {
+#if defined(ALPAKA_MEM_CPU_NON_TEMPORAL_SSE2)
+                        // Copy the unaligned head normally.
+                        std::size_t const headBytes(bytesToAlignment16(dst, sizeBytes));
+                        std::memcpy(dst, src, headBytes);
+                        dst += headBytes;
+                        src += headBytes;
+                        sizeBytes -= headBytes;
+
+                        // Copy whole cache lines.
+                        for(; sizeBytes >= 64u; sizeBytes -= 64u, dst += 64u, src += 64u)
+                        {
+                            _mm_prefetch(reinterpret_cast<char const *>(src + streamingPrefetchDistanceBytes), _MM_HINT_NTA);
+                            __m128i const v0(_mm_loadu_si128(reinterpret_cast<__m128i const *>(src)));
+                            __m128i const v1(_mm_loadu_si128(reinterpret_cast<__m128i const *>(src + 16u)));
+                            __m128i const v2(_mm_loadu_si128(reinterpret_cast<__m128i const *>(src + 32u)));
+                            __m128i const v3(_mm_loadu_si128(reinterpret_cast<__m128i const *>(src + 48u)));
+                            _mm_stream_si128(reinterpret_cast<__m128i *>(dst), v0);
+                            _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 16u), v1);
+                            _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 32u), v2);
+                            _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 48u), v3);
+                        }
+                        for(; sizeBytes >= 16u; sizeBytes -= 16u, dst += 16u, src += 16u)
+                        {
+                            _mm_stream_si128(
+                                reinterpret_cast<__m128i *>(dst),
+                                _mm_loadu_si128(reinterpret_cast<__m128i const *>(src)));
+                        }
+#endif
+                        // Copy the tail (or everything if there are no streaming stores) normally.
+                        std::memcpy(dst, src, sizeBytes);
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Sets the memory bypassing the caches.
+                    //!
+                    //! The stores are weakly ordered. streamingStoresFence has to be called after the last one.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto memsetStreaming(
+                        std::uint8_t * dst,
+                        std::uint8_t const & byte,
+                        std::size_t sizeBytes)
+                    -> void
+                    {
+#if defined(ALPAKA_MEM_CPU_NON_TEMPORAL_SSE2)
+                        // Set the unaligned head normally.
+                        std::size_t const headBytes(bytesToAlignment16(dst, sizeBytes));
+                        std::memset(dst, static_cast<int>(byte), headBytes);
+                        dst += headBytes;
+                        sizeBytes -= headBytes;
+
+                        __m128i const v(_mm_set1_epi8(static_cast<char>(byte)));
+                        for(; sizeBytes >= 64u; sizeBytes -= 64u, dst += 64u)
+                        {
+                            _mm_stream_si128(reinterpret_cast<__m128i *>(dst), v);
+                            _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 16u), v);
+                            _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 32u), v);
+                            _mm_stream_si128(reinterpret_cast<__m128i *>(dst + 48u), v);
+                        }
+                        for(; sizeBytes >= 16u; sizeBytes -= 16u, dst += 16u)
+                        {
+                            _mm_stream_si128(reinterpret_cast<__m128i *>(dst), v);
+                        }
+#endif
+                        // Set the tail (or everything if there are no streaming stores) normally.
+                        std::memset(dst, static_cast<int>(byte), sizeBytes);
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Makes all preceding non-temporal stores globally visible.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto streamingStoresFence()
+                    -> void
+                    {
+#if defined(ALPAKA_MEM_CPU_NON_TEMPORAL_SSE2)
+                        _mm_sfence();
+#endif
+                    }
+                }
+            }
+        }
+    }
+}
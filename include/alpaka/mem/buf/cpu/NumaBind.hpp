@@ -0,0 +1,101 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <alpaka/core/Common.hpp>           // ALPAKA_FN_HOST
+
+#include <boost/core/ignore_unused.hpp>     // boost::ignore_unused
+#include <boost/predef.h>                   // BOOST_OS_LINUX
+
+#if BOOST_OS_LINUX
+    #include <sys/syscall.h>                // SYS_mbind
+    #include <unistd.h>                     // syscall, sysconf
+#endif
+
+#include <climits>                          // CHAR_BIT
+#include <cstddef>                          // std::size_t
+#include <cstdint>                          // std::uintptr_t
+#include <vector>                           // std::vector
+
+namespace alpaka
+{
+    namespace mem
+    {
+        namespace buf
+        {
+            namespace cpu
+            {
+                namespace detail
+                {
+                    //-----------------------------------------------------------------------------
+                    //! Sets the preferred NUMA node of the pages of the memory that have not been touched yet.
+                    //!
+                    //! Only pages lying completely inside of the memory are bound so neighbouring allocations are not affected.
+                    //! The node is preferred rather than required, so the allocation still succeeds if the node runs out of memory.
+                    //! This is a hint. If it is not supported or fails, nothing happens.
+                    //!
+                    //! \param numaNodeOsId The id the operating system uses for the NUMA node.
+                    //! \return If the memory has been bound.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto bindPagesToNumaNode(
+                        void const * const ptr,
+                        std::size_t const & sizeBytes,
+                        std::size_t const & numaNodeOsId)
+                    -> bool
+                    {
+#if BOOST_OS_LINUX && defined(SYS_mbind)
+                        auto const pageSize(static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE)));
+                        auto const begin((reinterpret_cast<std::uintptr_t>(ptr) + pageSize - 1u) & ~(pageSize - 1u));
+                        auto const end((reinterpret_cast<std::uintptr_t>(ptr) + sizeBytes) & ~(pageSize - 1u));
+                        if(begin >= end)
+                        {
+                            return false;
+                        }
+
+                        // The value of MPOL_PREFERRED from <linux/mempolicy.h> which is not available everywhere.
+                        int const mpolPreferred(1);
+                        std::size_t const bitsPerMask(sizeof(unsigned long) * CHAR_BIT);
+                        std::vector<unsigned long> nodeMask(numaNodeOsId / bitsPerMask + 1u, 0ul);
+                        nodeMask[numaNodeOsId / bitsPerMask] = 1ul << (numaNodeOsId % bitsPerMask);
+                        // The kernel reads one bit less than maxnode.
+                        auto const maxNode(static_cast<unsigned long>(nodeMask.size() * bitsPerMask + 1u));
+
+                        return
+                            syscall(
+                                SYS_mbind,
+                                reinterpret_cast<void *>(begin),
+                                static_cast<unsigned long>(end - begin),
+                                mpolPreferred,
+                                nodeMask.data(),
+                                maxNode,
+                                0u) == 0;
+#else
+                        boost::ignore_unused(ptr, sizeBytes, numaNodeOsId);
+                        return false;
+#endif
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,271 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/core/Common.hpp>           // ALPAKA_FN_HOST
+
+#include <boost/core/ignore_unused.hpp>     // boost::ignore_unused
+#include <boost/predef.h>                   // BOOST_OS_UNIX
+
+#if BOOST_OS_UNIX
+    #include <sys/mman.h>                   // mlock, munlock, mlock2
+    #include <sys/resource.h>               // getrlimit, RLIMIT_MEMLOCK
+    #include <unistd.h>                     // sysconf
+#endif
+
+#include <atomic>                           // std::atomic
+#include <cerrno>                           // errno
+#include <cstddef>                          // std::size_t
+#include <cstdint>                          // std::uintptr_t
+#include <cstring>                          // std::strerror
+#include <map>                              // std::map
+#include <mutex>                            // std::mutex
+#include <stdexcept>                        // std::runtime_error
+#include <string>                           // std::string
+
+namespace alpaka
+{
+    namespace mem
+    {
+        namespace buf
+        {
+            namespace cpu
+            {
+                //#############################################################################
+                //! The way the pages of pinned CPU memory are made resident.
+                //#############################################################################
+                enum class PinMode
+                {
+                    Prefault,   //!< All pages are faulted in and locked when pinning.
+                    OnFault     //!< Pages are locked when they are touched for the first time (MLOCK_ONFAULT). Falls back to Prefault if not supported.
+                };
+
+                namespace detail
+                {
+                    //-----------------------------------------------------------------------------
+                    //! \return The number of bytes currently locked by pinned CPU buffers.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto getLockedBytes()
+                    -> std::atomic<std::size_t> &
+                    {
+                        static std::atomic<std::size_t> lockedBytes(0u);
+                        return lockedBytes;
+                    }
+#if BOOST_OS_UNIX
+                    //#############################################################################
+                    //! The process wide book keeping of the locked pages.
+                    //!
+                    //! mlock does not nest and munlock unlocks whole pages.
+                    //! The memory of different buffers does not overlap but the first and the last page of a buffer can be shared with other buffers.
+                    //! These boundary pages are reference counted so they stay locked until the last buffer using them is unpinned.
+                    //#############################################################################
+                    struct PageLockRegistry
+                    {
+                        std::mutex m_mtx;
+                        std::map<std::uintptr_t, std::size_t> m_boundaryPageRefCounts;  //!< The number of locked ranges starting or ending in a page.
+                    };
+                    //-----------------------------------------------------------------------------
+                    //! \return The process wide page lock registry.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto getPageLockRegistry()
+                    -> PageLockRegistry &
+                    {
+                        static PageLockRegistry registry;
+                        return registry;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The page size.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto getPageSize()
+                    -> std::uintptr_t
+                    {
+                        static std::uintptr_t const pageSize(static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE)));
+                        return pageSize;
+                    }
+                    //#############################################################################
+                    //! The page range covering some memory.
+                    //#############################################################################
+                    struct PageRange
+                    {
+                        //-----------------------------------------------------------------------------
+                        //! Constructor.
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST PageRange(
+                            void const * const ptr,
+                            std::size_t const & sizeBytes) :
+                                m_begin(reinterpret_cast<std::uintptr_t>(ptr) & ~(getPageSize() - 1u)),
+                                m_end((reinterpret_cast<std::uintptr_t>(ptr) + sizeBytes + getPageSize() - 1u) & ~(getPageSize() - 1u)),
+                                m_lastPage(m_end - getPageSize())
+                        {}
+
+                        std::uintptr_t m_begin;     //!< The address of the first page.
+                        std::uintptr_t m_end;       //!< The address behind the last page.
+                        std::uintptr_t m_lastPage;  //!< The address of the last page.
+                    };
+                    //-----------------------------------------------------------------------------
+                    //! \return If the page is locked for another range.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto isBoundaryPageLocked(
+                        PageLockRegistry const & registry,
+                        std::uintptr_t const & page)
+                    -> bool
+                    {
+                        return registry.m_boundaryPageRefCounts.find(page) != registry.m_boundaryPageRefCounts.end();
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Removes a reference to the boundary page.
+                    //! \return If the page is not used by any other locked range.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto releaseBoundaryPage(
+                        PageLockRegistry & registry,
+                        std::uintptr_t const & page)
+                    -> bool
+                    {
+                        auto const it(registry.m_boundaryPageRefCounts.find(page));
+                        if(--it->second == 0u)
+                        {
+                            registry.m_boundaryPageRefCounts.erase(it);
+                            return true;
+                        }
+                        return false;
+                    }
+#endif
+                    //-----------------------------------------------------------------------------
+                    //! Locks the memory into RAM.
+                    //!
+                    //! Throws if the RLIMIT_MEMLOCK soft limit would be exceeded by the memory locked by alpaka or if locking fails.
+                    //! The memory of different calls is required not to overlap except for the pages containing its first and last byte.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto lockPages(
+                        void const * const ptr,
+                        std::size_t const & sizeBytes,
+                        PinMode const & mode)
+                    -> void
+                    {
+                        if(sizeBytes == 0u)
+                        {
+                            return;
+                        }
+#if BOOST_OS_UNIX
+                        PageRange const range(ptr, sizeBytes);
+
+                        auto & registry(getPageLockRegistry());
+                        std::lock_guard<std::mutex> lock(registry.m_mtx);
+
+                        // Boundary pages already locked for other ranges are not counted again.
+                        auto newBytes(static_cast<std::size_t>(range.m_end - range.m_begin));
+                        if(isBoundaryPageLocked(registry, range.m_begin))
+                        {
+                            newBytes -= static_cast<std::size_t>(getPageSize());
+                        }
+                        if((range.m_lastPage != range.m_begin) && isBoundaryPageLocked(registry, range.m_lastPage))
+                        {
+                            newBytes -= static_cast<std::size_t>(getPageSize());
+                        }
+
+                        struct rlimit limit;
+                        if((getrlimit(RLIMIT_MEMLOCK, &limit) == 0)
+                            && (limit.rlim_cur != RLIM_INFINITY)
+                            && (static_cast<rlim_t>(getLockedBytes() + newBytes) > limit.rlim_cur))
+                        {
+                            throw std::runtime_error(
+                                "Pinning " + std::to_string(sizeBytes) + " bytes would exceed RLIMIT_MEMLOCK ("
+                                + std::to_string(limit.rlim_cur) + " bytes)!");
+                        }
+
+                        int ret(-1);
+    #if defined(MLOCK_ONFAULT)
+                        if(mode == PinMode::OnFault)
+                        {
+                            ret = mlock2(ptr, sizeBytes, MLOCK_ONFAULT);
+                        }
+    #else
+                        boost::ignore_unused(mode);
+    #endif
+                        if(ret != 0)
+                        {
+                            // mlock faults in all pages of the range before it returns.
+                            ret = mlock(ptr, sizeBytes);
+                        }
+                        if(ret != 0)
+                        {
+                            auto const error(errno);
+                            throw std::runtime_error(std::string("Pinning the memory with mlock failed: ") + std::strerror(error));
+                        }
+
+                        ++registry.m_boundaryPageRefCounts[range.m_begin];
+                        if(range.m_lastPage != range.m_begin)
+                        {
+                            ++registry.m_boundaryPageRefCounts[range.m_lastPage];
+                        }
+                        getLockedBytes() += newBytes;
+#else
+                        boost::ignore_unused(ptr);
+                        boost::ignore_unused(mode);
+                        throw std::runtime_error("Pinning CPU memory is not supported on this platform!");
+#endif
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Unlocks memory locked by lockPages.
+                    //!
+                    //! Boundary pages still used by other locked ranges stay locked.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto unlockPages(
+                        void const * const ptr,
+                        std::size_t const & sizeBytes)
+                    -> void
+                    {
+                        if(sizeBytes == 0u)
+                        {
+                            return;
+                        }
+#if BOOST_OS_UNIX
+                        PageRange const range(ptr, sizeBytes);
+
+                        auto & registry(getPageLockRegistry());
+                        std::lock_guard<std::mutex> lock(registry.m_mtx);
+
+                        auto begin(range.m_begin);
+                        auto end(range.m_end);
+                        if(!releaseBoundaryPage(registry, range.m_begin))
+                        {
+                            begin += getPageSize();
+                        }
+                        if((range.m_lastPage != range.m_begin) && !releaseBoundaryPage(registry, range.m_lastPage))
+                        {
+                            end -= getPageSize();
+                        }
+
+                        if(begin < end)
+                        {
+                            munlock(reinterpret_cast<void const *>(begin), static_cast<std::size_t>(end - begin));
+                            getLockedBytes() -= static_cast<std::size_t>(end - begin);
+                        }
+#else
+                        boost::ignore_unused(ptr);
+#endif
+                    }
+                }
+            }
+        }
+    }
+}
@@ -23,7 +23,10 @@
 
 #include <alpaka/dim/DimIntegralConst.hpp>  // dim::DimInt<N>
 #include <alpaka/extent/Traits.hpp>         // mem::view::getXXX
+#include <alpaka/mem/buf/Traits.hpp>        // mem::buf::isZeroed
 #include <alpaka/mem/view/Traits.hpp>       // mem::view::Set, ...
+#include <alpaka/mem/buf/cpu/NonTemporal.hpp>   // mem::view::cpu::detail::memsetStreaming
+#include <alpaka/profiler/Profiler.hpp>     // ALPAKA_PROFILER_MEM_SCOPE
 #include <alpaka/stream/StreamCpuAsync.hpp> // stream::StreamCpuAsync
 #include <alpaka/stream/StreamCpuSync.hpp>  // stream::StreamCpuSync
 
@@ -71,7 +74,8 @@ namespace alpaka
                             TExtent const & extent) :
                                 m_buf(buf),
                                 m_byte(byte),
-                                m_extent(extent)
+                                m_extent(extent),
+                                m_bSkip((byte == 0u) && mem::buf::isZeroed(mem::view::getBuf(buf)))
                         {}
                         //-----------------------------------------------------------------------------
                         //!
@@ -81,6 +85,12 @@ namespace alpaka
                         {
                             ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
 
+                            // Setting memory that is known to be zero to zero would only touch all of its pages.
+                            if(m_bSkip)
+                            {
+                                return;
+                            }
+
                             auto const extentWidth(extent::getWidth(m_extent));
                             auto const extentHeight(extent::getHeight(m_extent));
                             auto const extentDepth(extent::getDepth(m_extent));
@@ -97,6 +107,8 @@ namespace alpaka
                             auto const dstPitchBytes(mem::view::getPitchBytes<dim::Dim<TBuf>::value - 1u>(m_buf));
                             assert(extentWidthBytes <= dstPitchBytes);
 
+                            ALPAKA_PROFILER_MEM_SCOPE(Set, extentWidthBytes * extentHeight * extentDepth);
+
                             auto const dstNativePtr(reinterpret_cast<std::uint8_t *>(mem::view::getPtrNative(m_buf)));
                             auto const dstSliceSizeBytes(dstPitchBytes * dstHeight);
 
@@ -136,12 +148,32 @@ namespace alpaka
                                 && (extentHeight == dstHeight)
                                 && (extentHeight == dstBufHeight));
 
+                            // Sets larger than the last level cache bypass the caches.
+                            // This does not evict the working set and saves the read for ownership of each destination line.
+                            auto const streaming(
+                                useStreamingStores(
+                                    static_cast<std::size_t>(extentWidthBytes * extentHeight * extentDepth)));
+                            auto const setBytes(
+                                [streaming, iByte, this](std::uint8_t * const dst, std::size_t const & sizeBytes)
+                                {
+                                    if(streaming)
+                                    {
+                                        memsetStreaming(dst, m_byte, sizeBytes);
+                                    }
+                                    else
+                                    {
+                                        std::memset(
+                                            reinterpret_cast<void *>(dst),
+                                            iByte,
+                                            sizeBytes);
+                                    }
+                                });
+
                             if(copyAllAtOnce)
                             {
-                                std::memset(
-                                    reinterpret_cast<void *>(dstNativePtr),
-                                    iByte,
-                                    dstSliceSizeBytes*extentDepth);
+                                setBytes(
+                                    dstNativePtr,
+                                    static_cast<std::size_t>(dstSliceSizeBytes*extentDepth));
                             }
                             else
                             {
@@ -149,29 +181,33 @@ namespace alpaka
                                 {
                                     if(copySliceAtOnce)
                                     {
-                                        std::memset(
-                                            reinterpret_cast<void *>(dstNativePtr + z*dstSliceSizeBytes),
-                                            iByte,
-                                            dstPitchBytes*extentHeight);
+                                        setBytes(
+                                            dstNativePtr + z*dstSliceSizeBytes,
+                                            static_cast<std::size_t>(dstPitchBytes*extentHeight));
                                     }
                                     else
                                     {
                                         for(auto y(decltype(extentHeight)(0)); y < extentHeight; ++y)
                                         {
-                                            std::memset(
-                                                reinterpret_cast<void *>(dstNativePtr + y*dstPitchBytes + z*dstSliceSizeBytes),
-                                                iByte,
-                                                extentWidthBytes);
+                                            setBytes(
+                                                dstNativePtr + y*dstPitchBytes + z*dstSliceSizeBytes,
+                                                static_cast<std::size_t>(extentWidthBytes));
                                         }
                                     }
                                 }
                             }
+
+                            if(streaming)
+                            {
+                                streamingStoresFence();
+                            }
                         }
 
                         // FIXME: Copy buffer handle, do NOT take reference!
                         TBuf & m_buf;
                         std::uint8_t const m_byte;
                         TExtent const m_extent;
+                        bool const m_bSkip;
                     };
                 }
             }
@@ -0,0 +1,363 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/dev/Traits.hpp>            // dev::Dev
+#include <alpaka/dim/Traits.hpp>            // dim::Dim
+#include <alpaka/extent/Traits.hpp>         // extent::getExtentVec
+#include <alpaka/size/Traits.hpp>           // size::Size
+#include <alpaka/stream/Traits.hpp>         // stream::enqueue
+#include <alpaka/vec/Vec.hpp>               // Vec
+
+#include <alpaka/core/Common.hpp>           // ALPAKA_FN_HOST
+
+#include <cstdint>                          // std::int32_t
+#include <stdexcept>                        // std::runtime_error
+#include <vector>                           // std::vector
+
+namespace alpaka
+{
+    namespace mem
+    {
+        //-----------------------------------------------------------------------------
+        //! The halo specifics.
+        //!
+        //! A buffer with a halo of width h in dimension i holds its ghost cells in the first and the last h elements of dimension i.
+        //! Each neighbour is identified by a direction whose components are -1 (lower side), 0 or +1 (upper side).
+        //! Packing gathers the innermost layer of the buffer interior adjacent to each direction (the cells sent to that neighbour).
+        //! Unpacking scatters into the ghost layer in each direction (the cells received from that neighbour).
+        //! The regions are stored one after the other in the order of the direction list, each region in row major order.
+        //-----------------------------------------------------------------------------
+        namespace halo
+        {
+            //#############################################################################
+            //! The direction of a neighbour.
+            //#############################################################################
+            template<
+                typename TDim>
+            using Direction = Vec<TDim, std::int32_t>;
+
+            //-----------------------------------------------------------------------------
+            //! The traits.
+            //-----------------------------------------------------------------------------
+            namespace traits
+            {
+                //#############################################################################
+                //! The halo pack task trait.
+                //#############################################################################
+                template<
+                    typename TDim,
+                    typename TDevStaging,
+                    typename TDevBuf,
+                    typename TSfinae = void>
+                struct TaskPack;
+
+                //#############################################################################
+                //! The halo unpack task trait.
+                //#############################################################################
+                template<
+                    typename TDim,
+                    typename TDevBuf,
+                    typename TDevStaging,
+                    typename TSfinae = void>
+                struct TaskUnpack;
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The directions of the 2*dim face neighbours.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TDim>
+            ALPAKA_FN_HOST auto getFaceDirections()
+            -> std::vector<Direction<TDim>>
+            {
+                std::vector<Direction<TDim>> directions;
+                for(std::size_t d(0u); d < TDim::value; ++d)
+                {
+                    for(std::int32_t side(-1); side <= 1; side += 2)
+                    {
+                        auto direction(Direction<TDim>::zeros());
+                        direction[d] = side;
+                        directions.push_back(direction);
+                    }
+                }
+                return directions;
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The directions of all 3^dim-1 face, edge and corner neighbours.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TDim>
+            ALPAKA_FN_HOST auto getAllDirections()
+            -> std::vector<Direction<TDim>>
+            {
+                std::vector<Direction<TDim>> directions;
+                auto direction(Direction<TDim>::all(-1));
+                while(true)
+                {
+                    if(direction != Direction<TDim>::zeros())
+                    {
+                        directions.push_back(direction);
+                    }
+
+                    // Increment the direction starting with the last dimension.
+                    std::size_t d(TDim::value);
+                    while(d > 0u)
+                    {
+                        --d;
+                        if(++direction[d] <= 1)
+                        {
+                            break;
+                        }
+                        direction[d] = -1;
+                    }
+                    if(direction == Direction<TDim>::all(-1))
+                    {
+                        return directions;
+                    }
+                }
+            }
+
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! Throws if the halo does not fit into the extent or a direction is invalid.
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TDim,
+                    typename TSize>
+                ALPAKA_FN_HOST auto checkHalo(
+                    Vec<TDim, TSize> const & extent,
+                    Vec<TDim, TSize> const & haloWidth,
+                    std::vector<Direction<TDim>> const & directions)
+                -> void
+                {
+                    for(std::size_t d(0u); d < TDim::value; ++d)
+                    {
+                        if(static_cast<TSize>(2u) * haloWidth[d] > extent[d])
+                        {
+                            throw std::runtime_error("The halo on both sides is required to fit into the extent!");
+                        }
+                    }
+                    for(auto const & direction : directions)
+                    {
+                        bool isCenter(true);
+                        for(std::size_t d(0u); d < TDim::value; ++d)
+                        {
+                            if((direction[d] < -1) || (direction[d] > 1))
+                            {
+                                throw std::runtime_error("The direction components are required to be -1, 0 or 1!");
+                            }
+                            isCenter = isCenter && (direction[d] == 0);
+                        }
+                        if(isCenter)
+                        {
+                            throw std::runtime_error("The direction is required to point to a neighbour!");
+                        }
+                    }
+                }
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \param extent The extent of the buffer including the halo.
+            //! \param haloWidth The width of the halo in each dimension.
+            //! \param directions The neighbour directions.
+            //! \return The number of elements of the regions in the given directions.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TExtent>
+            ALPAKA_FN_HOST auto getPackedSize(
+                TExtent const & extent,
+                Vec<dim::Dim<TExtent>, size::Size<TExtent>> const & haloWidth,
+                std::vector<Direction<dim::Dim<TExtent>>> const & directions)
+            -> size::Size<TExtent>
+            {
+                using Dim = dim::Dim<TExtent>;
+                using Size = size::Size<TExtent>;
+
+                auto const extentVec(extent::getExtentVec(extent));
+                detail::checkHalo(extentVec, haloWidth, directions);
+
+                Size packedSize(0u);
+                for(auto const & direction : directions)
+                {
+                    Size regionSize(1u);
+                    for(std::size_t d(0u); d < Dim::value; ++d)
+                    {
+                        regionSize *= (direction[d] == 0)
+                            ? static_cast<Size>(extentVec[d] - static_cast<Size>(2u) * haloWidth[d])
+                            : haloWidth[d];
+                    }
+                    packedSize += regionSize;
+                }
+                return packedSize;
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Creates a halo pack task.
+            //!
+            //! \param staging The one dimensional staging buffer receiving the packed regions.
+            //! \param buf The buffer including the halo.
+            //! \param haloWidth The width of the halo in each dimension.
+            //! \param directions The neighbour directions whose send regions are packed.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TStaging,
+                typename TBuf>
+            ALPAKA_FN_HOST auto taskPack(
+                TStaging & staging,
+                TBuf const & buf,
+                Vec<dim::Dim<TBuf>, size::Size<TBuf>> const & haloWidth,
+                std::vector<Direction<dim::Dim<TBuf>>> const & directions)
+            -> decltype(
+                traits::TaskPack<
+                    dim::Dim<TBuf>,
+                    dev::Dev<TStaging>,
+                    dev::Dev<TBuf>>
+                ::taskPack(
+                    staging,
+                    buf,
+                    haloWidth,
+                    directions))
+            {
+                static_assert(
+                    dim::Dim<TStaging>::value == 1u,
+                    "The staging buffer is required to be one dimensional!");
+
+                return
+                    traits::TaskPack<
+                        dim::Dim<TBuf>,
+                        dev::Dev<TStaging>,
+                        dev::Dev<TBuf>>
+                    ::taskPack(
+                        staging,
+                        buf,
+                        haloWidth,
+                        directions);
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Packs the send regions of the given directions into the staging buffer asynchronously.
+            //!
+            //! \param stream The stream to enqueue the pack task into.
+            //! \param staging The one dimensional staging buffer receiving the packed regions.
+            //! \param buf The buffer including the halo.
+            //! \param haloWidth The width of the halo in each dimension.
+            //! \param directions The neighbour directions whose send regions are packed.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TStaging,
+                typename TBuf,
+                typename TStream>
+            ALPAKA_FN_HOST auto pack(
+                TStream & stream,
+                TStaging & staging,
+                TBuf const & buf,
+                Vec<dim::Dim<TBuf>, size::Size<TBuf>> const & haloWidth,
+                std::vector<Direction<dim::Dim<TBuf>>> const & directions)
+            -> void
+            {
+                stream::enqueue(
+                    stream,
+                    mem::halo::taskPack(
+                        staging,
+                        buf,
+                        haloWidth,
+                        directions));
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Creates a halo unpack task.
+            //!
+            //! \param buf The buffer including the halo.
+            //! \param staging The one dimensional staging buffer holding the packed regions.
+            //! \param haloWidth The width of the halo in each dimension.
+            //! \param directions The neighbour directions whose ghost regions are unpacked.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TBuf,
+                typename TStaging>
+            ALPAKA_FN_HOST auto taskUnpack(
+                TBuf & buf,
+                TStaging const & staging,
+                Vec<dim::Dim<TBuf>, size::Size<TBuf>> const & haloWidth,
+                std::vector<Direction<dim::Dim<TBuf>>> const & directions)
+            -> decltype(
+                traits::TaskUnpack<
+                    dim::Dim<TBuf>,
+                    dev::Dev<TBuf>,
+                    dev::Dev<TStaging>>
+                ::taskUnpack(
+                    buf,
+                    staging,
+                    haloWidth,
+                    directions))
+            {
+                static_assert(
+                    dim::Dim<TStaging>::value == 1u,
+                    "The staging buffer is required to be one dimensional!");
+
+                return
+                    traits::TaskUnpack<
+                        dim::Dim<TBuf>,
+                        dev::Dev<TBuf>,
+                        dev::Dev<TStaging>>
+                    ::taskUnpack(
+                        buf,
+                        staging,
+                        haloWidth,
+                        directions);
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Unpacks the staging buffer into the ghost regions of the given directions asynchronously.
+            //!
+            //! \param stream The stream to enqueue the unpack task into.
+            //! \param buf The buffer including the halo.
+            //! \param staging The one dimensional staging buffer holding the packed regions.
+            //! \param haloWidth The width of the halo in each dimension.
+            //! \param directions The neighbour directions whose ghost regions are unpacked.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TBuf,
+                typename TStaging,
+                typename TStream>
+            ALPAKA_FN_HOST auto unpack(
+                TStream & stream,
+                TBuf & buf,
+                TStaging const & staging,
+                Vec<dim::Dim<TBuf>, size::Size<TBuf>> const & haloWidth,
+                std::vector<Direction<dim::Dim<TBuf>>> const & directions)
+            -> void
+            {
+                stream::enqueue(
+                    stream,
+                    mem::halo::taskUnpack(
+                        buf,
+                        staging,
+                        haloWidth,
+                        directions));
+            }
+        }
+    }
+}
@@ -0,0 +1,648 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <boost/predef.h>                   // BOOST_OS_UNIX
+
+// pread and pwrite are only available on POSIX systems.
+#if BOOST_OS_UNIX
+
+#include <alpaka/dev/DevCpu.hpp>            // dev::DevCpu
+#include <alpaka/dim/DimIntegralConst.hpp>  // dim::DimInt<N>
+#include <alpaka/extent/Traits.hpp>         // extent::getXXX
+#include <alpaka/mem/view/Traits.hpp>       // mem::view::getPtrNative, ...
+#include <alpaka/stream/Traits.hpp>         // stream::enqueue
+
+#include <alpaka/core/Common.hpp>           // ALPAKA_FN_HOST
+
+#include <boost/align.hpp>                  // boost::alignment::aligned_alloc
+#include <boost/core/ignore_unused.hpp>     // boost::ignore_unused
+
+#include <fcntl.h>                          // open, fcntl, O_DIRECT
+#include <unistd.h>                         // pread, pwrite, close
+
+#include <algorithm>                        // std::min
+#include <cerrno>                           // errno
+#include <cstring>                          // std::memcpy, std::strerror
+#include <memory>                           // std::unique_ptr
+#include <stdexcept>                        // std::runtime_error
+#include <string>                           // std::string
+#include <type_traits>                      // std::is_same
+
+namespace alpaka
+{
+    namespace mem
+    {
+        //-----------------------------------------------------------------------------
+        //! The file input and output specifics.
+        //-----------------------------------------------------------------------------
+        namespace io
+        {
+            //#############################################################################
+            //! The caching mode of file accesses.
+            //#############################################################################
+            enum class IoMode
+            {
+                Buffered,   //!< The operating system page cache is used.
+                Direct,     //!< The page cache is bypassed (O_DIRECT) if the system supports it.
+            };
+
+            namespace cpu
+            {
+                namespace detail
+                {
+                    //-----------------------------------------------------------------------------
+                    //! The maximum number of bytes transferred by a single pread or pwrite call.
+                    //-----------------------------------------------------------------------------
+                    static constexpr std::size_t ioChunkBytes = 8u << 20u;
+                    //-----------------------------------------------------------------------------
+                    //! The alignment of offsets, sizes and memory required for direct file accesses.
+                    //-----------------------------------------------------------------------------
+                    static constexpr std::size_t ioDirectAlignmentBytes = 4096u;
+
+                    //-----------------------------------------------------------------------------
+                    //! Throws a std::runtime_error containing the errno description.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto throwIoErrno(
+                        std::string const & what)
+                    -> void
+                    {
+                        throw std::runtime_error(what + " failed: " + std::strerror(errno));
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return If the file descriptor has been opened for direct accesses.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto isDirect(
+                        int const & fd)
+                    -> bool
+                    {
+#if defined(O_DIRECT)
+                        int const flags(::fcntl(fd, F_GETFL));
+                        return (flags != -1) && ((flags & O_DIRECT) != 0);
+#else
+                        return false;
+#endif
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Opens the file.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto openFile(
+                        std::string const & path,
+                        int flags,
+                        IoMode const & mode)
+                    -> int
+                    {
+#if defined(O_DIRECT)
+                        if(mode == IoMode::Direct)
+                        {
+                            flags |= O_DIRECT;
+                        }
+#else
+                        boost::ignore_unused(mode);
+#endif
+                        int const fd(::open(path.c_str(), flags, 0644));
+                        if(fd == -1)
+                        {
+                            throwIoErrno("open '" + path + "'");
+                        }
+                        return fd;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Reads exactly sizeBytes bytes or up to the end of the file if allowShort is true.
+                    //! \return The number of bytes read.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto preadAll(
+                        int const & fd,
+                        std::uint8_t * pDst,
+                        std::size_t sizeBytes,
+                        std::size_t offsetBytes,
+                        bool const & allowShort = false)
+                    -> std::size_t
+                    {
+                        std::size_t readBytes(0u);
+                        while(sizeBytes > 0u)
+                        {
+                            auto const ret(::pread(fd, pDst, std::min(sizeBytes, ioChunkBytes), static_cast<off_t>(offsetBytes)));
+                            if(ret < 0)
+                            {
+                                if(errno == EINTR)
+                                {
+                                    continue;
+                                }
+                                throwIoErrno("pread");
+                            }
+                            else if(ret == 0)
+                            {
+                                if(allowShort)
+                                {
+                                    break;
+                                }
+                                throw std::runtime_error("pread failed: Unexpected end of file!");
+                            }
+                            auto const retBytes(static_cast<std::size_t>(ret));
+                            pDst += retBytes;
+                            sizeBytes -= retBytes;
+                            offsetBytes += retBytes;
+                            readBytes += retBytes;
+                        }
+                        return readBytes;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Writes exactly sizeBytes bytes.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto pwriteAll(
+                        int const & fd,
+                        std::uint8_t const * pSrc,
+                        std::size_t sizeBytes,
+                        std::size_t offsetBytes)
+                    -> void
+                    {
+                        while(sizeBytes > 0u)
+                        {
+                            auto const ret(::pwrite(fd, pSrc, std::min(sizeBytes, ioChunkBytes), static_cast<off_t>(offsetBytes)));
+                            if(ret < 0)
+                            {
+                                if(errno == EINTR)
+                                {
+                                    continue;
+                                }
+                                throwIoErrno("pwrite");
+                            }
+                            auto const retBytes(static_cast<std::size_t>(ret));
+                            pSrc += retBytes;
+                            sizeBytes -= retBytes;
+                            offsetBytes += retBytes;
+                        }
+                    }
+
+                    //#############################################################################
+                    //! A page aligned buffer for direct file accesses.
+                    //#############################################################################
+                    struct AlignedDeleter
+                    {
+                        auto operator()(std::uint8_t * const p) const
+                        -> void
+                        {
+                            boost::alignment::aligned_free(p);
+                        }
+                    };
+                    using AlignedBuffer = std::unique_ptr<std::uint8_t, AlignedDeleter>;
+                    //-----------------------------------------------------------------------------
+                    //! \return A buffer for direct file accesses of ioChunkBytes.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto allocDirectBuffer()
+                    -> AlignedBuffer
+                    {
+                        AlignedBuffer buffer(reinterpret_cast<std::uint8_t *>(boost::alignment::aligned_alloc(ioDirectAlignmentBytes, ioChunkBytes)));
+                        if(!buffer)
+                        {
+                            throw std::bad_alloc();
+                        }
+                        return buffer;
+                    }
+
+                    //#############################################################################
+                    //! The common part of the CPU file read and write tasks.
+                    //!
+                    //! The file stores the elements of the extent densely packed in row major order.
+                    //#############################################################################
+                    template<
+                        typename TView,
+                        typename TPtr>
+                    class TaskFileIoBase
+                    {
+                    public:
+                        using Size = size::Size<TView>;
+
+                        static_assert(
+                            std::is_same<dev::Dev<TView>, dev::DevCpu>::value,
+                            "File input and output is only supported for views on the CPU device!");
+
+                        //-----------------------------------------------------------------------------
+                        //! Constructor.
+                        //-----------------------------------------------------------------------------
+                        TaskFileIoBase(
+                            TView const & view,
+                            TPtr const pMem,
+                            int const & fd,
+                            std::string const & path,
+                            std::size_t const & offsetBytes,
+                            IoMode const & mode) :
+                                m_fd(fd),
+                                m_path(path),
+                                m_offsetBytes(offsetBytes),
+                                m_mode(mode),
+                                m_extentWidthBytes(static_cast<std::size_t>(extent::getWidth(view)) * sizeof(elem::Elem<TView>)),
+                                m_extentHeight(static_cast<std::size_t>(extent::getHeight(view))),
+                                m_extentDepth(static_cast<std::size_t>(extent::getDepth(view))),
+                                m_pitchBytes(static_cast<std::size_t>(mem::view::getPitchBytes<dim::Dim<TView>::value - 1u>(view))),
+                                m_sliceSizeBytes(static_cast<std::size_t>(m_pitchBytes * extent::getHeight(mem::view::getBuf(view)))),
+                                m_pMem(pMem)
+                        {}
+
+                    protected:
+                        //-----------------------------------------------------------------------------
+                        //! Calls the function object for each contiguous memory region with its file offset.
+                        //-----------------------------------------------------------------------------
+                        template<
+                            typename TFnObj>
+                        ALPAKA_FN_HOST auto forEachRegion(
+                            TFnObj const & f) const
+                        -> void
+                        {
+                            // Without padding the whole extent is one region.
+                            if((m_extentWidthBytes == m_pitchBytes) && (m_sliceSizeBytes == m_pitchBytes * m_extentHeight))
+                            {
+                                f(m_pMem, m_extentWidthBytes * m_extentHeight * m_extentDepth, m_offsetBytes);
+                            }
+                            else
+                            {
+                                for(std::size_t z(0u); z < m_extentDepth; ++z)
+                                {
+                                    for(std::size_t y(0u); y < m_extentHeight; ++y)
+                                    {
+                                        f(
+                                            m_pMem + z*m_sliceSizeBytes + y*m_pitchBytes,
+                                            m_extentWidthBytes,
+                                            m_offsetBytes + (z*m_extentHeight + y)*m_extentWidthBytes);
+                                    }
+                                }
+                            }
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! Calls the function object with the file descriptor to use and closes it afterwards if it has been opened by the task.
+                        //-----------------------------------------------------------------------------
+                        template<
+                            typename TFnObj>
+                        ALPAKA_FN_HOST auto withFile(
+                            int const & flags,
+                            TFnObj const & f) const
+                        -> void
+                        {
+                            if(m_fd != -1)
+                            {
+                                f(m_fd);
+                            }
+                            else
+                            {
+                                int const fd(openFile(m_path, flags, m_mode));
+                                try
+                                {
+                                    f(fd);
+                                }
+                                catch(...)
+                                {
+                                    ::close(fd);
+                                    throw;
+                                }
+                                if(::close(fd) == -1)
+                                {
+                                    throwIoErrno("close '" + m_path + "'");
+                                }
+                            }
+                        }
+
+                        int m_fd;
+                        std::string m_path;
+                        std::size_t m_offsetBytes;
+                        IoMode m_mode;
+
+                        std::size_t m_extentWidthBytes;
+                        std::size_t m_extentHeight;
+                        std::size_t m_extentDepth;
+                        std::size_t m_pitchBytes;
+                        std::size_t m_sliceSizeBytes;
+
+                        TPtr m_pMem;
+                    };
+
+                    //#############################################################################
+                    //! The CPU file read task.
+                    //#############################################################################
+                    template<
+                        typename TView>
+                    class TaskRead final :
+                        public TaskFileIoBase<TView, std::uint8_t *>
+                    {
+                    public:
+                        //-----------------------------------------------------------------------------
+                        //! Constructor.
+                        //-----------------------------------------------------------------------------
+                        TaskRead(
+                            TView & view,
+                            int const & fd,
+                            std::string const & path,
+                            std::size_t const & offsetBytes,
+                            IoMode const & mode) :
+                                TaskFileIoBase<TView, std::uint8_t *>(
+                                    view,
+                                    reinterpret_cast<std::uint8_t *>(mem::view::getPtrNative(view)),
+                                    fd,
+                                    path,
+                                    offsetBytes,
+                                    mode)
+                        {}
+                        //-----------------------------------------------------------------------------
+                        //!
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto operator()() const
+                        -> void
+                        {
+                            ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                            this->withFile(
+                                O_RDONLY,
+                                [this](int const & fd)
+                                {
+                                    if(!isDirect(fd))
+                                    {
+                                        this->forEachRegion(
+                                            [fd](std::uint8_t * const pDst, std::size_t const & sizeBytes, std::size_t const & offsetBytes)
+                                            {
+                                                preadAll(fd, pDst, sizeBytes, offsetBytes);
+                                            });
+                                    }
+                                    else
+                                    {
+                                        // Direct reads have to be aligned so they go through an aligned buffer covering the aligned file range.
+                                        auto const buffer(allocDirectBuffer());
+                                        this->forEachRegion(
+                                            [fd, &buffer](std::uint8_t * pDst, std::size_t sizeBytes, std::size_t offsetBytes)
+                                            {
+                                                while(sizeBytes > 0u)
+                                                {
+                                                    auto const alignedOffsetBytes(offsetBytes - offsetBytes % ioDirectAlignmentBytes);
+                                                    auto const skipBytes(offsetBytes - alignedOffsetBytes);
+                                                    // Only read the aligned blocks covering the remaining bytes of the region.
+                                                    auto const requiredBytes(skipBytes + sizeBytes);
+                                                    auto const alignedRequiredBytes(
+                                                        std::min(
+                                                            ioChunkBytes,
+                                                            (requiredBytes + ioDirectAlignmentBytes - 1u) / ioDirectAlignmentBytes * ioDirectAlignmentBytes));
+                                                    auto const readBytes(preadAll(fd, buffer.get(), alignedRequiredBytes, alignedOffsetBytes, true));
+                                                    if(readBytes <= skipBytes)
+                                                    {
+                                                        throw std::runtime_error("pread failed: Unexpected end of file!");
+                                                    }
+                                                    auto const copyBytes(std::min(sizeBytes, readBytes - skipBytes));
+                                                    std::memcpy(pDst, buffer.get() + skipBytes, copyBytes);
+                                                    pDst += copyBytes;
+                                                    sizeBytes -= copyBytes;
+                                                    offsetBytes += copyBytes;
+                                                }
+                                            });
+                                    }
+                                });
+                        }
+                    };
+
+                    //#############################################################################
+                    //! The CPU file write task.
+                    //#############################################################################
+                    template<
+                        typename TView>
+                    class TaskWrite final :
+                        public TaskFileIoBase<TView, std::uint8_t const *>
+                    {
+                    public:
+                        //-----------------------------------------------------------------------------
+                        //! Constructor.
+                        //-----------------------------------------------------------------------------
+                        TaskWrite(
+                            TView const & view,
+                            int const & fd,
+                            std::string const & path,
+                            std::size_t const & offsetBytes,
+                            IoMode const & mode) :
+                                TaskFileIoBase<TView, std::uint8_t const *>(
+                                    view,
+                                    reinterpret_cast<std::uint8_t const *>(mem::view::getPtrNative(view)),
+                                    fd,
+                                    path,
+                                    offsetBytes,
+                                    mode)
+                        {}
+                        //-----------------------------------------------------------------------------
+                        //!
+                        //-----------------------------------------------------------------------------
+                        ALPAKA_FN_HOST auto operator()() const
+                        -> void
+                        {
+                            ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                            // A file written from its start is replaced. Otherwise the stale end of a longer old file would remain.
+                            this->withFile(
+                                O_WRONLY | O_CREAT | ((this->m_offsetBytes == 0u) ? O_TRUNC : 0),
+                                [this](int const & fd)
+                                {
+                                    if(!isDirect(fd))
+                                    {
+                                        this->forEachRegion(
+                                            [fd](std::uint8_t const * const pSrc, std::size_t const & sizeBytes, std::size_t const & offsetBytes)
+                                            {
+                                                pwriteAll(fd, pSrc, sizeBytes, offsetBytes);
+                                            });
+                                    }
+                                    else
+                                    {
+                                        // Direct writes can not partially overwrite blocks so the regions have to be aligned.
+                                        auto const buffer(allocDirectBuffer());
+                                        this->forEachRegion(
+                                            [fd, &buffer](std::uint8_t const * pSrc, std::size_t sizeBytes, std::size_t offsetBytes)
+                                            {
+                                                if(((offsetBytes % ioDirectAlignmentBytes) != 0u) || ((sizeBytes % ioDirectAlignmentBytes) != 0u))
+                                                {
+                                                    throw std::runtime_error("Direct file writes require offsets and row sizes to be multiples of the block size!");
+                                                }
+                                                while(sizeBytes > 0u)
+                                                {
+                                                    auto const copyBytes(std::min(sizeBytes, ioChunkBytes));
+                                                    std::memcpy(buffer.get(), pSrc, copyBytes);
+                                                    pwriteAll(fd, buffer.get(), copyBytes, offsetBytes);
+                                                    pSrc += copyBytes;
+                                                    sizeBytes -= copyBytes;
+                                                    offsetBytes += copyBytes;
+                                                }
+                                            });
+                                    }
+                                });
+                        }
+                    };
+                }
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Creates a task reading the view from the file descriptor.
+            //!
+            //! \param fd The file descriptor. It has to stay open until the task has been executed.
+            //! \param offsetBytes The byte offset of the densely packed view data within the file.
+            //! \param view The view to read into.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TView>
+            ALPAKA_FN_HOST auto taskRead(
+                int const & fd,
+                std::size_t const & offsetBytes,
+                TView & view)
+            -> cpu::detail::TaskRead<TView>
+            {
+                return
+                    cpu::detail::TaskRead<TView>(
+                        view,
+                        fd,
+                        std::string(),
+                        offsetBytes,
+                        IoMode::Buffered);
+            }
+            //-----------------------------------------------------------------------------
+            //! Creates a task reading the view from the file.
+            //!
+            //! \param path The path of the file. It is opened when the task is executed.
+            //! \param offsetBytes The byte offset of the densely packed view data within the file.
+            //! \param view The view to read into.
+            //! \param mode The caching mode.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TView>
+            ALPAKA_FN_HOST auto taskRead(
+                std::string const & path,
+                std::size_t const & offsetBytes,
+                TView & view,
+                IoMode const & mode = IoMode::Buffered)
+            -> cpu::detail::TaskRead<TView>
+            {
+                return
+                    cpu::detail::TaskRead<TView>(
+                        view,
+                        -1,
+                        path,
+                        offsetBytes,
+                        mode);
+            }
+            //-----------------------------------------------------------------------------
+            //! Reads the view from the file descriptor or file asynchronously.
+            //!
+            //! \param stream The stream to enqueue the read task into.
+            //! Errors of asynchronous streams are rethrown by the next wait for the stream or for an event enqueued after the task.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TStream,
+                typename TFile,
+                typename TView,
+                typename... TArgs>
+            ALPAKA_FN_HOST auto read(
+                TStream & stream,
+                TFile const & file,
+                std::size_t const & offsetBytes,
+                TView & view,
+                TArgs const & ... args)
+            -> void
+            {
+                stream::enqueue(
+                    stream,
+                    mem::io::taskRead(
+                        file,
+                        offsetBytes,
+                        view,
+                        args...));
+            }
+            //-----------------------------------------------------------------------------
+            //! Creates a task writing the view to the file descriptor.
+            //!
+            //! \param view The view to write.
+            //! \param fd The file descriptor. It has to stay open until the task has been executed.
+            //! \param offsetBytes The byte offset of the densely packed view data within the file.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TView>
+            ALPAKA_FN_HOST auto taskWrite(
+                TView const & view,
+                int const & fd,
+                std::size_t const & offsetBytes)
+            -> cpu::detail::TaskWrite<TView>
+            {
+                return
+                    cpu::detail::TaskWrite<TView>(
+                        view,
+                        fd,
+                        std::string(),
+                        offsetBytes,
+                        IoMode::Buffered);
+            }
+            //-----------------------------------------------------------------------------
+            //! Creates a task writing the view to the file.
+            //!
+            //! \param view The view to write.
+            //! \param path The path of the file. It is created if it does not exist and opened when the task is executed.
+            //! It is truncated if the offset is zero. Otherwise the file content outside of the written range is kept.
+            //! \param offsetBytes The byte offset of the densely packed view data within the file.
+            //! \param mode The caching mode.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TView>
+            ALPAKA_FN_HOST auto taskWrite(
+                TView const & view,
+                std::string const & path,
+                std::size_t const & offsetBytes,
+                IoMode const & mode = IoMode::Buffered)
+            -> cpu::detail::TaskWrite<TView>
+            {
+                return
+                    cpu::detail::TaskWrite<TView>(
+                        view,
+                        -1,
+                        path,
+                        offsetBytes,
+                        mode);
+            }
+            //-----------------------------------------------------------------------------
+            //! Writes the view to the file descriptor or file asynchronously.
+            //!
+            //! \param stream The stream to enqueue the write task into.
+            //! Errors of asynchronous streams are rethrown by the next wait for the stream or for an event enqueued after the task.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TStream,
+                typename TView,
+                typename TFile,
+                typename... TArgs>
+            ALPAKA_FN_HOST auto write(
+                TStream & stream,
+                TView const & view,
+                TFile const & file,
+                std::size_t const & offsetBytes,
+                TArgs const & ... args)
+            -> void
+            {
+                stream::enqueue(
+                    stream,
+                    mem::io::taskWrite(
+                        view,
+                        file,
+                        offsetBytes,
+                        args...));
+            }
+        }
+    }
+}
+
+#endif
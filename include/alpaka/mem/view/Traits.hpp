@@ -27,11 +27,14 @@
 #include <alpaka/extent/Traits.hpp>     // extent::GetExtent
 #include <alpaka/offset/Traits.hpp>     // offset::GetOffset
 #include <alpaka/stream/Traits.hpp>     // stream::enqueue
+#include <alpaka/vec/Vec.hpp>           // Vec
 
+#include <alpaka/core/Align.hpp>        // core::align::assumeAligned
 #include <alpaka/core/Fold.hpp>         // core::foldr
 #include <alpaka/core/Common.hpp>       // ALPAKA_FN_HOST
 
 #include <iosfwd>                       // std::ostream
+#include <type_traits>                  // std::is_trivially_copyable
 
 namespace alpaka
 {
@@ -63,6 +66,20 @@ namespace alpaka
                     typename TSfinae = void>
                 struct GetPtrNative;
 
+                //#############################################################################
+                //! The native pointer alignment trait.
+                //!
+                //! The type is an integral constant with the alignment in bytes guaranteed for the native pointer.
+                //! By default only the alignment of the element type is guaranteed.
+                //#############################################################################
+                template<
+                    typename TBuf,
+                    typename TSfinae = void>
+                struct AlignmentType
+                {
+                    using type = std::integral_constant<std::size_t, alignof(elem::Elem<TBuf>)>;
+                };
+
                 //#############################################################################
                 //! The pointer on device get trait.
                 //#############################################################################
@@ -127,6 +144,17 @@ namespace alpaka
                     typename TSfinae = void>
                 struct TaskSet;
 
+                //#############################################################################
+                //! The memory fill trait.
+                //!
+                //! Fills the buffer with copies of an element value.
+                //#############################################################################
+                template<
+                    typename TDim,
+                    typename TDev,
+                    typename TSfinae = void>
+                struct TaskFill;
+
                 //#############################################################################
                 //! The memory copy trait.
                 //!
@@ -139,6 +167,30 @@ namespace alpaka
                     typename TSfinae = void>
                 struct TaskCopy;
 
+                //#############################################################################
+                //! The permuting memory copy trait.
+                //!
+                //! Copies memory from one buffer into another buffer permuting the dimensions.
+                //#############################################################################
+                template<
+                    typename TDim,
+                    typename TDevDst,
+                    typename TDevSrc,
+                    typename TSfinae = void>
+                struct TaskCopyPermuted;
+
+                //#############################################################################
+                //! The converting memory copy trait.
+                //!
+                //! Copies memory from one buffer into another buffer with a different element type.
+                //#############################################################################
+                template<
+                    typename TDim,
+                    typename TDevDst,
+                    typename TDevSrc,
+                    typename TSfinae = void>
+                struct TaskCopyConvert;
+
                 //#############################################################################
                 //! The memory buffer view creation type trait.
                 //#############################################################################
@@ -203,6 +255,46 @@ namespace alpaka
                         buf);
             }
 
+            //#############################################################################
+            //! The native pointer alignment trait alias template to remove the ::type.
+            //#############################################################################
+            template<
+                typename TBuf>
+            using Alignment = typename traits::AlignmentType<TBuf>::type;
+
+            //-----------------------------------------------------------------------------
+            //! Gets the native pointer of the memory buffer annotated with its guaranteed alignment.
+            //!
+            //! Element loops over the returned pointer can be vectorized without alignment peeling.
+            //!
+            //! \param buf The memory buffer.
+            //! \return The native pointer.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TBuf>
+            ALPAKA_FN_HOST auto getPtrNativeAligned(
+                TBuf const & buf)
+            -> elem::Elem<TBuf> const *
+            {
+                return core::align::assumeAligned<Alignment<TBuf>::value>(mem::view::getPtrNative(buf));
+            }
+            //-----------------------------------------------------------------------------
+            //! Gets the native pointer of the memory buffer annotated with its guaranteed alignment.
+            //!
+            //! Element loops over the returned pointer can be vectorized without alignment peeling.
+            //!
+            //! \param buf The memory buffer.
+            //! \return The native pointer.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TBuf>
+            ALPAKA_FN_HOST auto getPtrNativeAligned(
+                TBuf & buf)
+            -> elem::Elem<TBuf> *
+            {
+                return core::align::assumeAligned<Alignment<TBuf>::value>(mem::view::getPtrNative(buf));
+            }
+
             //-----------------------------------------------------------------------------
             //! Gets the pointer to the buffer on the given device.
             //!
@@ -268,6 +360,50 @@ namespace alpaka
                         buf);
             }
 
+            namespace detail
+            {
+                //#############################################################################
+                //! A function object that returns the pitches for each index.
+                //#############################################################################
+                template<
+                    std::size_t Tidx>
+                struct CreatePitchBytes
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    template<
+                        typename TView>
+                    ALPAKA_FN_HOST static auto create(
+                        TView const & view)
+                    -> size::Size<TView>
+                    {
+                        return mem::view::getPitchBytes<Tidx>(view);
+                    }
+                };
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The pitches in bytes of all dimensions.
+            //! The distance between two consecutive elements in dimension i is the pitch at index i+1 (or the element size for the last dimension).
+            //-----------------------------------------------------------------------------
+            template<
+                typename TView>
+            ALPAKA_FN_HOST auto getPitchBytesVec(
+                TView const & view)
+            -> Vec<dim::Dim<TView>, size::Size<TView>>
+            {
+                return
+#ifdef ALPAKA_CREATE_VEC_IN_CLASS
+                Vec<dim::Dim<TView>, size::Size<TView>>::template
+#endif
+                    createVecFromIndexedFn<
+#ifndef ALPAKA_CREATE_VEC_IN_CLASS
+                        dim::Dim<TView>,
+#endif
+                        detail::CreatePitchBytes>(
+                            view);
+            }
+
             //-----------------------------------------------------------------------------
             //! Create a memory set task.
             //!
@@ -332,6 +468,93 @@ namespace alpaka
                         extent));
             }
 
+            namespace detail
+            {
+                //#############################################################################
+                //! If the type can be copied bytewise.
+                //#############################################################################
+                template<
+                    typename T>
+                struct IsTriviallyCopyable :
+#if defined(__GLIBCXX__) && !defined(_GLIBCXX_RELEASE)
+                    // libstdc++ before gcc-7 does not define _GLIBCXX_RELEASE. Before gcc-5 it does not support std::is_trivially_copyable.
+                    // This depends on the standard library instead of the compiler because clang is also used with these versions.
+                    std::integral_constant<bool, __has_trivial_copy(T)>
+#else
+                    std::is_trivially_copyable<T>
+#endif
+                {};
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Create a memory fill task.
+            //!
+            //! In contrast to taskSet this sets each element to the given value and not each byte.
+            //!
+            //! \param buf The memory buffer to fill.
+            //! \param value Value to set for each element of the specified buffer.
+            //! \param extent The extent of the buffer to fill.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TExtent,
+                typename TView>
+            ALPAKA_FN_HOST auto taskFill(
+                TView & buf,
+                elem::Elem<TView> const & value,
+                TExtent const & extent)
+            -> decltype(
+                traits::TaskFill<
+                    dim::Dim<TView>,
+                    dev::Dev<TView>>
+                ::taskFill(
+                    buf,
+                    value,
+                    extent))
+            {
+                static_assert(
+                    dim::Dim<TView>::value == dim::Dim<TExtent>::value,
+                    "The buffer and the extent are required to have the same dimensionality!");
+                static_assert(
+                    detail::IsTriviallyCopyable<elem::Elem<TView>>::value,
+                    "The buffer element type is required to be trivially copyable!");
+
+                return
+                    traits::TaskFill<
+                        dim::Dim<TView>,
+                        dev::Dev<TView>>
+                    ::taskFill(
+                        buf,
+                        value,
+                        extent);
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Fills the memory with the given element value asynchronously.
+            //!
+            //! \param buf The memory buffer to fill.
+            //! \param value Value to set for each element of the specified buffer.
+            //! \param extent The extent of the buffer to fill.
+            //! \param stream The stream to enqueue the buffer fill task into.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TExtent,
+                typename TView,
+                typename TStream>
+            ALPAKA_FN_HOST auto fill(
+                TStream & stream,
+                TView & buf,
+                elem::Elem<TView> const & value,
+                TExtent const & extent)
+            -> void
+            {
+                stream::enqueue(
+                    stream,
+                    mem::view::taskFill(
+                        buf,
+                        value,
+                        extent));
+            }
+
             //-----------------------------------------------------------------------------
             //! Creates a memory copy task.
             //!
@@ -406,6 +629,244 @@ namespace alpaka
                         extent));
             }
 
+            //-----------------------------------------------------------------------------
+            //! Creates a dimension permuting memory copy task.
+            //!
+            //! Dimension i of the destination is dimension permutation[i] of the source.
+            //! For example the permutation (1, 0) transposes a 2D buffer.
+            //!
+            //! \param bufDst The destination memory buffer.
+            //! \param bufSrc The source memory buffer.
+            //! \param extent The extent of the source region to copy.
+            //! \param permutation The source dimension for each destination dimension.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TExtent,
+                typename TBufSrc,
+                typename TBufDst>
+            ALPAKA_FN_HOST auto taskCopyPermuted(
+                TBufDst & bufDst,
+                TBufSrc const & bufSrc,
+                TExtent const & extent,
+                Vec<dim::Dim<TExtent>, size::Size<TExtent>> const & permutation)
+            -> decltype(
+                traits::TaskCopyPermuted<
+                    dim::Dim<TBufDst>,
+                    dev::Dev<TBufDst>,
+                    dev::Dev<TBufSrc>>
+                ::taskCopyPermuted(
+                    bufDst,
+                    bufSrc,
+                    extent,
+                    permutation))
+            {
+                static_assert(
+                    dim::Dim<TBufDst>::value == dim::Dim<TBufSrc>::value,
+                    "The source and the destination buffers are required to have the same dimensionality!");
+                static_assert(
+                    dim::Dim<TBufDst>::value == dim::Dim<TExtent>::value,
+                    "The destination buffer and the extent are required to have the same dimensionality!");
+                static_assert(
+                    std::is_same<elem::Elem<TBufDst>, typename std::remove_const<elem::Elem<TBufSrc>>::type>::value,
+                    "The source and the destination buffers are required to have the same element type!");
+
+                return
+                    traits::TaskCopyPermuted<
+                        dim::Dim<TBufDst>,
+                        dev::Dev<TBufDst>,
+                        dev::Dev<TBufSrc>>
+                    ::taskCopyPermuted(
+                        bufDst,
+                        bufSrc,
+                        extent,
+                        permutation);
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Copies memory permuting the dimensions asynchronously.
+            //!
+            //! \param bufDst The destination memory buffer.
+            //! \param bufSrc The source memory buffer.
+            //! \param extent The extent of the source region to copy.
+            //! \param permutation The source dimension for each destination dimension.
+            //! \param stream The stream to enqueue the buffer copy task into.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TExtent,
+                typename TBufSrc,
+                typename TBufDst,
+                typename TStream>
+            ALPAKA_FN_HOST auto copyPermuted(
+                TStream & stream,
+                TBufDst & bufDst,
+                TBufSrc const & bufSrc,
+                TExtent const & extent,
+                Vec<dim::Dim<TExtent>, size::Size<TExtent>> const & permutation)
+            -> void
+            {
+                stream::enqueue(
+                    stream,
+                    mem::view::taskCopyPermuted(
+                        bufDst,
+                        bufSrc,
+                        extent,
+                        permutation));
+            }
+
+            namespace detail
+            {
+                //#############################################################################
+                //! The element conversion of a converting copy without scaling.
+                //#############################################################################
+                struct ConvertCast
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    template<
+                        typename TElemDst,
+                        typename TElemSrc>
+                    ALPAKA_FN_HOST_ACC auto convert(
+                        TElemSrc const & src) const
+                    -> TElemDst
+                    {
+                        return static_cast<TElemDst>(src);
+                    }
+                };
+                //#############################################################################
+                //! The element conversion of a converting copy multiplying with a scaling factor before the conversion.
+                //#############################################################################
+                template<
+                    typename TScale>
+                struct ConvertScale
+                {
+                    //-----------------------------------------------------------------------------
+                    //!
+                    //-----------------------------------------------------------------------------
+                    template<
+                        typename TElemDst,
+                        typename TElemSrc>
+                    ALPAKA_FN_HOST_ACC auto convert(
+                        TElemSrc const & src) const
+                    -> TElemDst
+                    {
+                        return static_cast<TElemDst>(src * m_scale);
+                    }
+
+                    TScale m_scale;
+                };
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Creates a converting memory copy task.
+            //!
+            //! \param bufDst The destination memory buffer.
+            //! \param bufSrc The source memory buffer.
+            //! \param extent The extent of the buffer to copy.
+            //! \param converter The element conversion function object.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TExtent,
+                typename TBufSrc,
+                typename TBufDst,
+                typename TConverter = detail::ConvertCast>
+            ALPAKA_FN_HOST auto taskCopyConvert(
+                TBufDst & bufDst,
+                TBufSrc const & bufSrc,
+                TExtent const & extent,
+                TConverter const & converter = TConverter())
+            -> decltype(
+                traits::TaskCopyConvert<
+                    dim::Dim<TBufDst>,
+                    dev::Dev<TBufDst>,
+                    dev::Dev<TBufSrc>>
+                ::taskCopyConvert(
+                    bufDst,
+                    bufSrc,
+                    extent,
+                    converter))
+            {
+                static_assert(
+                    dim::Dim<TBufDst>::value == dim::Dim<TBufSrc>::value,
+                    "The source and the destination buffers are required to have the same dimensionality!");
+                static_assert(
+                    dim::Dim<TBufDst>::value == dim::Dim<TExtent>::value,
+                    "The destination buffer and the extent are required to have the same dimensionality!");
+
+                return
+                    traits::TaskCopyConvert<
+                        dim::Dim<TBufDst>,
+                        dev::Dev<TBufDst>,
+                        dev::Dev<TBufSrc>>
+                    ::taskCopyConvert(
+                        bufDst,
+                        bufSrc,
+                        extent,
+                        converter);
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Copies memory converting each element to the destination element type asynchronously.
+            //!
+            //! \param bufDst The destination memory buffer.
+            //! \param bufSrc The source memory buffer.
+            //! \param extent The extent of the buffer to copy.
+            //! \param stream The stream to enqueue the buffer copy task into.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TExtent,
+                typename TBufSrc,
+                typename TBufDst,
+                typename TStream>
+            ALPAKA_FN_HOST auto copyConvert(
+                TStream & stream,
+                TBufDst & bufDst,
+                TBufSrc const & bufSrc,
+                TExtent const & extent)
+            -> void
+            {
+                stream::enqueue(
+                    stream,
+                    mem::view::taskCopyConvert(
+                        bufDst,
+                        bufSrc,
+                        extent));
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Copies memory converting each element multiplied by the scaling factor to the destination element type asynchronously.
+            //!
+            //! For example uint8 to float with scale 1.0f/255.0f normalizes the values.
+            //!
+            //! \param bufDst The destination memory buffer.
+            //! \param bufSrc The source memory buffer.
+            //! \param extent The extent of the buffer to copy.
+            //! \param scale The factor each source element is multiplied with before the conversion.
+            //! \param stream The stream to enqueue the buffer copy task into.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TExtent,
+                typename TBufSrc,
+                typename TBufDst,
+                typename TScale,
+                typename TStream>
+            ALPAKA_FN_HOST auto copyConvert(
+                TStream & stream,
+                TBufDst & bufDst,
+                TBufSrc const & bufSrc,
+                TExtent const & extent,
+                TScale const & scale)
+            -> void
+            {
+                stream::enqueue(
+                    stream,
+                    mem::view::taskCopyConvert(
+                        bufDst,
+                        bufSrc,
+                        extent,
+                        detail::ConvertScale<TScale>{scale}));
+            }
+
             //-----------------------------------------------------------------------------
             //! Constructor.
             //! \param buf This can be either a memory buffer or a memory view.
@@ -0,0 +1,330 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <alpaka/profiler/Profiler.hpp>     // profiler::detail::escapeJson
+#include <alpaka/stream/Traits.hpp>         // stream::enqueue
+#include <alpaka/wait/Traits.hpp>           // wait::wait
+
+#include <alpaka/core/Common.hpp>           // ALPAKA_FN_HOST
+
+#include <algorithm>                        // std::sort
+#include <chrono>                           // std::chrono::steady_clock
+#include <cmath>                            // std::sqrt
+#include <cstdint>                          // std::uint64_t
+#include <limits>                           // std::numeric_limits
+#include <ostream>                          // std::ostream
+#include <string>                           // std::string
+#include <vector>                           // std::vector
+#if ALPAKA_DEBUG >= ALPAKA_DEBUG_MINIMAL
+    #include <iostream>                     // std::cout
+    #include <type_traits>                  // std::decay
+    #include <typeinfo>                     // typeid
+#endif
+
+namespace alpaka
+{
+    namespace profiler
+    {
+        //#############################################################################
+        //! The description of a benchmark.
+        //!
+        //! Each measured repetition is timed from enqueuing the task into an idle stream until the stream is idle again.
+        //! The repetitions stop after m_repetitionCount runs or as soon as the measured runs exceeded m_timeBudget.
+        //! At least one run is always measured.
+        //#############################################################################
+        struct BenchmarkConfig
+        {
+            //-----------------------------------------------------------------------------
+            //! Constructor.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST BenchmarkConfig(
+                std::string const & name = std::string(),
+                std::size_t const & warmUpCount = 1u,
+                std::size_t const & repetitionCount = 10u,
+                std::chrono::nanoseconds const & timeBudget = std::chrono::nanoseconds::zero(),
+                double const & bytes = 0.0,
+                double const & flops = 0.0) :
+                    m_name(name),
+                    m_warmUpCount(warmUpCount),
+                    m_repetitionCount(repetitionCount),
+                    m_timeBudget(timeBudget),
+                    m_bytes(bytes),
+                    m_flops(flops)
+            {}
+
+            std::string m_name;                     //!< The name the results are reported with.
+            std::size_t m_warmUpCount;              //!< The number of unmeasured runs executed first.
+            std::size_t m_repetitionCount;          //!< The maximum number of measured runs.
+            std::chrono::nanoseconds m_timeBudget;  //!< The accumulated measured time after which no further run is started. Zero for no limit.
+            double m_bytes;                         //!< The number of bytes read and written by a single run. Zero if unknown.
+            double m_flops;                         //!< The number of floating point operations of a single run. Zero if unknown.
+        };
+
+        //#############################################################################
+        //! The result of a benchmark.
+        //!
+        //! All durations are in nanoseconds.
+        //! The throughput figures are derived from the median run time because it is insensitive to outliers.
+        //#############################################################################
+        struct BenchmarkResult
+        {
+            //-----------------------------------------------------------------------------
+            //! \return The bytes read and written per second. Zero if the number of bytes is unknown.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getBytesPerSecond() const
+            -> double
+            {
+                return (m_median > 0.0) ? (m_bytes / m_median * 1e9) : 0.0;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The floating point operations per second. Zero if the number of floating point operations is unknown.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getFlopsPerSecond() const
+            -> double
+            {
+                return (m_median > 0.0) ? (m_flops / m_median * 1e9) : 0.0;
+            }
+
+            std::string m_name;                     //!< The name of the benchmark.
+            std::vector<std::uint64_t> m_samples;   //!< The run times of the measured runs in the order of their execution.
+            double m_min;                           //!< The shortest run time.
+            double m_max;                           //!< The longest run time.
+            double m_median;                        //!< The median run time.
+            double m_mean;                          //!< The mean run time.
+            double m_stdDev;                        //!< The sample standard deviation of the run times.
+            double m_p99;                           //!< The 99th percentile run time (nearest rank).
+            double m_bytes;                         //!< The number of bytes read and written by a single run.
+            double m_flops;                         //!< The number of floating point operations of a single run.
+        };
+
+        namespace detail
+        {
+            //-----------------------------------------------------------------------------
+            //! Calculates the statistics of the result from its samples.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto calculateStatistics(
+                BenchmarkResult & result)
+            -> void
+            {
+                auto sorted(result.m_samples);
+                std::sort(sorted.begin(), sorted.end());
+
+                auto const count(sorted.size());
+                if(count == 0u)
+                {
+                    result.m_min = result.m_max = result.m_median = result.m_mean = result.m_stdDev = result.m_p99 = 0.0;
+                    return;
+                }
+
+                result.m_min = static_cast<double>(sorted.front());
+                result.m_max = static_cast<double>(sorted.back());
+                result.m_median = ((count % 2u) == 1u)
+                    ? static_cast<double>(sorted[count / 2u])
+                    : (static_cast<double>(sorted[count / 2u - 1u]) + static_cast<double>(sorted[count / 2u])) * 0.5;
+                // Nearest rank: the smallest sample not exceeded by 99 % of all samples.
+                result.m_p99 = static_cast<double>(sorted[(count * 99u + 99u) / 100u - 1u]);
+
+                double sum(0.0);
+                for(auto const & sample : sorted)
+                {
+                    sum += static_cast<double>(sample);
+                }
+                result.m_mean = sum / static_cast<double>(count);
+
+                double sumSquaredDeviations(0.0);
+                for(auto const & sample : sorted)
+                {
+                    auto const deviation(static_cast<double>(sample) - result.m_mean);
+                    sumSquaredDeviations += deviation * deviation;
+                }
+                result.m_stdDev = (count > 1u) ? std::sqrt(sumSquaredDeviations / static_cast<double>(count - 1u)) : 0.0;
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Benchmarks the given task.
+        //!
+        //! The stream is waited for before the first run so that previously enqueued tasks are not measured.
+        //! Each run is enqueued into the idle stream and waited for, so the run times include the launch overhead.
+        //!
+        //! \return The run times and their statistics.
+        //-----------------------------------------------------------------------------
+        template<
+            typename TStream,
+            typename TTask>
+        ALPAKA_FN_HOST auto benchmark(
+            TStream & stream,
+            TTask && task,
+            BenchmarkConfig const & config = BenchmarkConfig())
+        -> BenchmarkResult
+        {
+#if ALPAKA_DEBUG >= ALPAKA_DEBUG_MINIMAL
+            std::cout
+                << "benchmark("
+                << " name: " << config.m_name
+                << " task: " << typeid(typename std::decay<TTask>::type).name()
+                << " stream: " << typeid(TStream).name()
+                << ")" << std::endl;
+#endif
+            using Clock = std::chrono::steady_clock;
+
+            BenchmarkResult result;
+            result.m_name = config.m_name;
+            result.m_bytes = config.m_bytes;
+            result.m_flops = config.m_flops;
+            result.m_samples.reserve(config.m_repetitionCount);
+
+            // Wait for the stream to finish all tasks enqueued prior to the benchmark.
+            wait::wait(stream);
+
+            // The warm up runs fault in the memory and fill the caches.
+            for(std::size_t w(0u); w < config.m_warmUpCount; ++w)
+            {
+                stream::enqueue(stream, task);
+                wait::wait(stream);
+            }
+
+            std::chrono::nanoseconds elapsed(std::chrono::nanoseconds::zero());
+            do
+            {
+                auto const start(Clock::now());
+                stream::enqueue(stream, task);
+                wait::wait(stream);
+                auto const duration(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start));
+
+                result.m_samples.push_back(static_cast<std::uint64_t>(duration.count()));
+                elapsed += duration;
+            }
+            while((result.m_samples.size() < config.m_repetitionCount)
+                && ((config.m_timeBudget == std::chrono::nanoseconds::zero()) || (elapsed < config.m_timeBudget)));
+
+            detail::calculateStatistics(result);
+
+            return result;
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Writes the result in a human readable form.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto operator<<(
+            std::ostream & os,
+            BenchmarkResult const & result)
+        -> std::ostream &
+        {
+            os << result.m_name
+                << ": {runs: " << result.m_samples.size()
+                << ", min: " << result.m_min * 1e-6
+                << " ms, median: " << result.m_median * 1e-6
+                << " ms, mean: " << result.m_mean * 1e-6
+                << " ms, stdDev: " << result.m_stdDev * 1e-6
+                << " ms, p99: " << result.m_p99 * 1e-6
+                << " ms";
+            if(result.m_bytes > 0.0)
+            {
+                os << ", bandwidth: " << result.getBytesPerSecond() * 1e-9 << " GB/s";
+            }
+            if(result.m_flops > 0.0)
+            {
+                os << ", performance: " << result.getFlopsPerSecond() * 1e-9 << " GFLOP/s";
+            }
+            return (os << "}");
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Writes the result as a JSON object.
+        //! The durations are in nanoseconds, the throughput figures in bytes and floating point operations per second.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto writeJson(
+            std::ostream & os,
+            BenchmarkResult const & result)
+        -> void
+        {
+            // Write the durations and sizes without losing digits to the exponential notation.
+            auto const precision(os.precision(std::numeric_limits<double>::digits10));
+            os << "{\"name\":\"" << detail::escapeJson(result.m_name)
+                << "\",\"runs\":" << result.m_samples.size()
+                << ",\"minNs\":" << result.m_min
+                << ",\"maxNs\":" << result.m_max
+                << ",\"medianNs\":" << result.m_median
+                << ",\"meanNs\":" << result.m_mean
+                << ",\"stdDevNs\":" << result.m_stdDev
+                << ",\"p99Ns\":" << result.m_p99
+                << ",\"bytes\":" << result.m_bytes
+                << ",\"flops\":" << result.m_flops
+                << ",\"bytesPerSecond\":" << result.getBytesPerSecond()
+                << ",\"flopsPerSecond\":" << result.getFlopsPerSecond()
+                << ",\"samplesNs\":[";
+            for(std::size_t i(0u); i < result.m_samples.size(); ++i)
+            {
+                os << ((i == 0u) ? "" : ",") << result.m_samples[i];
+            }
+            os << "]}";
+            os.precision(precision);
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Writes the column names of the rows written by writeCsv.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto writeCsvHeader(
+            std::ostream & os)
+        -> void
+        {
+            os << "name,runs,minNs,maxNs,medianNs,meanNs,stdDevNs,p99Ns,bytes,flops,bytesPerSecond,flopsPerSecond\n";
+        }
+        //-----------------------------------------------------------------------------
+        //! Writes the result as a single CSV row.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto writeCsv(
+            std::ostream & os,
+            BenchmarkResult const & result)
+        -> void
+        {
+            // Quote the name because it may contain the separator.
+            std::string name;
+            for(auto const c : result.m_name)
+            {
+                name += c;
+                if(c == '"')
+                {
+                    name += '"';
+                }
+            }
+            auto const precision(os.precision(std::numeric_limits<double>::digits10));
+            os << '"' << name << '"'
+                << ',' << result.m_samples.size()
+                << ',' << result.m_min
+                << ',' << result.m_max
+                << ',' << result.m_median
+                << ',' << result.m_mean
+                << ',' << result.m_stdDev
+                << ',' << result.m_p99
+                << ',' << result.m_bytes
+                << ',' << result.m_flops
+                << ',' << result.getBytesPerSecond()
+                << ',' << result.getFlopsPerSecond()
+                << '\n';
+            os.precision(precision);
+        }
+    }
+}
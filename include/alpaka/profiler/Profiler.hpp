@@ -0,0 +1,799 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <alpaka/acc/Traits.hpp>            // acc::getAccName
+#include <alpaka/workdiv/Traits.hpp>        // workdiv::getWorkDiv
+#include <alpaka/core/Common.hpp>           // ALPAKA_FN_HOST
+
+#include <boost/core/demangle.hpp>          // boost::core::demangle
+
+#include <algorithm>                        // std::min
+#include <array>                            // std::array
+#include <atomic>                           // std::atomic
+#include <chrono>                           // std::chrono::steady_clock
+#include <cstdio>                           // std::snprintf
+#include <cstdlib>                          // std::getenv
+#include <fstream>                          // std::ofstream
+#include <ios>                              // std::ios
+#include <memory>                           // std::unique_ptr
+#include <mutex>                            // std::mutex
+#include <ostream>                          // std::ostream
+#include <set>                              // std::set
+#include <stdexcept>                        // std::runtime_error
+#include <string>                           // std::string
+#include <typeinfo>                         // typeid
+#include <utility>                          // std::move
+#include <vector>                           // std::vector
+
+namespace alpaka
+{
+    //-----------------------------------------------------------------------------
+    //! The profiler specifics.
+    //!
+    //! If ALPAKA_PROFILING_ENABLED is defined, every kernel launch, memory copy, set and fill executed by a CPU
+    //! stream, the event waits and the queue depths of the asynchronous CPU streams are recorded into a process wide
+    //! buffer that can be exported as a Chrome trace (chrome://tracing, Perfetto).
+    //! Otherwise the instrumentation points compile to nothing.
+    //!
+    //! The CUDA executor and the CUDA memory tasks are not instrumented.
+    //! They only enqueue the work into a CUDA stream, so a host side scope would measure the launch instead of the execution.
+    //! Use the CUDA profiling tools (nvprof, Nsight) for them.
+    //-----------------------------------------------------------------------------
+    namespace profiler
+    {
+        //-----------------------------------------------------------------------------
+        //! The clock all records are timed with.
+        //-----------------------------------------------------------------------------
+        using Clock = std::chrono::steady_clock;
+
+        //#############################################################################
+        //! The kinds of recorded tasks.
+        //#############################################################################
+        enum class RecordKind
+        {
+            Kernel,     //!< A kernel execution.
+            Copy,       //!< A memory copy.
+            Set,        //!< A memory set.
+            Fill,       //!< A memory fill.
+            EventWait,  //!< A thread blocked waiting for an event.
+            QueueDepth, //!< A sample of the number of tasks enqueued into a stream but not completed.
+        };
+
+        //-----------------------------------------------------------------------------
+        //! The stream index of records not belonging to a stream.
+        //-----------------------------------------------------------------------------
+        static constexpr std::size_t noStreamIdx = static_cast<std::size_t>(-1);
+        //-----------------------------------------------------------------------------
+        //! The maximum number of work division dimensions stored in a record. Higher dimensions are omitted.
+        //-----------------------------------------------------------------------------
+        static constexpr std::size_t maxWorkDivDim = 4u;
+
+        //#############################################################################
+        //! The record of a single task execution.
+        //!
+        //! The names are static or interned strings and the work division is stored by value, so creating and storing records does not allocate.
+        //#############################################################################
+        struct Record
+        {
+            RecordKind m_kind;                                  //!< The kind of the task.
+            char const * m_name;                                //!< The mangled kernel function object type name or the name of the other records.
+            char const * m_accName;                             //!< The accelerator name. Empty for memory tasks.
+            std::size_t m_workDivDim;                           //!< The dimensionality of the work division. Zero for memory tasks.
+            std::array<std::size_t, maxWorkDivDim> m_gridBlockExtent;   //!< The grid block extent of kernels.
+            std::array<std::size_t, maxWorkDivDim> m_blockThreadExtent; //!< The block thread extent of kernels.
+            std::array<std::size_t, maxWorkDivDim> m_threadElemExtent;  //!< The thread element extent of kernels.
+            std::size_t m_blockSharedExternMemSizeBytes;        //!< The block shared external memory size of kernels.
+            std::size_t m_sizeBytes;                            //!< The number of bytes written by memory tasks.
+            std::size_t m_value;                                //!< The value of samples.
+            Clock::time_point m_enqueueTime;                    //!< The time the task has been enqueued into the stream.
+            Clock::time_point m_startTime;                      //!< The time the task started executing or the time of samples.
+            Clock::time_point m_endTime;                        //!< The time the task finished executing.
+            std::size_t m_threadIdx;                            //!< The index of the thread that executed the task.
+            std::size_t m_streamIdx;                            //!< The index of the asynchronous stream the task has been enqueued into, the awaited event has been enqueued into or the sample belongs to. noStreamIdx if there is none.
+        };
+
+        namespace detail
+        {
+            //-----------------------------------------------------------------------------
+            //! The environment variable holding the path of the trace file written at program exit.
+            //-----------------------------------------------------------------------------
+            static constexpr char const * traceFileEnvVar = "ALPAKA_PROFILING_TRACE_FILE";
+            //-----------------------------------------------------------------------------
+            //! The number of records buffered by default.
+            //-----------------------------------------------------------------------------
+            static constexpr std::size_t defaultRecordCapacity = 1u << 16u;
+
+            //-----------------------------------------------------------------------------
+            //! \return The given string escaped to be used within a JSON string literal.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto escapeJson(
+                std::string const & str)
+            -> std::string
+            {
+                std::string escaped;
+                escaped.reserve(str.size());
+                for(auto const c : str)
+                {
+                    if((c == '"') || (c == '\\'))
+                    {
+                        escaped += '\\';
+                        escaped += c;
+                    }
+                    else if(static_cast<unsigned char>(c) < 0x20u)
+                    {
+                        char code[8];
+                        std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(c));
+                        escaped += code;
+                    }
+                    else
+                    {
+                        escaped += c;
+                    }
+                }
+                return escaped;
+            }
+            //-----------------------------------------------------------------------------
+            //! Writes the work division of the kernel record in the format of the WorkDivMembers stream operator.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto writeWorkDiv(
+                std::ostream & os,
+                Record const & record)
+            -> void
+            {
+                auto const writeExtent(
+                    [&os, &record](std::array<std::size_t, maxWorkDivDim> const & extent)
+                    {
+                        os << "(";
+                        for(std::size_t i(0u); i < std::min(record.m_workDivDim, maxWorkDivDim); ++i)
+                        {
+                            os << (i > 0u ? ", " : "") << extent[i];
+                        }
+                        os << (record.m_workDivDim > maxWorkDivDim ? ", ...)" : ")");
+                    });
+                os << "{gridBlockExtent: ";
+                writeExtent(record.m_gridBlockExtent);
+                os << ", blockThreadExtent: ";
+                writeExtent(record.m_blockThreadExtent);
+                os << ", threadElemExtent: ";
+                writeExtent(record.m_threadElemExtent);
+                os << "}";
+            }
+
+            //#############################################################################
+            //! The process wide record buffer.
+            //!
+            //! Recording threads claim a slot with a single atomic increment and publish it with a release store.
+            //! Records exceeding the capacity are counted and dropped instead of blocking or allocating.
+            //#############################################################################
+            class Registry final
+            {
+            private:
+                //#############################################################################
+                //! A record slot.
+                //#############################################################################
+                struct Slot
+                {
+                    Slot() :
+                        m_isComplete(false)
+                    {}
+
+                    Record m_record;
+                    std::atomic<bool> m_isComplete;
+                };
+
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST Registry() :
+                    m_capacity(defaultRecordCapacity),
+                    m_slots(new Slot[defaultRecordCapacity]),
+                    m_size(0u),
+                    m_droppedCount(0u)
+                {
+                    auto const * const filePath(std::getenv(traceFileEnvVar));
+                    if(filePath)
+                    {
+                        m_traceFilePath = filePath;
+                    }
+                }
+                //-----------------------------------------------------------------------------
+                //! Copy constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST Registry(Registry const &) = delete;
+                //-----------------------------------------------------------------------------
+                //! Copy assignment operator.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto operator=(Registry const &) -> Registry & = delete;
+                //-----------------------------------------------------------------------------
+                //! Destructor.
+                //! Writes the trace file if ALPAKA_PROFILING_TRACE_FILE is set.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST ~Registry()
+                {
+                    if(!m_traceFilePath.empty())
+                    {
+                        try
+                        {
+                            writeChromeTrace(m_traceFilePath);
+                        }
+                        catch(...)
+                        {
+                        }
+                    }
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Stores the record. This is lock-free and safe to be called concurrently.
+                //! Records are trivially copyable, so storing them neither allocates nor locks.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto commit(
+                    Record const & record)
+                -> void
+                {
+                    auto const slotIdx(m_size.fetch_add(1u, std::memory_order_relaxed));
+                    if(slotIdx >= m_capacity)
+                    {
+                        m_droppedCount.fetch_add(1u, std::memory_order_relaxed);
+                        return;
+                    }
+                    auto & slot(m_slots[slotIdx]);
+                    slot.m_record = record;
+                    slot.m_isComplete.store(true, std::memory_order_release);
+                }
+                //-----------------------------------------------------------------------------
+                //! \return A copy of the string living as long as the registry.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto intern(
+                    std::string const & str)
+                -> char const *
+                {
+                    std::lock_guard<std::mutex> lk(m_mtxInternedStrings);
+                    return m_internedStrings.insert(str).first->c_str();
+                }
+                //-----------------------------------------------------------------------------
+                //! \return All completed records in the order they have been committed.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getRecords() const
+                -> std::vector<Record>
+                {
+                    auto const size(std::min(m_size.load(std::memory_order_relaxed), m_capacity));
+                    std::vector<Record> records;
+                    records.reserve(size);
+                    for(std::size_t slotIdx(0u); slotIdx < size; ++slotIdx)
+                    {
+                        if(m_slots[slotIdx].m_isComplete.load(std::memory_order_acquire))
+                        {
+                            records.push_back(m_slots[slotIdx].m_record);
+                        }
+                    }
+                    return records;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The number of records dropped because the buffer was full.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getDroppedCount() const
+                -> std::size_t
+                {
+                    return m_droppedCount.load(std::memory_order_relaxed);
+                }
+                //-----------------------------------------------------------------------------
+                //! Discards all records and resizes the buffer.
+                //! This must not be called while tasks are executed.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto clear(
+                    std::size_t const & capacity)
+                -> void
+                {
+                    m_slots.reset(new Slot[capacity]);
+                    m_capacity = capacity;
+                    m_size.store(0u);
+                    m_droppedCount.store(0u);
+                }
+                //-----------------------------------------------------------------------------
+                //! Writes all completed records as Chrome trace event JSON.
+                //! The timestamps are microseconds relative to the earliest enqueue time.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto writeChromeTrace(
+                    std::ostream & os) const
+                -> void
+                {
+                    auto const records(getRecords());
+
+                    auto epoch(Clock::time_point::max());
+                    for(auto const & record : records)
+                    {
+                        epoch = std::min(epoch, record.m_enqueueTime);
+                    }
+                    auto const toUs(
+                        [&epoch](Clock::time_point const & time)
+                        {
+                            return std::chrono::duration<double, std::micro>(time - epoch).count();
+                        });
+
+                    // Write the microsecond timestamps with nanosecond resolution. The default precision would round
+                    // them to six significant digits, i.e. to whole or even tens of microseconds after a few seconds.
+                    auto const flags(os.flags());
+                    auto const precision(os.precision(3));
+                    os.setf(std::ios::fixed, std::ios::floatfield);
+
+                    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+                    char const * separator("\n");
+
+                    std::set<std::size_t> threadIdcs;
+                    for(auto const & record : records)
+                    {
+                        if(record.m_kind != RecordKind::QueueDepth)
+                        {
+                            threadIdcs.insert(record.m_threadIdx);
+                        }
+                    }
+                    for(auto const & threadIdx : threadIdcs)
+                    {
+                        os << separator
+                            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadIdx
+                            << ",\"args\":{\"name\":\"alpaka thread " << threadIdx << "\"}}";
+                        separator = ",\n";
+                    }
+
+                    for(auto const & record : records)
+                    {
+                        if(record.m_kind == RecordKind::QueueDepth)
+                        {
+                            os << separator
+                                << "{\"name\":\"" << record.m_name << " stream " << record.m_streamIdx
+                                << "\",\"ph\":\"C\",\"pid\":0,\"ts\":" << toUs(record.m_startTime)
+                                << ",\"args\":{\"depth\":" << record.m_value << "}}";
+                            separator = ",\n";
+                            continue;
+                        }
+
+                        auto const isKernel(record.m_kind == RecordKind::Kernel);
+                        auto const isEventWait(record.m_kind == RecordKind::EventWait);
+                        os << separator
+                            << "{\"name\":\"" << escapeJson(isKernel ? boost::core::demangle(record.m_name) : std::string(record.m_name))
+                            << "\",\"cat\":\"" << (isKernel ? "kernel" : (isEventWait ? "event" : "memory"))
+                            << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << record.m_threadIdx
+                            << ",\"ts\":" << toUs(record.m_startTime)
+                            << ",\"dur\":" << toUs(record.m_endTime) - toUs(record.m_startTime)
+                            << ",\"args\":{\"enqueueTs\":" << toUs(record.m_enqueueTime)
+                            << ",\"queueWaitUs\":" << toUs(record.m_startTime) - toUs(record.m_enqueueTime);
+                        if(record.m_streamIdx != noStreamIdx)
+                        {
+                            os << ",\"streamIdx\":" << record.m_streamIdx;
+                        }
+                        if(isKernel)
+                        {
+                            os << ",\"acc\":\"" << escapeJson(record.m_accName) << "\",\"workDiv\":\"";
+                            writeWorkDiv(os, record);
+                            os << "\",\"blockSharedExternMemSizeBytes\":" << record.m_blockSharedExternMemSizeBytes;
+                        }
+                        else if(!isEventWait)
+                        {
+                            os << ",\"sizeBytes\":" << record.m_sizeBytes;
+                        }
+                        os << "}}";
+                        separator = ",\n";
+                    }
+
+                    os << "\n],\"otherData\":{\"droppedRecords\":" << getDroppedCount() << "}}" << std::endl;
+                    os.precision(precision);
+                    os.flags(flags);
+                }
+                //-----------------------------------------------------------------------------
+                //! Writes all completed records as Chrome trace event JSON into the given file.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto writeChromeTrace(
+                    std::string const & filePath) const
+                -> void
+                {
+                    std::ofstream file(filePath);
+                    if(!file)
+                    {
+                        throw std::runtime_error("Unable to open the trace file '" + filePath + "'!");
+                    }
+                    writeChromeTrace(file);
+                }
+
+            private:
+                std::size_t m_capacity;
+                std::unique_ptr<Slot[]> m_slots;
+                std::atomic<std::size_t> m_size;
+                std::atomic<std::size_t> m_droppedCount;
+                std::string m_traceFilePath;
+                std::mutex m_mtxInternedStrings;
+                std::set<std::string> m_internedStrings;
+            };
+            //-----------------------------------------------------------------------------
+            //! \return The process wide record buffer.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getRegistry()
+            -> Registry &
+            {
+                static Registry registry;
+                return registry;
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return A small sequential index identifying the calling thread in the trace.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getCurrentThreadIdx()
+            -> std::size_t
+            {
+                static std::atomic<std::size_t> nextThreadIdx(0u);
+                static thread_local std::size_t const threadIdx(nextThreadIdx.fetch_add(1u));
+                return threadIdx;
+            }
+
+            //#############################################################################
+            //! The stream related information of the task the calling thread is about to execute.
+            //#############################################################################
+            struct PendingTaskInfo
+            {
+                bool m_isSet;
+                Clock::time_point m_enqueueTime;
+                std::size_t m_streamIdx;
+            };
+            //-----------------------------------------------------------------------------
+            //! \return The stream related information of the task the calling thread is about to execute.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getPendingTaskInfo()
+            -> PendingTaskInfo &
+            {
+                static thread_local PendingTaskInfo pendingTaskInfo{false, Clock::time_point(), noStreamIdx};
+                return pendingTaskInfo;
+            }
+
+            //#############################################################################
+            //! Hands the enqueue time and the stream of a task to the record of the task executed within the scope.
+            //!
+            //! Asynchronous streams execute their tasks within this scope.
+            //! Tasks executed without it, e.g. by synchronous streams, are treated as enqueued at their start.
+            //#############################################################################
+            class ScopedPendingTaskInfo final
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST ScopedPendingTaskInfo(
+                    Clock::time_point const & enqueueTime,
+                    std::size_t const & streamIdx)
+                {
+                    getPendingTaskInfo() = PendingTaskInfo{true, enqueueTime, streamIdx};
+                }
+                //-----------------------------------------------------------------------------
+                //! Copy constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST ScopedPendingTaskInfo(ScopedPendingTaskInfo const &) = delete;
+                //-----------------------------------------------------------------------------
+                //! Copy assignment operator.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto operator=(ScopedPendingTaskInfo const &) -> ScopedPendingTaskInfo & = delete;
+                //-----------------------------------------------------------------------------
+                //! Destructor.
+                //! Tasks without instrumentation do not consume the information.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST ~ScopedPendingTaskInfo()
+                {
+                    getPendingTaskInfo().m_isSet = false;
+                }
+            };
+
+            //#############################################################################
+            //! Records the execution of the enclosing task scope.
+            //#############################################################################
+            class TaskScope final
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST TaskScope(
+                    Record && record) :
+                        m_record(std::move(record))
+                {
+                    m_record.m_startTime = Clock::now();
+                    auto & pendingTaskInfo(getPendingTaskInfo());
+                    if(pendingTaskInfo.m_isSet)
+                    {
+                        m_record.m_enqueueTime = pendingTaskInfo.m_enqueueTime;
+                        if(m_record.m_streamIdx == noStreamIdx)
+                        {
+                            m_record.m_streamIdx = pendingTaskInfo.m_streamIdx;
+                        }
+                        pendingTaskInfo.m_isSet = false;
+                    }
+                    else
+                    {
+                        m_record.m_enqueueTime = m_record.m_startTime;
+                    }
+                }
+                //-----------------------------------------------------------------------------
+                //! Copy constructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST TaskScope(TaskScope const &) = delete;
+                //-----------------------------------------------------------------------------
+                //! Copy assignment operator.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto operator=(TaskScope const &) -> TaskScope & = delete;
+                //-----------------------------------------------------------------------------
+                //! Destructor.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST ~TaskScope()
+                {
+                    m_record.m_endTime = Clock::now();
+                    m_record.m_threadIdx = getCurrentThreadIdx();
+                    getRegistry().commit(m_record);
+                }
+
+            private:
+                Record m_record;
+            };
+
+            //-----------------------------------------------------------------------------
+            //! \return The name of the accelerator. It is created once per accelerator type.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TAcc>
+            ALPAKA_FN_HOST auto getInternedAccName()
+            -> char const *
+            {
+                // The registry owns the name because it is still needed when the registry writes the trace file at exit.
+                static char const * const accName(getRegistry().intern(acc::getAccName<TAcc>()));
+                return accName;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The first maxWorkDivDim elements of the given vector.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TVec>
+            ALPAKA_FN_HOST auto toWorkDivExtent(
+                TVec const & vec)
+            -> std::array<std::size_t, maxWorkDivDim>
+            {
+                std::array<std::size_t, maxWorkDivDim> extent{};
+                for(std::size_t i(0u); i < std::min(static_cast<std::size_t>(dim::Dim<TVec>::value), maxWorkDivDim); ++i)
+                {
+                    extent[i] = static_cast<std::size_t>(vec[i]);
+                }
+                return extent;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The record of a kernel execution.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TKernelFnObj,
+                typename TAcc,
+                typename TWorkDiv>
+            ALPAKA_FN_HOST auto makeKernelRecord(
+                TWorkDiv const & workDiv,
+                std::size_t const & blockSharedExternMemSizeBytes)
+            -> Record
+            {
+                return Record{
+                    RecordKind::Kernel,
+                    typeid(TKernelFnObj).name(),
+                    getInternedAccName<TAcc>(),
+                    static_cast<std::size_t>(dim::Dim<TWorkDiv>::value),
+                    toWorkDivExtent(workdiv::getWorkDiv<origin::Grid, unit::Blocks>(workDiv)),
+                    toWorkDivExtent(workdiv::getWorkDiv<origin::Block, unit::Threads>(workDiv)),
+                    toWorkDivExtent(workdiv::getWorkDiv<origin::Thread, unit::Elems>(workDiv)),
+                    blockSharedExternMemSizeBytes,
+                    0u,
+                    0u,
+                    Clock::time_point(),
+                    Clock::time_point(),
+                    Clock::time_point(),
+                    0u,
+                    noStreamIdx};
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The record of a memory task.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto makeMemRecord(
+                RecordKind const & kind,
+                std::size_t const & sizeBytes)
+            -> Record
+            {
+                return Record{
+                    kind,
+                    (kind == RecordKind::Copy) ? "copy" : ((kind == RecordKind::Set) ? "set" : "fill"),
+                    "",
+                    0u,
+                    {},
+                    {},
+                    {},
+                    0u,
+                    sizeBytes,
+                    0u,
+                    Clock::time_point(),
+                    Clock::time_point(),
+                    Clock::time_point(),
+                    0u,
+                    noStreamIdx};
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The record of a thread blocked waiting for an event enqueued into the given stream.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto makeEventWaitRecord(
+                std::size_t const & streamIdx)
+            -> Record
+            {
+                return Record{
+                    RecordKind::EventWait,
+                    "event wait",
+                    "",
+                    0u,
+                    {},
+                    {},
+                    {},
+                    0u,
+                    0u,
+                    0u,
+                    Clock::time_point(),
+                    Clock::time_point(),
+                    Clock::time_point(),
+                    0u,
+                    streamIdx};
+            }
+            //-----------------------------------------------------------------------------
+            //! Records the queue depth of the given stream at the given time.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto commitQueueDepth(
+                std::size_t const & streamIdx,
+                Clock::time_point const & time,
+                std::size_t const & queueDepth)
+            -> void
+            {
+                getRegistry().commit(
+                    Record{
+                        RecordKind::QueueDepth,
+                        "queue depth",
+                        "",
+                        0u,
+                        {},
+                        {},
+                        {},
+                        0u,
+                        0u,
+                        queueDepth,
+                        time,
+                        time,
+                        time,
+                        getCurrentThreadIdx(),
+                        streamIdx});
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //! \return If the profiler has been compiled in via ALPAKA_PROFILING_ENABLED.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST constexpr auto isEnabled()
+        -> bool
+        {
+#ifdef ALPAKA_PROFILING_ENABLED
+            return true;
+#else
+            return false;
+#endif
+        }
+        //-----------------------------------------------------------------------------
+        //! \return All records completed so far in the order of their completion.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto getRecords()
+        -> std::vector<Record>
+        {
+            return detail::getRegistry().getRecords();
+        }
+        //-----------------------------------------------------------------------------
+        //! \return The number of records dropped because the buffer was full.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto getDroppedRecordCount()
+        -> std::size_t
+        {
+            return detail::getRegistry().getDroppedCount();
+        }
+        //-----------------------------------------------------------------------------
+        //! Discards all records and sets the number of records that can be buffered.
+        //! This must not be called while tasks are executed.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto clear(
+            std::size_t const & capacity = detail::defaultRecordCapacity)
+        -> void
+        {
+            detail::getRegistry().clear(capacity);
+        }
+        //-----------------------------------------------------------------------------
+        //! Writes all records completed so far as Chrome trace event JSON.
+        //! The timestamps are microseconds relative to the earliest enqueue time.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto writeChromeTrace(
+            std::ostream & os)
+        -> void
+        {
+            detail::getRegistry().writeChromeTrace(os);
+        }
+        //-----------------------------------------------------------------------------
+        //! Writes all records completed so far as Chrome trace event JSON into the given file.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto writeChromeTrace(
+            std::string const & filePath)
+        -> void
+        {
+            detail::getRegistry().writeChromeTrace(filePath);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Define the profiler instrumentation points.
+//-----------------------------------------------------------------------------
+#ifdef ALPAKA_PROFILING_ENABLED
+    //-----------------------------------------------------------------------------
+    //! Records the kernel execution of the enclosing scope.
+    //! The variadic argument is the accelerator type.
+    //-----------------------------------------------------------------------------
+    #define ALPAKA_PROFILER_KERNEL_SCOPE(TKernelFnObj, workDiv, blockSharedExternMemSizeBytes, ...)\
+        ::alpaka::profiler::detail::TaskScope const profilerTaskScope(\
+            ::alpaka::profiler::detail::makeKernelRecord<TKernelFnObj, __VA_ARGS__>(\
+                workDiv,\
+                blockSharedExternMemSizeBytes))
+    //-----------------------------------------------------------------------------
+    //! Records the memory task execution of the enclosing scope.
+    //-----------------------------------------------------------------------------
+    #define ALPAKA_PROFILER_MEM_SCOPE(kind, sizeBytes)\
+        ::alpaka::profiler::detail::TaskScope const profilerTaskScope(\
+            ::alpaka::profiler::detail::makeMemRecord(\
+                ::alpaka::profiler::RecordKind::kind,\
+                static_cast<std::size_t>(sizeBytes)))
+    //-----------------------------------------------------------------------------
+    //! Records the event wait of the enclosing scope.
+    //-----------------------------------------------------------------------------
+    #define ALPAKA_PROFILER_EVENT_WAIT_SCOPE(streamIdx)\
+        ::alpaka::profiler::detail::TaskScope const profilerTaskScope(\
+            ::alpaka::profiler::detail::makeEventWaitRecord(\
+                streamIdx))
+    //-----------------------------------------------------------------------------
+    //! Hands the enqueue time and the stream to the task executed within the enclosing scope.
+    //-----------------------------------------------------------------------------
+    #define ALPAKA_PROFILER_PENDING_TASK_SCOPE(enqueueTime, streamIdx)\
+        ::alpaka::profiler::detail::ScopedPendingTaskInfo const profilerPendingTaskInfo(\
+            enqueueTime,\
+            streamIdx)
+    //-----------------------------------------------------------------------------
+    //! Records the queue depth of a stream.
+    //-----------------------------------------------------------------------------
+    #define ALPAKA_PROFILER_QUEUE_DEPTH(streamIdx, time, queueDepth)\
+        ::alpaka::profiler::detail::commitQueueDepth(\
+            streamIdx,\
+            time,\
+            queueDepth)
+#else
+    #define ALPAKA_PROFILER_KERNEL_SCOPE(TKernelFnObj, workDiv, blockSharedExternMemSizeBytes, ...)
+    #define ALPAKA_PROFILER_MEM_SCOPE(kind, sizeBytes)
+    #define ALPAKA_PROFILER_EVENT_WAIT_SCOPE(streamIdx)
+    #define ALPAKA_PROFILER_PENDING_TASK_SCOPE(enqueueTime, streamIdx)
+    #define ALPAKA_PROFILER_QUEUE_DEPTH(streamIdx, time, queueDepth)
+#endif
@@ -26,13 +26,18 @@
 #include <alpaka/dev/Traits.hpp>                // dev::GetDev, dev::DevType
 #include <alpaka/event/Traits.hpp>              // event::EventType
 #include <alpaka/stream/Traits.hpp>             // stream::traits::Enqueue, ...
+#include <alpaka/stream/cpu/Stats.hpp>          // stream::cpu::StreamStats
 #include <alpaka/wait/Traits.hpp>               // CurrentThreadWaitFor, WaiterWaitFor
 
 #include <alpaka/core/ConcurrentExecPool.hpp>   // core::ConcurrentExecPool
+#include <alpaka/profiler/Profiler.hpp>         // ALPAKA_PROFILER_PENDING_TASK_SCOPE
 
 #include <boost/uuid/uuid.hpp>                  // boost::uuids::uuid
 #include <boost/uuid/uuid_generators.hpp>       // boost::uuids::random_generator
+#include <boost/core/ignore_unused.hpp>         // boost::ignore_unused
 
+#include <exception>                            // std::exception_ptr
+#include <memory>                               // std::shared_ptr
 #include <type_traits>                          // std::is_base
 #include <thread>                               // std::thread
 #include <mutex>                                // std::mutex
@@ -53,6 +58,57 @@ namespace alpaka
         {
             namespace detail
             {
+                //#############################################################################
+                //! A task wrapped to update the statistics of the stream executing it.
+                //#############################################################################
+                template<
+                    typename TTask>
+                class StreamTask final
+                {
+                public:
+                    //-----------------------------------------------------------------------------
+                    //! Constructor.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST StreamTask(
+                        StreamStatsCollector & streamStats,
+                        StreamTaskKind const & taskKind,
+                        StreamStatsCollector::Clock::time_point const & enqueueTime,
+                        TTask const & task) :
+                            m_pStreamStats(&streamStats),
+                            m_taskKind(taskKind),
+                            m_enqueueTime(enqueueTime),
+                            m_task(task)
+                    {}
+                    //-----------------------------------------------------------------------------
+                    //! Executes the task.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto operator()()
+                    -> void
+                    {
+                        auto const startTime(m_pStreamStats->onStart(m_enqueueTime));
+                        // Internal tasks are completed before they are executed.
+                        // Otherwise a thread woken by an event would find the event task still running.
+                        if(m_taskKind == StreamTaskKind::Internal)
+                        {
+                            m_pStreamStats->onComplete(m_taskKind, startTime);
+                            m_task();
+                            return;
+                        }
+                        // The wrapped task does not throw because the stream stores the exceptions of its tasks.
+                        {
+                            ALPAKA_PROFILER_PENDING_TASK_SCOPE(m_enqueueTime, m_pStreamStats->getStreamIdx());
+                            m_task();
+                        }
+                        m_pStreamStats->onComplete(m_taskKind, startTime);
+                    }
+
+                private:
+                    StreamStatsCollector * m_pStreamStats;
+                    StreamTaskKind m_taskKind;
+                    StreamStatsCollector::Clock::time_point m_enqueueTime;
+                    TTask m_task;
+                };
+
                 //#############################################################################
                 //! The CPU device stream implementation.
                 //#############################################################################
@@ -79,7 +135,19 @@ namespace alpaka
                         dev::DevCpu & dev) :
                             m_uuid(boost::uuids::random_generator()()),
                             m_dev(dev),
-                            m_workerThread(1u, 128u)
+                            m_threadAffinity(dev.m_spDevCpuImpl->getThreadAffinity()),
+                            m_workerIdx(dev.m_spDevCpuImpl->getNextStreamIdx()),
+                            m_spStats(std::make_shared<StreamStatsCollector>()),
+                            m_workerThread(
+                                1u,
+                                128u,
+                                [this](std::size_t)
+                                {
+                                    // The affinity is only accessed by the worker thread from now on.
+                                    dev::cpu::detail::getCurrentThreadAffinityPtr() = &m_threadAffinity;
+                                    dev::cpu::detail::pinCurrentThread(m_threadAffinity, m_workerIdx);
+                                    getCurrentThreadStreamStatsPtr() = m_spStats.get();
+                                })
                     {}
                     //-----------------------------------------------------------------------------
                     //! Copy constructor.
@@ -104,10 +172,84 @@ namespace alpaka
                     {
                         m_dev.m_spDevCpuImpl->UnregisterAsyncStream(this);
                     }
+
+                    //-----------------------------------------------------------------------------
+                    //! Enqueues the task into the worker thread and tracks it in the statistics if they are enabled.
+                    //!
+                    //! An exception thrown by the task is stored and rethrown by the next wait for an event enqueued after it.
+                    //-----------------------------------------------------------------------------
+                    template<
+                        typename TTask>
+                    ALPAKA_FN_HOST auto enqueueTask(
+                        StreamTaskKind const & taskKind,
+                        TTask const & task)
+                    -> void
+                    {
+                        // The worker thread discards the future holding the exception of the task.
+                        auto * const pStreamImpl(this);
+                        auto const guardedTask(
+                            [pStreamImpl, task]()
+                            {
+                                try
+                                {
+                                    task();
+                                }
+                                catch(...)
+                                {
+                                    pStreamImpl->setException(std::current_exception());
+                                }
+                            });
+#ifdef ALPAKA_STREAM_STATS_COLLECTED
+                        auto const enqueueTime(m_spStats->onEnqueue());
+                        m_workerThread.enqueueTask(
+                            StreamTask<decltype(guardedTask)>(
+                                *m_spStats,
+                                taskKind,
+                                enqueueTime,
+                                guardedTask));
+#else
+                        boost::ignore_unused(taskKind);
+                        m_workerThread.enqueueTask(
+                            guardedTask);
+#endif
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Stores the exception of a task if there is no unreported one.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto setException(
+                        std::exception_ptr const & exception)
+                    -> void
+                    {
+                        std::lock_guard<std::mutex> lk(m_mtxException);
+                        if(!m_exception)
+                        {
+                            m_exception = exception;
+                        }
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The stored exception of a task or nullptr. The stored exception is reset.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto takeException()
+                    -> std::exception_ptr
+                    {
+                        std::lock_guard<std::mutex> lk(m_mtxException);
+                        std::exception_ptr exception;
+                        std::swap(exception, m_exception);
+                        return exception;
+                    }
+
                 public:
                     boost::uuids::uuid const m_uuid;    //!< The unique ID.
                     dev::DevCpu const m_dev;            //!< The device this stream is bound to.
 
+                    dev::cpu::ThreadAffinity m_threadAffinity;  //!< The affinity of the worker thread and the executors it runs.
+                    std::size_t const m_workerIdx;      //!< The index selecting the logical CPU of the worker thread.
+
+                    std::shared_ptr<StreamStatsCollector> m_spStats;    //!< The statistics. Events keep them alive to record waits.
+
+                    std::mutex m_mtxException;
+                    std::exception_ptr m_exception;     //!< The first exception thrown by a task that has not been handed to an event yet.
+
                     ThreadPool m_workerThread;
                 };
             }
@@ -239,7 +381,8 @@ namespace alpaka
                     TTask & task)
                 -> void
                 {
-                    stream.m_spAsyncStreamCpu->m_workerThread.enqueueTask(
+                    stream.m_spAsyncStreamCpu->enqueueTask(
+                        cpu::detail::StreamTaskKind::Task,
                         task);
                 }
                 //-----------------------------------------------------------------------------
@@ -250,7 +393,8 @@ namespace alpaka
                     TTask const & task)
                 -> void
                 {
-                    stream.m_spAsyncStreamCpu->m_workerThread.enqueueTask(
+                    stream.m_spAsyncStreamCpu->enqueueTask(
+                        cpu::detail::StreamTaskKind::Task,
                         task);
                 }
             };
@@ -272,5 +416,53 @@ namespace alpaka
                 }
             };
         }
+
+        namespace cpu
+        {
+            //-----------------------------------------------------------------------------
+            //! Sets the thread affinity of the stream worker thread and of the executors it runs.
+            //! The change is enqueued, so it applies to all tasks enqueued after this call.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto setThreadAffinity(
+                stream::StreamCpuAsync & stream,
+                dev::cpu::ThreadAffinity const & threadAffinity)
+            -> void
+            {
+                auto * const pStreamImpl(stream.m_spAsyncStreamCpu.get());
+                pStreamImpl->enqueueTask(
+                    detail::StreamTaskKind::Internal,
+                    [pStreamImpl, threadAffinity]()
+                    {
+                        pStreamImpl->m_threadAffinity = threadAffinity;
+                        if(threadAffinity.isEnabled())
+                        {
+                            dev::cpu::detail::pinCurrentThread(threadAffinity, pStreamImpl->m_workerIdx);
+                        }
+                        else
+                        {
+                            dev::cpu::detail::unpinCurrentThread();
+                        }
+                    });
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The statistics of the stream since its creation or the last resetStats call.
+            //! They are empty if the statistics are not enabled (see isStatsEnabled).
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getStats(
+                stream::StreamCpuAsync const & stream)
+            -> StreamStats
+            {
+                return stream.m_spAsyncStreamCpu->m_spStats->getStats();
+            }
+            //-----------------------------------------------------------------------------
+            //! Restarts collecting the statistics of the stream.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto resetStats(
+                stream::StreamCpuAsync & stream)
+            -> void
+            {
+                stream.m_spAsyncStreamCpu->m_spStats->reset();
+            }
+        }
     }
 }
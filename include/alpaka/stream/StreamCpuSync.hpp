@@ -60,7 +60,8 @@ namespace alpaka
                     ALPAKA_FN_HOST StreamCpuSyncImpl(
                         dev::DevCpu & dev) :
                             m_uuid(boost::uuids::random_generator()()),
-                            m_dev(dev)
+                            m_dev(dev),
+                            m_threadAffinity(dev.m_spDevCpuImpl->getThreadAffinity())
                     {}
                     //-----------------------------------------------------------------------------
                     //! Copy constructor.
@@ -86,6 +87,7 @@ namespace alpaka
                 public:
                     boost::uuids::uuid const m_uuid;    //!< The unique ID.
                     dev::DevCpu const m_dev;            //!< The device this stream is bound to.
+                    dev::cpu::ThreadAffinity m_threadAffinity;  //!< The affinity of the executors run by this stream.
                 };
             }
         }
@@ -214,7 +216,8 @@ namespace alpaka
                     TTask & task)
                 -> void
                 {
-                    boost::ignore_unused(stream);
+                    // The calling thread itself is not pinned.
+                    dev::cpu::detail::ScopedThreadAffinity const scopedThreadAffinity(stream.m_spSyncStreamCpu->m_threadAffinity);
                     task();
                 }
                 //-----------------------------------------------------------------------------
@@ -225,7 +228,8 @@ namespace alpaka
                     TTask const & task)
                 -> void
                 {
-                    boost::ignore_unused(stream);
+                    // The calling thread itself is not pinned.
+                    dev::cpu::detail::ScopedThreadAffinity const scopedThreadAffinity(stream.m_spSyncStreamCpu->m_threadAffinity);
                     task();
                 }
             };
@@ -248,6 +252,20 @@ namespace alpaka
                 }
             };
         }
+
+        namespace cpu
+        {
+            //-----------------------------------------------------------------------------
+            //! Sets the thread affinity of the executors run by the stream.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto setThreadAffinity(
+                stream::StreamCpuSync & stream,
+                dev::cpu::ThreadAffinity const & threadAffinity)
+            -> void
+            {
+                stream.m_spSyncStreamCpu->m_threadAffinity = threadAffinity;
+            }
+        }
     }
 
     namespace wait
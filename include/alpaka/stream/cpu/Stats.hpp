@@ -0,0 +1,349 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <alpaka/profiler/Profiler.hpp>     // ALPAKA_PROFILER_QUEUE_DEPTH
+
+#include <alpaka/core/Common.hpp>           // ALPAKA_FN_HOST
+#include <alpaka/core/Histogram.hpp>        // core::Histogram, core::AtomicHistogram
+
+#include <algorithm>                        // std::max
+#include <atomic>                           // std::atomic
+#include <chrono>                           // std::chrono::steady_clock
+#include <cstdint>                          // std::uint64_t
+#include <mutex>                            // std::mutex
+#include <ostream>                          // std::ostream
+
+//-----------------------------------------------------------------------------
+// The statistics are collected if they are requested or if the profiler needs them for the stream information of its trace.
+//-----------------------------------------------------------------------------
+#if defined(ALPAKA_STREAM_STATS_ENABLED) || defined(ALPAKA_PROFILING_ENABLED)
+    #define ALPAKA_STREAM_STATS_COLLECTED
+#endif
+
+namespace alpaka
+{
+    namespace stream
+    {
+        namespace cpu
+        {
+            //-----------------------------------------------------------------------------
+            //! \return If the asynchronous CPU streams collect statistics.
+            //!
+            //! This is the case if ALPAKA_STREAM_STATS_ENABLED or ALPAKA_PROFILING_ENABLED is defined.
+            //! Otherwise enqueueing a task does not read the clock or lock a mutex and the statistics stay empty.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST constexpr auto isStatsEnabled()
+            -> bool
+            {
+#ifdef ALPAKA_STREAM_STATS_COLLECTED
+                return true;
+#else
+                return false;
+#endif
+            }
+
+            //#############################################################################
+            //! The statistics of an asynchronous CPU stream.
+            //!
+            //! All durations are in nanoseconds.
+            //! Low utilization with a queue that is mostly empty indicates a host-bound pipeline,
+            //! long task wait times with a deep queue a queue-bound one and a utilization near one a compute-bound one.
+            //#############################################################################
+            struct StreamStats
+            {
+                std::size_t m_streamIdx;                    //!< The process wide index of the stream. It identifies the stream in the profiler trace.
+                std::uint64_t m_duration;                   //!< The time since the stream has been created or the statistics have been reset.
+                std::uint64_t m_enqueuedTaskCount;          //!< The number of enqueued tasks including events and event waits.
+                std::uint64_t m_completedTaskCount;         //!< The number of completed tasks including events and event waits.
+                std::size_t m_queueDepth;                   //!< The number of tasks enqueued but not completed.
+                std::size_t m_maxQueueDepth;                //!< The largest queue depth.
+                double m_meanQueueDepth;                    //!< The time weighted mean queue depth.
+                core::Histogram m_queueDepthAtEnqueue;      //!< The queue depths found by the enqueued tasks.
+                core::Histogram m_taskWaitTime;             //!< The times between enqueueing and starting the tasks.
+                core::Histogram m_taskRunTime;              //!< The run times of the tasks except events and event waits.
+                core::Histogram m_streamEventWaitTime;      //!< The times the stream blocked waiting for events enqueued into other streams.
+                core::Histogram m_hostEventWaitTime;        //!< The times host threads blocked waiting for events enqueued into this stream or for the stream itself.
+
+                //-----------------------------------------------------------------------------
+                //! \return The fraction of the time the stream has been executing tasks.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getUtilization() const
+                -> double
+                {
+                    return (m_duration > 0u) ? static_cast<double>(m_taskRunTime.m_sum) / static_cast<double>(m_duration) : 0.0;
+                }
+            };
+
+            //-----------------------------------------------------------------------------
+            //! Stream out operator.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto operator<<(
+                std::ostream & os,
+                StreamStats const & stats)
+            -> std::ostream &
+            {
+                auto const printTimes(
+                    [&os](char const * const name, core::Histogram const & histogram)
+                    {
+                        os << ", " << name
+                            << ": {count: " << histogram.m_count
+                            << ", mean: " << histogram.getMean() * 1e-3
+                            << " us, p50: <" << static_cast<double>(histogram.getQuantile(0.5)) * 1e-3
+                            << " us, p99: <" << static_cast<double>(histogram.getQuantile(0.99)) * 1e-3
+                            << " us, max: " << static_cast<double>(histogram.m_max) * 1e-3 << " us}";
+                    });
+
+                os << "{streamIdx: " << stats.m_streamIdx
+                    << ", tasks: " << stats.m_completedTaskCount << "/" << stats.m_enqueuedTaskCount
+                    << ", utilization: " << stats.getUtilization()
+                    << ", queueDepth: {current: " << stats.m_queueDepth
+                    << ", max: " << stats.m_maxQueueDepth
+                    << ", mean: " << stats.m_meanQueueDepth << "}";
+                printTimes("taskWaitTime", stats.m_taskWaitTime);
+                printTimes("taskRunTime", stats.m_taskRunTime);
+                printTimes("streamEventWaitTime", stats.m_streamEventWaitTime);
+                printTimes("hostEventWaitTime", stats.m_hostEventWaitTime);
+                return (os << "}");
+            }
+
+            namespace detail
+            {
+                //#############################################################################
+                //! The kinds of tasks executed by an asynchronous CPU stream.
+                //#############################################################################
+                enum class StreamTaskKind
+                {
+                    Task,       //!< A task enqueued by the user, e.g. a kernel or a memory copy.
+                    Internal,   //!< A task of the stream itself, e.g. an event or an affinity change.
+                    EventWait,  //!< A task blocking the stream until an event is completed.
+                };
+
+                //#############################################################################
+                //! Collects the statistics of an asynchronous CPU stream.
+                //!
+                //! The queue depth is tracked under a mutex to integrate it over time, the durations are added lock-free.
+                //#############################################################################
+                class StreamStatsCollector final
+                {
+                public:
+                    using Clock = std::chrono::steady_clock;
+
+                    //-----------------------------------------------------------------------------
+                    //! Constructor.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST StreamStatsCollector() :
+                        m_streamIdx(getNextStreamIdx()),
+                        m_startTime(Clock::now()),
+                        m_lastQueueDepthChangeTime(m_startTime),
+                        m_queueDepth(0u),
+                        m_maxQueueDepth(0u),
+                        m_queueDepthIntegral(0.0),
+                        m_enqueuedTaskCount(0u),
+                        m_completedTaskCount(0u)
+                    {}
+                    //-----------------------------------------------------------------------------
+                    //! Copy constructor.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST StreamStatsCollector(StreamStatsCollector const &) = delete;
+                    //-----------------------------------------------------------------------------
+                    //! Copy assignment operator.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto operator=(StreamStatsCollector const &) -> StreamStatsCollector & = delete;
+
+                    //-----------------------------------------------------------------------------
+                    //! \return The process wide index of the stream.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto getStreamIdx() const
+                    -> std::size_t
+                    {
+                        return m_streamIdx;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Counts a task as enqueued.
+                    //! \return The enqueue time.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto onEnqueue()
+                    -> Clock::time_point
+                    {
+                        std::lock_guard<std::mutex> lk(m_mutex);
+                        auto const time(Clock::now());
+                        m_queueDepthAtEnqueue.add(m_queueDepth);
+                        changeQueueDepth(time, m_queueDepth + 1u);
+                        m_maxQueueDepth = std::max(m_maxQueueDepth, m_queueDepth);
+                        ++m_enqueuedTaskCount;
+                        return time;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Counts a task as started.
+                    //! \return The start time.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto onStart(
+                        Clock::time_point const & enqueueTime)
+                    -> Clock::time_point
+                    {
+                        auto const time(Clock::now());
+                        m_taskWaitTime.add(toNs(time - enqueueTime));
+                        return time;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Counts a task as completed.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto onComplete(
+                        StreamTaskKind const & taskKind,
+                        Clock::time_point const & startTime)
+                    -> void
+                    {
+                        std::lock_guard<std::mutex> lk(m_mutex);
+                        auto const time(Clock::now());
+                        if(taskKind == StreamTaskKind::Task)
+                        {
+                            m_taskRunTime.add(toNs(time - startTime));
+                        }
+                        else if(taskKind == StreamTaskKind::EventWait)
+                        {
+                            m_streamEventWaitTime.add(toNs(time - startTime));
+                        }
+                        changeQueueDepth(time, m_queueDepth - 1u);
+                        ++m_completedTaskCount;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Adds the time a host thread blocked waiting for an event enqueued into the stream.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto addHostEventWait(
+                        Clock::duration const & duration)
+                    -> void
+                    {
+                        m_hostEventWaitTime.add(toNs(duration));
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The current statistics.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto getStats()
+                    -> StreamStats
+                    {
+                        std::lock_guard<std::mutex> lk(m_mutex);
+                        auto const time(Clock::now());
+                        auto const duration(toNs(time - m_startTime));
+                        auto const queueDepthIntegral(
+                            m_queueDepthIntegral
+                            + static_cast<double>(m_queueDepth) * static_cast<double>(toNs(time - m_lastQueueDepthChangeTime)));
+                        return StreamStats{
+                            m_streamIdx,
+                            duration,
+                            m_enqueuedTaskCount,
+                            m_completedTaskCount,
+                            m_queueDepth,
+                            m_maxQueueDepth,
+                            (duration > 0u) ? queueDepthIntegral / static_cast<double>(duration) : 0.0,
+                            m_queueDepthAtEnqueue.get(),
+                            m_taskWaitTime.get(),
+                            m_taskRunTime.get(),
+                            m_streamEventWaitTime.get(),
+                            m_hostEventWaitTime.get()};
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Restarts collecting. The tasks still enqueued are kept in the queue depth.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto reset()
+                    -> void
+                    {
+                        std::lock_guard<std::mutex> lk(m_mutex);
+                        m_startTime = Clock::now();
+                        m_lastQueueDepthChangeTime = m_startTime;
+                        m_maxQueueDepth = m_queueDepth;
+                        m_queueDepthIntegral = 0.0;
+                        m_enqueuedTaskCount = 0u;
+                        m_completedTaskCount = 0u;
+                        m_queueDepthAtEnqueue.reset();
+                        m_taskWaitTime.reset();
+                        m_taskRunTime.reset();
+                        m_streamEventWaitTime.reset();
+                        m_hostEventWaitTime.reset();
+                    }
+
+                private:
+                    //-----------------------------------------------------------------------------
+                    //! \return The next process wide stream index.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto getNextStreamIdx()
+                    -> std::size_t
+                    {
+                        static std::atomic<std::size_t> nextStreamIdx(0u);
+                        return nextStreamIdx.fetch_add(1u);
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The duration in nanoseconds.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto toNs(
+                        Clock::duration const & duration)
+                    -> std::uint64_t
+                    {
+                        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Sets the queue depth. The mutex has to be locked.
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto changeQueueDepth(
+                        Clock::time_point const & time,
+                        std::size_t const & queueDepth)
+                    -> void
+                    {
+                        m_queueDepthIntegral += static_cast<double>(m_queueDepth) * static_cast<double>(toNs(time - m_lastQueueDepthChangeTime));
+                        m_lastQueueDepthChangeTime = time;
+                        m_queueDepth = queueDepth;
+                        ALPAKA_PROFILER_QUEUE_DEPTH(m_streamIdx, time, queueDepth);
+                    }
+
+                private:
+                    std::size_t const m_streamIdx;
+
+                    std::mutex m_mutex;
+                    Clock::time_point m_startTime;
+                    Clock::time_point m_lastQueueDepthChangeTime;
+                    std::size_t m_queueDepth;
+                    std::size_t m_maxQueueDepth;
+                    double m_queueDepthIntegral;
+                    std::uint64_t m_enqueuedTaskCount;
+                    std::uint64_t m_completedTaskCount;
+
+                    core::AtomicHistogram m_queueDepthAtEnqueue;
+                    core::AtomicHistogram m_taskWaitTime;
+                    core::AtomicHistogram m_taskRunTime;
+                    core::AtomicHistogram m_streamEventWaitTime;
+                    core::AtomicHistogram m_hostEventWaitTime;
+                };
+
+                //-----------------------------------------------------------------------------
+                //! \return The statistics of the asynchronous stream the current thread is the worker of or nullptr.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getCurrentThreadStreamStatsPtr()
+                -> StreamStatsCollector * &
+                {
+                    static thread_local StreamStatsCollector * pStreamStats(nullptr);
+                    return pStreamStats;
+                }
+            }
+        }
+    }
+}
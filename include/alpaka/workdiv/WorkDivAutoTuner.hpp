@@ -0,0 +1,790 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/workdiv/WorkDivHelpers.hpp>    // workdiv::getValidWorkDiv, workdiv::isValidWorkDiv
+#include <alpaka/workdiv/WorkDivMembers.hpp>    // workdiv::WorkDivMembers
+
+#include <alpaka/acc/Traits.hpp>                // acc::getAccName, acc::getAccDevProps
+#include <alpaka/dev/Traits.hpp>                // dev::getDev
+#include <alpaka/exec/Traits.hpp>               // exec::create
+#include <alpaka/stream/Traits.hpp>             // stream::enqueue
+#include <alpaka/wait/Traits.hpp>               // wait::wait
+
+#include <alpaka/vec/Vec.hpp>                   // Vec
+#include <alpaka/core/Common.hpp>               // ALPAKA_FN_HOST
+
+#include <algorithm>                            // std::min, std::sort, std::unique
+#include <chrono>                               // std::chrono::steady_clock
+#include <cstdio>                               // std::rename, std::remove
+#include <cstdlib>                              // std::getenv
+#include <fstream>                              // std::ifstream, std::ofstream
+#include <limits>                               // std::numeric_limits
+#include <map>                                  // std::map
+#include <mutex>                                // std::mutex
+#include <sstream>                              // std::ostringstream
+#include <stdexcept>                            // std::runtime_error
+#include <string>                               // std::string
+#include <typeinfo>                             // typeid
+#include <vector>                               // std::vector
+
+namespace alpaka
+{
+    namespace workdiv
+    {
+        namespace detail
+        {
+            //-----------------------------------------------------------------------------
+            //! The maximum number of work divisions measured for one kernel.
+            //-----------------------------------------------------------------------------
+            static constexpr std::size_t autoTuneCandidateCountMax = 32u;
+            //-----------------------------------------------------------------------------
+            //! The number of measured executions per work division. The fastest one counts.
+            //-----------------------------------------------------------------------------
+            static constexpr std::size_t autoTuneRepetitions = 3u;
+            //-----------------------------------------------------------------------------
+            //! The environment variable holding the default path of the persistent cache file.
+            //-----------------------------------------------------------------------------
+            static constexpr char const * autoTuneCacheFileEnvVar = "ALPAKA_WORKDIV_CACHE_FILE";
+
+            //#############################################################################
+            //! A tuned work division as stored in the cache.
+            //#############################################################################
+            struct AutoTuneEntry
+            {
+                std::string m_gridBlockExtent;
+                std::string m_blockThreadExtent;
+                std::string m_threadElemExtent;
+                double m_seconds;
+            };
+
+            //-----------------------------------------------------------------------------
+            //! \return The given extent formatted as "x0xx1x...".
+            //-----------------------------------------------------------------------------
+            template<
+                typename TDim,
+                typename TSize>
+            ALPAKA_FN_HOST auto formatExtent(
+                Vec<TDim, TSize> const & extent)
+            -> std::string
+            {
+                std::ostringstream oss;
+                for(typename TDim::value_type i(0u); i<TDim::value; ++i)
+                {
+                    if(i != 0u)
+                    {
+                        oss << 'x';
+                    }
+                    oss << extent[i];
+                }
+                return oss.str();
+            }
+            //-----------------------------------------------------------------------------
+            //! Parses an extent written by formatExtent.
+            //!
+            //! \return If the string holds an extent of the given dimensionality.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TDim,
+                typename TSize>
+            ALPAKA_FN_HOST auto parseExtent(
+                std::string const & str,
+                Vec<TDim, TSize> & extent)
+            -> bool
+            {
+                std::size_t pos(0u);
+                for(typename TDim::value_type i(0u); i<TDim::value; ++i)
+                {
+                    auto const end(std::min(str.find('x', pos), str.size()));
+                    if((end == pos) || (str.find_first_not_of("0123456789", pos) < end))
+                    {
+                        return false;
+                    }
+                    extent[i] = static_cast<TSize>(std::stoull(str.substr(pos, end - pos)));
+                    pos = end + 1u;
+                }
+                return pos == str.size() + 1u;
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The given field quoted for a CSV file if required.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto quoteCsvField(
+                std::string const & field)
+            -> std::string
+            {
+                if(field.find_first_of(",\"\n") == std::string::npos)
+                {
+                    return field;
+                }
+                std::string quoted("\"");
+                for(auto const c : field)
+                {
+                    if(c == '"')
+                    {
+                        quoted += '"';
+                    }
+                    quoted += c;
+                }
+                return quoted + '"';
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The fields of a CSV line.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto splitCsvLine(
+                std::string const & line)
+            -> std::vector<std::string>
+            {
+                std::vector<std::string> fields(1u);
+                bool bQuoted(false);
+                for(std::size_t i(0u); i < line.size(); ++i)
+                {
+                    auto const c(line[i]);
+                    if(bQuoted)
+                    {
+                        if(c != '"')
+                        {
+                            fields.back() += c;
+                        }
+                        else if((i + 1u < line.size()) && (line[i + 1u] == '"'))
+                        {
+                            fields.back() += c;
+                            ++i;
+                        }
+                        else
+                        {
+                            bQuoted = false;
+                        }
+                    }
+                    else if(c == '"')
+                    {
+                        bQuoted = true;
+                    }
+                    else if(c == ',')
+                    {
+                        fields.emplace_back();
+                    }
+                    else if(c != '\r')
+                    {
+                        fields.back() += c;
+                    }
+                }
+                return fields;
+            }
+
+            //#############################################################################
+            //! The cache of tuned work divisions.
+            //!
+            //! The keys are the CSV encoded kernel, accelerator, dimensionality, grid element extent,
+            //! thread element extent and subdivision restrictions.
+            //! If a file path is set, the file is read on first use and rewritten after each newly tuned entry.
+            //#############################################################################
+            class AutoTuneCache
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                //! Constructor.
+                //-----------------------------------------------------------------------------
+                AutoTuneCache() :
+                    m_bLoaded(false)
+                {
+                    auto const * const filePath(std::getenv(autoTuneCacheFileEnvVar));
+                    if(filePath)
+                    {
+                        m_filePath = filePath;
+                    }
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Sets the path of the persistent cache file. An empty path disables persistence.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto setFilePath(
+                    std::string const & filePath)
+                -> void
+                {
+                    std::lock_guard<std::mutex> lk(m_mtx);
+                    m_filePath = filePath;
+                    m_bLoaded = false;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The path of the persistent cache file.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto getFilePath()
+                -> std::string
+                {
+                    std::lock_guard<std::mutex> lk(m_mtx);
+                    return m_filePath;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return If an entry for the given key exists.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto find(
+                    std::string const & key,
+                    AutoTuneEntry & entry)
+                -> bool
+                {
+                    std::lock_guard<std::mutex> lk(m_mtx);
+                    load();
+                    auto const it(m_entries.find(key));
+                    if(it == m_entries.end())
+                    {
+                        return false;
+                    }
+                    entry = it->second;
+                    return true;
+                }
+                //-----------------------------------------------------------------------------
+                //! Stores the entry and writes the cache file.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto insert(
+                    std::string const & key,
+                    AutoTuneEntry const & entry)
+                -> void
+                {
+                    std::lock_guard<std::mutex> lk(m_mtx);
+                    load();
+                    m_entries[key] = entry;
+                    store();
+                }
+                //-----------------------------------------------------------------------------
+                //! Removes all entries from memory. The cache file is not modified.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto clear()
+                -> void
+                {
+                    std::lock_guard<std::mutex> lk(m_mtx);
+                    m_entries.clear();
+                    // Entries are not read again from the file.
+                    m_bLoaded = true;
+                }
+
+            private:
+                static constexpr std::size_t keyFieldCount = 6u;
+
+                //-----------------------------------------------------------------------------
+                //! Reads the cache file if this has not been done yet.
+                //! Entries already in memory take precedence over the ones in the file.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto load()
+                -> void
+                {
+                    if(m_bLoaded)
+                    {
+                        return;
+                    }
+                    m_bLoaded = true;
+
+                    if(m_filePath.empty())
+                    {
+                        return;
+                    }
+                    std::ifstream ifs(m_filePath);
+                    std::string line;
+                    // The first line is the header.
+                    std::getline(ifs, line);
+                    while(std::getline(ifs, line))
+                    {
+                        auto const fields(splitCsvLine(line));
+                        // Malformed lines are skipped.
+                        if(fields.size() != keyFieldCount + 4u)
+                        {
+                            continue;
+                        }
+                        std::string key;
+                        for(std::size_t i(0u); i < keyFieldCount; ++i)
+                        {
+                            key += (i == 0u ? "" : ",") + quoteCsvField(fields[i]);
+                        }
+                        AutoTuneEntry entry;
+                        entry.m_gridBlockExtent = fields[keyFieldCount];
+                        entry.m_blockThreadExtent = fields[keyFieldCount + 1u];
+                        entry.m_threadElemExtent = fields[keyFieldCount + 2u];
+                        entry.m_seconds = std::strtod(fields[keyFieldCount + 3u].c_str(), nullptr);
+                        m_entries.insert(std::make_pair(key, entry));
+                    }
+                }
+                //-----------------------------------------------------------------------------
+                //! Writes all entries to the cache file.
+                //! The file is written under a temporary name and then renamed so readers never see a partial file.
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto store() const
+                -> void
+                {
+                    if(m_filePath.empty())
+                    {
+                        return;
+                    }
+                    auto const tmpFilePath(m_filePath + ".tmp");
+                    {
+                        std::ofstream ofs(tmpFilePath, std::ios::trunc);
+                        ofs << "kernel,acc,dim,gridElemExtent,threadElemExtent,restrictions,gridBlockExtent,blockThreadExtent,threadElemExtentTuned,seconds\n";
+                        ofs.precision(std::numeric_limits<double>::max_digits10);
+                        for(auto const & keyEntry : m_entries)
+                        {
+                            ofs << keyEntry.first
+                                << ',' << keyEntry.second.m_gridBlockExtent
+                                << ',' << keyEntry.second.m_blockThreadExtent
+                                << ',' << keyEntry.second.m_threadElemExtent
+                                << ',' << keyEntry.second.m_seconds
+                                << '\n';
+                        }
+                        if(!ofs)
+                        {
+                            std::remove(tmpFilePath.c_str());
+                            throw std::runtime_error("Writing the work division cache file '" + tmpFilePath + "' failed!");
+                        }
+                    }
+                    if(std::rename(tmpFilePath.c_str(), m_filePath.c_str()) != 0)
+                    {
+                        std::remove(tmpFilePath.c_str());
+                        throw std::runtime_error("Replacing the work division cache file '" + m_filePath + "' failed!");
+                    }
+                }
+
+                std::mutex m_mtx;
+                std::string m_filePath;
+                bool m_bLoaded;
+                std::map<std::string, AutoTuneEntry> m_entries;
+            };
+
+            //-----------------------------------------------------------------------------
+            //! \return The process wide work division cache.
+            //-----------------------------------------------------------------------------
+            ALPAKA_FN_HOST auto getAutoTuneCache()
+            -> AutoTuneCache &
+            {
+                static AutoTuneCache cache;
+                return cache;
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The cache key for the given kernel, accelerator, extents and restrictions.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TAcc,
+                typename TKernelFnObj,
+                typename TDim,
+                typename TSize>
+            ALPAKA_FN_HOST auto getAutoTuneKey(
+                Vec<TDim, TSize> const & gridElemExtent,
+                Vec<TDim, TSize> const & threadElemExtent,
+                bool requireBlockThreadExtentToDivideGridThreadExtent,
+                GridBlockExtentSubDivRestrictions gridBlockExtentSubDivRestrictions)
+            -> std::string
+            {
+                std::string restrictions(
+                    gridBlockExtentSubDivRestrictions == GridBlockExtentSubDivRestrictions::EqualExtent
+                    ? "EqualExtent"
+                    : gridBlockExtentSubDivRestrictions == GridBlockExtentSubDivRestrictions::CloseToEqualExtent
+                        ? "CloseToEqualExtent"
+                        : "Unrestricted");
+                if(requireBlockThreadExtentToDivideGridThreadExtent)
+                {
+                    restrictions += "|Divide";
+                }
+
+                return
+                    quoteCsvField(typeid(TKernelFnObj).name())
+                    + ',' + quoteCsvField(acc::getAccName<TAcc>())
+                    + ',' + std::to_string(TDim::value)
+                    + ',' + formatExtent(gridElemExtent)
+                    + ',' + formatExtent(threadElemExtent)
+                    + ',' + restrictions;
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The candidate block thread extents of one dimension.
+            //!
+            //! These are the divisors of the grid thread extent or, if not required to divide it,
+            //! the powers of two and the bound itself.
+            //-----------------------------------------------------------------------------
+            template<
+                typename TSize>
+            ALPAKA_FN_HOST auto getBlockThreadExtentCandidates(
+                TSize const & gridThreadExtent,
+                TSize const & blockThreadExtentMax,
+                bool requireBlockThreadExtentToDivideGridThreadExtent)
+            -> std::vector<TSize>
+            {
+                auto const bound(std::min(gridThreadExtent, blockThreadExtentMax));
+                std::vector<TSize> candidates;
+                if(requireBlockThreadExtentToDivideGridThreadExtent)
+                {
+                    for(TSize i(1u); i <= bound; ++i)
+                    {
+                        if(gridThreadExtent % i == 0u)
+                        {
+                            candidates.push_back(i);
+                        }
+                    }
+                }
+                else
+                {
+                    for(TSize i(1u); i < bound; i *= 2u)
+                    {
+                        candidates.push_back(i);
+                    }
+                    candidates.push_back(bound);
+                }
+                return candidates;
+            }
+        }
+
+        //-----------------------------------------------------------------------------
+        //! \tparam TAcc The accelerator for which the work divisions have to be valid.
+        //! \param dev
+        //!     The device the work divisions should be valid for.
+        //! \param gridElemExtent
+        //!     The full extent of elements in the grid.
+        //! \param threadElemExtents
+        //!     the number of elements computed per thread.
+        //! \param requireBlockThreadExtentToDivideGridThreadExtent
+        //!     If this is true, the grid thread extent will be multiples of the corresponding block thread extent.
+        //! \param gridBlockExtentSubDivRestrictions
+        //!     The grid block extent subdivision restrictions.
+        //!     For CloseToEqualExtent the extents of the used dimensions differ by at most a factor of two.
+        //! \return
+        //!     Valid work divisions to be measured. The first one is the one returned by getValidWorkDiv if that is valid.
+        //!     At most detail::autoTuneCandidateCountMax work divisions are returned.
+        //-----------------------------------------------------------------------------
+        template<
+            typename TAcc,
+            typename TGridElemExtent,
+            typename TThreadElemExtent,
+            typename TDev>
+        ALPAKA_FN_HOST auto getWorkDivCandidates(
+            TDev const & dev,
+            TGridElemExtent const & gridElemExtent,
+            TThreadElemExtent const & threadElemExtents,
+            bool requireBlockThreadExtentToDivideGridThreadExtent = true,
+            GridBlockExtentSubDivRestrictions gridBlockExtentSubDivRestrictions = GridBlockExtentSubDivRestrictions::Unrestricted)
+        -> std::vector<workdiv::WorkDivMembers<dim::Dim<TGridElemExtent>, size::Size<TGridElemExtent>>>
+        {
+            using Dim = dim::Dim<TGridElemExtent>;
+            using Size = size::Size<TGridElemExtent>;
+            using WorkDiv = workdiv::WorkDivMembers<Dim, Size>;
+
+            auto const accDevProps(acc::getAccDevProps<TAcc>(dev));
+
+            // The heuristic work division is always measured if it is valid.
+            std::vector<WorkDiv> candidates;
+            WorkDiv const heuristicWorkDiv(
+                getValidWorkDiv<TAcc>(
+                    dev,
+                    gridElemExtent,
+                    threadElemExtents,
+                    requireBlockThreadExtentToDivideGridThreadExtent,
+                    gridBlockExtentSubDivRestrictions));
+            if(isValidWorkDiv(accDevProps, heuristicWorkDiv))
+            {
+                candidates.push_back(heuristicWorkDiv);
+            }
+
+            auto const gridElemExtentVec(extent::getExtentVec(gridElemExtent));
+            auto threadElemExtent(extent::getExtentVec(threadElemExtents));
+            auto gridThreadExtent(Vec<Dim, Size>::ones());
+            for(typename Dim::value_type i(0u); i<Dim::value; ++i)
+            {
+                threadElemExtent[i] = std::min(threadElemExtent[i], gridElemExtentVec[i]);
+                gridThreadExtent[i] = static_cast<Size>((gridElemExtentVec[i] + threadElemExtent[i] - 1u) / threadElemExtent[i]);
+            }
+
+            std::vector<std::vector<Size>> dimCandidates;
+            for(typename Dim::value_type i(0u); i<Dim::value; ++i)
+            {
+                dimCandidates.emplace_back(
+                    detail::getBlockThreadExtentCandidates(
+                        gridThreadExtent[i],
+                        std::min(accDevProps.m_blockThreadExtentMax[i], accDevProps.m_blockThreadCountMax),
+                        requireBlockThreadExtentToDivideGridThreadExtent));
+            }
+
+            // Enumerate the cartesian product of the per dimension candidates.
+            std::vector<WorkDiv> enumerated;
+            std::vector<std::size_t> choice(Dim::value, 0u);
+            for(;;)
+            {
+                auto blockThreadExtent(Vec<Dim, Size>::ones());
+                for(typename Dim::value_type i(0u); i<Dim::value; ++i)
+                {
+                    blockThreadExtent[i] = dimCandidates[i][choice[i]];
+                }
+
+                // Dimensions with a grid thread extent of one do not take part in the restrictions.
+                Size usedMin(std::numeric_limits<Size>::max());
+                Size usedMax(1u);
+                for(typename Dim::value_type i(0u); i<Dim::value; ++i)
+                {
+                    if(gridThreadExtent[i] > 1u)
+                    {
+                        usedMin = std::min(usedMin, blockThreadExtent[i]);
+                        usedMax = std::max(usedMax, blockThreadExtent[i]);
+                    }
+                }
+                bool const bRestrictionsMet(
+                    (usedMin > usedMax)
+                    || (gridBlockExtentSubDivRestrictions == GridBlockExtentSubDivRestrictions::Unrestricted)
+                    || ((gridBlockExtentSubDivRestrictions == GridBlockExtentSubDivRestrictions::EqualExtent) && (usedMin == usedMax))
+                    || ((gridBlockExtentSubDivRestrictions == GridBlockExtentSubDivRestrictions::CloseToEqualExtent) && (usedMax <= 2u * usedMin)));
+
+                if(bRestrictionsMet && (blockThreadExtent.prod() <= accDevProps.m_blockThreadCountMax))
+                {
+                    auto gridBlockExtent(Vec<Dim, Size>::ones());
+                    for(typename Dim::value_type i(0u); i<Dim::value; ++i)
+                    {
+                        gridBlockExtent[i] = static_cast<Size>((gridThreadExtent[i] + blockThreadExtent[i] - 1u) / blockThreadExtent[i]);
+                    }
+                    WorkDiv const workDiv(gridBlockExtent, blockThreadExtent, threadElemExtent);
+                    if(isValidWorkDiv(accDevProps, workDiv)
+                        && (candidates.empty() || (getWorkDiv<Block, Threads>(workDiv) != getWorkDiv<Block, Threads>(candidates.front()))))
+                    {
+                        enumerated.push_back(workDiv);
+                    }
+                }
+
+                // Advance to the next combination.
+                typename Dim::value_type i(0u);
+                for(; i<Dim::value; ++i)
+                {
+                    if(++choice[i] < dimCandidates[i].size())
+                    {
+                        break;
+                    }
+                    choice[i] = 0u;
+                }
+                if(i == Dim::value)
+                {
+                    break;
+                }
+            }
+
+            // Too many candidates are thinned out evenly over the block thread counts.
+            std::stable_sort(
+                enumerated.begin(),
+                enumerated.end(),
+                [](WorkDiv const & a, WorkDiv const & b)
+                {
+                    return getWorkDiv<Block, Threads>(a).prod() < getWorkDiv<Block, Threads>(b).prod();
+                });
+            auto const enumeratedCountMax(detail::autoTuneCandidateCountMax - candidates.size());
+            if(enumerated.size() <= enumeratedCountMax)
+            {
+                candidates.insert(candidates.end(), enumerated.begin(), enumerated.end());
+            }
+            else
+            {
+                for(std::size_t c(0u); c < enumeratedCountMax; ++c)
+                {
+                    candidates.push_back(enumerated[c * (enumerated.size() - 1u) / (enumeratedCountMax - 1u)]);
+                }
+            }
+
+            return candidates;
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Measures the execution time of the kernel with the given work division.
+        //!
+        //! \return The fastest of detail::autoTuneRepetitions executions after one warm up execution in seconds.
+        //-----------------------------------------------------------------------------
+        template<
+            typename TAcc,
+            typename TStream,
+            typename TWorkDiv,
+            typename TKernelFnObj,
+            typename... TArgs>
+        ALPAKA_FN_HOST auto measureWorkDiv(
+            TStream & stream,
+            TWorkDiv const & workDiv,
+            TKernelFnObj const & kernelFnObj,
+            TArgs const & ... args)
+        -> double
+        {
+            auto const exec(
+                exec::create<TAcc>(
+                    workDiv,
+                    kernelFnObj,
+                    args...));
+
+            stream::enqueue(stream, exec);
+            wait::wait(stream);
+
+            double seconds(std::numeric_limits<double>::max());
+            for(std::size_t r(0u); r < detail::autoTuneRepetitions; ++r)
+            {
+                auto const start(std::chrono::steady_clock::now());
+                stream::enqueue(stream, exec);
+                wait::wait(stream);
+                seconds = std::min(
+                    seconds,
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            }
+            return seconds;
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Returns the fastest work division for the given kernel.
+        //!
+        //! On the first call for a kernel, accelerator and extent the candidates from getWorkDivCandidates
+        //! are executed in the given stream and the fastest one is cached.
+        //! Following calls, also in later runs if a cache file is set, return the cached work division
+        //! as long as it is valid for the device of the stream.
+        //! The kernel is executed multiple times with the given arguments while tuning,
+        //! so it has to tolerate repeated execution on them.
+        //!
+        //! \tparam TAcc The accelerator for which the work division has to be valid.
+        //! \param stream The stream the kernel is measured in.
+        //! \param gridElemExtent The full extent of elements in the grid.
+        //! \param threadElemExtents The number of elements computed per thread.
+        //! \param requireBlockThreadExtentToDivideGridThreadExtent
+        //!     If this is true, the grid thread extent will be multiples of the corresponding block thread extent.
+        //! \param gridBlockExtentSubDivRestrictions The grid block extent subdivision restrictions.
+        //! \param kernelFnObj The kernel function object.
+        //! \param args The kernel arguments.
+        //! \return The work division.
+        //-----------------------------------------------------------------------------
+        template<
+            typename TAcc,
+            typename TStream,
+            typename TGridElemExtent,
+            typename TThreadElemExtent,
+            typename TKernelFnObj,
+            typename... TArgs>
+        ALPAKA_FN_HOST auto getAutoTunedWorkDiv(
+            TStream & stream,
+            TGridElemExtent const & gridElemExtent,
+            TThreadElemExtent const & threadElemExtents,
+            bool requireBlockThreadExtentToDivideGridThreadExtent,
+            GridBlockExtentSubDivRestrictions gridBlockExtentSubDivRestrictions,
+            TKernelFnObj const & kernelFnObj,
+            TArgs const & ... args)
+        -> workdiv::WorkDivMembers<dim::Dim<TGridElemExtent>, size::Size<TGridElemExtent>>
+        {
+            using Dim = dim::Dim<TGridElemExtent>;
+            using Size = size::Size<TGridElemExtent>;
+            using WorkDiv = workdiv::WorkDivMembers<Dim, Size>;
+
+            auto const dev(dev::getDev(stream));
+
+            auto const key(
+                detail::getAutoTuneKey<TAcc, TKernelFnObj>(
+                    extent::getExtentVec(gridElemExtent),
+                    extent::getExtentVec(threadElemExtents),
+                    requireBlockThreadExtentToDivideGridThreadExtent,
+                    gridBlockExtentSubDivRestrictions));
+
+            auto & cache(detail::getAutoTuneCache());
+
+            detail::AutoTuneEntry entry;
+            if(cache.find(key, entry))
+            {
+                auto gridBlockExtent(Vec<Dim, Size>::ones());
+                auto blockThreadExtent(Vec<Dim, Size>::ones());
+                auto threadElemExtent(Vec<Dim, Size>::ones());
+                if(detail::parseExtent(entry.m_gridBlockExtent, gridBlockExtent)
+                    && detail::parseExtent(entry.m_blockThreadExtent, blockThreadExtent)
+                    && detail::parseExtent(entry.m_threadElemExtent, threadElemExtent))
+                {
+                    WorkDiv const workDiv(gridBlockExtent, blockThreadExtent, threadElemExtent);
+                    // The cache file may have been written for a different device.
+                    if(isValidWorkDiv<TAcc>(dev, workDiv))
+                    {
+                        return WorkDiv(workDiv);
+                    }
+                }
+            }
+
+            auto const candidates(
+                getWorkDivCandidates<TAcc>(
+                    dev,
+                    gridElemExtent,
+                    threadElemExtents,
+                    requireBlockThreadExtentToDivideGridThreadExtent,
+                    gridBlockExtentSubDivRestrictions));
+            if(candidates.empty())
+            {
+                throw std::runtime_error("There is no valid work division to tune for the given extent!");
+            }
+
+            std::size_t bestIdx(0u);
+            double bestSeconds(std::numeric_limits<double>::max());
+            for(std::size_t c(0u); c < candidates.size(); ++c)
+            {
+                auto const seconds(
+                    measureWorkDiv<TAcc>(
+                        stream,
+                        candidates[c],
+                        kernelFnObj,
+                        args...));
+#if ALPAKA_DEBUG >= ALPAKA_DEBUG_FULL
+                std::cout << BOOST_CURRENT_FUNCTION
+                    << " gridBlockExtent: " << getWorkDiv<Grid, Blocks>(candidates[c])
+                    << ", blockThreadExtent: " << getWorkDiv<Block, Threads>(candidates[c])
+                    << ", seconds: " << seconds
+                    << std::endl;
+#endif
+                if(seconds < bestSeconds)
+                {
+                    bestSeconds = seconds;
+                    bestIdx = c;
+                }
+            }
+
+            auto const & best(candidates[bestIdx]);
+            entry.m_gridBlockExtent = detail::formatExtent(getWorkDiv<Grid, Blocks>(best));
+            entry.m_blockThreadExtent = detail::formatExtent(getWorkDiv<Block, Threads>(best));
+            entry.m_threadElemExtent = detail::formatExtent(getWorkDiv<Thread, Elems>(best));
+            entry.m_seconds = bestSeconds;
+            cache.insert(key, entry);
+
+            return WorkDiv(best);
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Sets the path of the file the tuned work divisions are persisted in.
+        //! An empty path keeps them in memory only.
+        //! The default is the value of the ALPAKA_WORKDIV_CACHE_FILE environment variable.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto setAutoTuneCacheFile(
+            std::string const & filePath)
+        -> void
+        {
+            detail::getAutoTuneCache().setFilePath(filePath);
+        }
+        //-----------------------------------------------------------------------------
+        //! \return The path of the file the tuned work divisions are persisted in.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto getAutoTuneCacheFile()
+        -> std::string
+        {
+            return detail::getAutoTuneCache().getFilePath();
+        }
+        //-----------------------------------------------------------------------------
+        //! Removes all tuned work divisions from memory so that they are measured again.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto clearAutoTuneCache()
+        -> void
+        {
+            detail::getAutoTuneCache().clear();
+        }
+    }
+}
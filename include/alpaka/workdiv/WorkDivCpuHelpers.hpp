@@ -0,0 +1,271 @@
+/**
+* \file
+* Copyright 2014-2015 Benjamin Worpitz
+*
+* This file is part of alpaka.
+*
+* alpaka is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* alpaka is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public License
+* along with alpaka.
+* If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <alpaka/workdiv/WorkDivMembers.hpp>    // workdiv::WorkDivMembers
+#include <alpaka/workdiv/WorkDivHelpers.hpp>    // workdiv::isValidAccDevProps
+
+#include <alpaka/dev/cpu/SysInfo.hpp>           // dev::cpu::detail::getCacheSizeBytes, dev::cpu::detail::getCpuTopology
+#include <alpaka/acc/Traits.hpp>                // acc::getAccDevProps
+
+#include <alpaka/vec/Vec.hpp>                   // Vec
+#include <alpaka/core/Common.hpp>               // ALPAKA_FN_HOST
+
+#include <algorithm>                            // std::min, std::max
+#include <cassert>                              // assert
+
+namespace alpaka
+{
+    namespace workdiv
+    {
+        //#############################################################################
+        //! The CPU properties the cache aware work division is computed for.
+        //#############################################################################
+        struct CpuCacheInfo
+        {
+            std::size_t m_l1CacheSizeBytes;     //!< The size of the first level data cache of one core.
+            std::size_t m_l2CacheSizeBytes;     //!< The size of the second level cache of one core.
+            std::size_t m_cacheLineSizeBytes;   //!< The size of a cache line.
+            std::size_t m_coreCount;            //!< The number of cores executing blocks or threads concurrently.
+        };
+
+        //-----------------------------------------------------------------------------
+        //! \return The cache properties of the CPU the code is running on.
+        //! All logical CPUs are counted as cores because each of them executes a thread.
+        //! Values that can not be determined are replaced by typical ones.
+        //-----------------------------------------------------------------------------
+        ALPAKA_FN_HOST auto getCpuCacheInfo()
+        -> CpuCacheInfo
+        {
+            auto const l1CacheSizeBytes(dev::cpu::detail::getCacheSizeBytes(1u));
+            auto const l2CacheSizeBytes(dev::cpu::detail::getCacheSizeBytes(2u));
+            auto const cacheLineSizeBytes(dev::cpu::detail::getCacheLineSizeBytes());
+            return {
+                l1CacheSizeBytes ? l1CacheSizeBytes : static_cast<std::size_t>(32u << 10u),
+                l2CacheSizeBytes ? l2CacheSizeBytes : static_cast<std::size_t>(256u << 10u),
+                cacheLineSizeBytes ? cacheLineSizeBytes : static_cast<std::size_t>(64u),
+                dev::cpu::detail::getCpuTopology().m_logicalCpus.size()};
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Subdivides the given grid element extent for a CPU accelerator so that the data touched by a block fits into the caches.
+        //!
+        //! The threads of a block are distributed over at most m_coreCount cores.
+        //! If a block has a single thread, its working set is restricted to half of the L2 cache.
+        //! Otherwise the working set of each thread is restricted to half of the L1 cache.
+        //! The block count is rounded up to a multiple of the core count if the grid is large enough.
+        //! Elements of the innermost dimension are kept together in whole cache lines,
+        //! block threads are distributed over the outer dimensions first.
+        //! The block thread extent is not required to divide the grid thread extent,
+        //! so the kernel has to check its indices against the grid element extent.
+        //!
+        //! \param gridElemExtent
+        //!     The full extent of elements in the grid.
+        //! \param accDevProps
+        //!     The maxima for the work division.
+        //! \param elemSizeBytes
+        //!     The size of one element in the innermost dimension used to align the thread element extent to cache lines.
+        //! \param bytesPerElem
+        //!     The number of bytes touched by the kernel for each element, summed over all buffers.
+        //! \param cacheInfo
+        //!     The cache sizes and core count.
+        //-----------------------------------------------------------------------------
+        template<
+            typename TDim,
+            typename TSize>
+        ALPAKA_FN_HOST auto subDivideGridElemsCacheAware(
+            Vec<TDim, TSize> const & gridElemExtent,
+            acc::AccDevProps<TDim, TSize> const & accDevProps,
+            std::size_t const & elemSizeBytes,
+            std::size_t const & bytesPerElem,
+            CpuCacheInfo const & cacheInfo = getCpuCacheInfo())
+        -> workdiv::WorkDivMembers<TDim, TSize>
+        {
+            for(typename TDim::value_type i(0); i<TDim::value; ++i)
+            {
+                assert(gridElemExtent[i] >= 1);
+            }
+            assert(isValidAccDevProps(accDevProps));
+            assert(elemSizeBytes > 0u);
+            assert(bytesPerElem > 0u);
+            assert(cacheInfo.m_coreCount > 0u);
+
+            auto const elemCount(static_cast<std::size_t>(gridElemExtent.prod()));
+            auto const coreCount(cacheInfo.m_coreCount);
+
+            ///////////////////////////////////////////////////////////////////
+            // Compute the thread count of a block and the element count of a thread.
+            auto const blockThreadCount(
+                std::min(
+                    static_cast<std::size_t>(accDevProps.m_blockThreadCountMax),
+                    std::min(coreCount, elemCount)));
+            auto const cacheBudgetBytes(
+                (blockThreadCount == 1u)
+                ? cacheInfo.m_l2CacheSizeBytes / 2u
+                : cacheInfo.m_l1CacheSizeBytes / 2u);
+            auto threadElemCount(
+                std::min(
+                    std::max(cacheBudgetBytes / bytesPerElem, static_cast<std::size_t>(1u)),
+                    static_cast<std::size_t>(accDevProps.m_threadElemCountMax)));
+
+            // Use at least one block per core and round the block count up to a multiple of the core count.
+            // The elements are then spread evenly over the blocks.
+            auto const blockElemCount(blockThreadCount * threadElemCount);
+            auto blockCount((elemCount + blockElemCount - 1u) / blockElemCount);
+            if(elemCount >= coreCount * blockThreadCount)
+            {
+                blockCount = ((std::max(blockCount, coreCount) + coreCount - 1u) / coreCount) * coreCount;
+            }
+            auto const threadCount(blockCount * blockThreadCount);
+            threadElemCount = (elemCount + threadCount - 1u) / threadCount;
+
+            ///////////////////////////////////////////////////////////////////
+            // Distribute the thread elements over the dimensions beginning with the innermost one.
+            auto threadElemExtent(Vec<TDim, TSize>::ones());
+            {
+                auto const lineElemCount(std::max(cacheInfo.m_cacheLineSizeBytes / elemSizeBytes, static_cast<std::size_t>(1u)));
+                auto remaining(threadElemCount);
+                for(typename TDim::value_type i(TDim::value); i-- > 0u;)
+                {
+                    auto const extent(static_cast<std::size_t>(gridElemExtent[i]));
+                    auto const extentMax(static_cast<std::size_t>(accDevProps.m_threadElemExtentMax[i]));
+                    std::size_t threadElems(std::min(remaining, extent));
+                    // Partial rows are rounded to whole cache lines.
+                    if((i == TDim::value - 1u) && (threadElems < extent) && (threadElems > lineElemCount))
+                    {
+                        threadElems = (threadElems / lineElemCount) * lineElemCount;
+                    }
+                    threadElems = std::max(std::min(threadElems, extentMax), static_cast<std::size_t>(1u));
+                    threadElemExtent[i] = static_cast<TSize>(threadElems);
+                    remaining = (remaining + threadElems - 1u) / threadElems;
+                }
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Distribute the block threads over the dimensions beginning with the outermost one.
+            auto gridThreadExtent(Vec<TDim, TSize>::ones());
+            for(typename TDim::value_type i(0u); i<TDim::value; ++i)
+            {
+                gridThreadExtent[i] = static_cast<TSize>((gridElemExtent[i] + threadElemExtent[i] - 1u) / threadElemExtent[i]);
+            }
+            auto blockThreadExtent(Vec<TDim, TSize>::ones());
+            {
+                auto remaining(blockThreadCount);
+                for(typename TDim::value_type i(0u); i<TDim::value; ++i)
+                {
+                    auto const blockThreads(
+                        std::min(
+                            remaining,
+                            std::min(
+                                static_cast<std::size_t>(gridThreadExtent[i]),
+                                static_cast<std::size_t>(accDevProps.m_blockThreadExtentMax[i]))));
+                    blockThreadExtent[i] = static_cast<TSize>(std::max(blockThreads, static_cast<std::size_t>(1u)));
+                    remaining /= static_cast<std::size_t>(blockThreadExtent[i]);
+                }
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Compute the grid block extent.
+            auto gridBlockExtent(Vec<TDim, TSize>::ones());
+            for(typename TDim::value_type i(0u); i<TDim::value; ++i)
+            {
+                gridBlockExtent[i] = static_cast<TSize>((gridThreadExtent[i] + blockThreadExtent[i] - 1u) / blockThreadExtent[i]);
+            }
+
+            // Rounding the extents per dimension may have changed the block count.
+            // Round it up to a multiple of the core count in the outermost dimension that has enough elements for the additional blocks.
+            auto const gridBlockCount(static_cast<std::size_t>(gridBlockExtent.prod()));
+            if((gridBlockCount >= coreCount) && (gridBlockCount % coreCount != 0u))
+            {
+                for(typename TDim::value_type i(0u); i<TDim::value; ++i)
+                {
+                    auto const otherBlockCount(gridBlockCount / static_cast<std::size_t>(gridBlockExtent[i]));
+                    // The smallest multiple of coreCount that is a multiple of otherBlockCount.
+                    auto lcm(otherBlockCount);
+                    while(lcm % coreCount != 0u)
+                    {
+                        lcm += otherBlockCount;
+                    }
+                    auto const step(lcm / otherBlockCount);
+                    auto const blockExtent(((static_cast<std::size_t>(gridBlockExtent[i]) + step - 1u) / step) * step);
+                    auto const gridThreads(blockExtent * static_cast<std::size_t>(blockThreadExtent[i]));
+                    if(gridThreads <= static_cast<std::size_t>(gridElemExtent[i]))
+                    {
+                        gridBlockExtent[i] = static_cast<TSize>(blockExtent);
+                        // Shrink the thread element extent to the new block extent.
+                        threadElemExtent[i] = static_cast<TSize>((static_cast<std::size_t>(gridElemExtent[i]) + gridThreads - 1u) / gridThreads);
+                        break;
+                    }
+                }
+            }
+
+            return
+                workdiv::WorkDivMembers<TDim, TSize>(
+                    gridBlockExtent,
+                    blockThreadExtent,
+                    threadElemExtent);
+        }
+
+        //-----------------------------------------------------------------------------
+        //! \tparam TAcc The CPU accelerator for which this work division has to be valid.
+        //! \tparam TGridElemExtent The type of the grid element extent.
+        //! \tparam TDev The type of the device.
+        //! \param dev
+        //!     The device the work division should be valid for.
+        //! \param gridElemExtent
+        //!     The full extent of elements in the grid.
+        //! \param elemSizeBytes
+        //!     The size of one element in the innermost dimension.
+        //! \param bytesPerElem
+        //!     The number of bytes touched by the kernel for each element, summed over all buffers.
+        //! \param cacheInfo
+        //!     The cache sizes and core count.
+        //! \return The work division. See subDivideGridElemsCacheAware.
+        //-----------------------------------------------------------------------------
+        template<
+            typename TAcc,
+            typename TGridElemExtent,
+            typename TDev>
+        ALPAKA_FN_HOST auto getValidWorkDivCacheAware(
+            TDev const & dev,
+            TGridElemExtent const & gridElemExtent,
+            std::size_t const & elemSizeBytes,
+            std::size_t const & bytesPerElem,
+            CpuCacheInfo const & cacheInfo = getCpuCacheInfo())
+        -> workdiv::WorkDivMembers<dim::Dim<TGridElemExtent>, size::Size<TGridElemExtent>>
+        {
+            static_assert(
+                dim::Dim<TGridElemExtent>::value == dim::Dim<TAcc>::value,
+                "The dimension of TAcc and the dimension of TGridElemExtent have to be identical!");
+            static_assert(
+                std::is_same<size::Size<TGridElemExtent>, size::Size<TAcc>>::value,
+                "The size type of TAcc and the size type of TGridElemExtent have to be identical!");
+
+            return subDivideGridElemsCacheAware(
+                extent::getExtentVec(gridElemExtent),
+                acc::getAccDevProps<TAcc>(dev),
+                elemSizeBytes,
+                bytesPerElem,
+                cacheInfo);
+        }
+    }
+}
@@ -74,7 +74,7 @@ namespace alpaka
 
                 core::assertValueUnsigned(dividend);
                 core::assertValueUnsigned(maxDivisor);
-                assert(dividend <= maxDivisor);
+                assert(maxDivisor <= dividend);
 
                 while((dividend%divisor) != 0)
                 {